@@ -0,0 +1,223 @@
+// Throughput benchmark and fuzz driver for ScalaParser.
+//
+// Build (from the repository root, no openFrameworks needed):
+//   c++ -std=c++17 -O2 -Isrc bench/scala_parser_bench.cpp src/ScalaParser.cpp -o bench/scala_parser_bench
+//
+// Run over the seed corpus, or point it at the Scala archive (https://www.huygens-fokker.org/docs/scales.zip):
+//   bench/scala_parser_bench [directory ...] [--iterations N] [--fuzz N]
+//
+// Reports files/second for ScalaParser against the previous stringstream/stof parser,
+// then feeds mutated copies of every file through the parser and checks its invariants.
+// Exits non-zero if an invariant fails.
+
+#include "ScalaParser.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct CorpusFile {
+    string name;
+    string content;
+};
+
+static void loadDirectory(const string& directory, vector<CorpusFile>& files) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        fprintf(stderr, "Cannot open %s\n", directory.c_str());
+        return;
+    }
+    while (dirent* item = readdir(dir)) {
+        string name = item->d_name;
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".scl") != 0) continue;
+
+        ifstream file(directory + "/" + name, ios::binary);
+        files.push_back({name, string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>())});
+    }
+    closedir(dir);
+}
+
+// The parser ScaleManager used before ScalaParser, kept as the baseline
+static size_t legacyParse(const string& content) {
+    struct Interval { float cents; float ratio; string description; };
+    vector<Interval> intervals;
+    stringstream ss(content);
+    string line;
+    bool foundDescription = false;
+    bool foundCount = false;
+    int expectedIntervals = 0;
+    int currentInterval = 0;
+
+    while (getline(ss, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t") + 1);
+        if (line.empty() || line[0] == '!') continue;
+        if (!foundDescription) { foundDescription = true; continue; }
+        if (!foundCount) {
+            try { expectedIntervals = stoi(line); foundCount = true; continue; } catch (...) { return 0; }
+        }
+        if (currentInterval < expectedIntervals) {
+            Interval interval;
+            interval.description = "Interval " + to_string(currentInterval + 1);
+            size_t slashPos = line.find('/');
+            try {
+                if (slashPos != string::npos) {
+                    interval.ratio = stof(line.substr(0, slashPos)) / stof(line.substr(slashPos + 1));
+                    interval.cents = 1200.0f * log2(interval.ratio);
+                } else {
+                    interval.cents = stof(line);
+                    interval.ratio = pow(2.0f, interval.cents / 1200.0f);
+                }
+            } catch (...) {
+                continue;
+            }
+            intervals.push_back(interval);
+            currentInterval++;
+        }
+    }
+    return intervals.size();
+}
+
+template<typename Parse>
+static double measureFilesPerSecond(const vector<CorpusFile>& files, int iterations, Parse parse, size_t& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (const CorpusFile& file : files) {
+            checksum += parse(file.content);
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return files.size() * (double)iterations / seconds;
+}
+
+static string mutate(const string& input, mt19937& random) {
+    static const char* fragments[] = {"/", ".", "!", "\n", "\r\n", " ", "-", "+", "0", "18446744073709551616",
+                                      "99999999999999999999999", "1e308", "nan", "inf", "/0", "\t\t", "\xff"};
+    string output = input;
+    int edits = 1 + random() % 8;
+    for (int e = 0; e < edits; e++) {
+        size_t position = output.empty() ? 0 : random() % (output.size() + 1);
+        switch (random() % 5) {
+            case 0:
+                if (!output.empty() && position < output.size()) output[position] = (char)(random() % 256);
+                break;
+            case 1:
+                output.insert(position, fragments[random() % (sizeof(fragments) / sizeof(fragments[0]))]);
+                break;
+            case 2:
+                output.erase(position, random() % 16);
+                break;
+            case 3:
+                output.resize(position);
+                break;
+            default: {
+                // Duplicate a span, which repeats lines and pitch counts
+                size_t length = random() % 64;
+                if (position < output.size()) output.insert(position, output.substr(position, length));
+                break;
+            }
+        }
+    }
+    return output;
+}
+
+static bool checkInvariants(const string& content, const ScalaParser::Result& result, bool valid) {
+    if (valid) {
+        if (result.intervals.empty() || result.declaredCount < 0) return false;
+        if ((int)result.intervals.size() > result.declaredCount) return false;
+    } else if (result.firstError.line <= 0 || result.firstError.message == nullptr) {
+        return false;
+    }
+    for (const ScalaParser::Interval& interval : result.intervals) {
+        if (!std::isfinite(interval.cents)) return false;
+        if (interval.isRatio() && interval.numerator == 0) return false;
+    }
+    // Description must point into the input buffer
+    if (!result.description.empty() &&
+        (result.description.data() < content.data() ||
+         result.description.data() + result.description.size() > content.data() + content.size())) {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    vector<string> directories;
+    int iterations = 20;
+    int fuzzRounds = 2000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) iterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fuzz") == 0 && i + 1 < argc) fuzzRounds = atoi(argv[++i]);
+        else directories.push_back(argv[i]);
+    }
+    if (directories.empty()) directories.push_back("bench/corpus");
+
+    vector<CorpusFile> files;
+    for (const string& directory : directories) {
+        loadDirectory(directory, files);
+    }
+    if (files.empty()) {
+        fprintf(stderr, "No .scl files found\n");
+        return 1;
+    }
+
+    size_t bytes = 0;
+    for (const CorpusFile& file : files) bytes += file.content.size();
+    printf("Corpus: %zu files, %.1f KB\n", files.size(), bytes / 1024.0);
+
+    // Throughput
+    size_t checksum = 0;
+    ScalaParser::Result result;
+    double legacyRate = measureFilesPerSecond(files, iterations, legacyParse, checksum);
+    double parserRate = measureFilesPerSecond(files, iterations, [&](const string& content) {
+        ScalaParser::parse(content, result);
+        return result.intervals.size();
+    }, checksum);
+    printf("Legacy parser:  %12.0f files/s\n", legacyRate);
+    printf("ScalaParser:    %12.0f files/s  (%.1fx, %.0f MB/s)\n", parserRate, parserRate / legacyRate,
+           parserRate * bytes / files.size() / (1024.0 * 1024.0));
+
+    // Report files the parser rejects or flags
+    int rejected = 0;
+    for (const CorpusFile& file : files) {
+        bool valid = ScalaParser::parse(file.content, result);
+        if (result.firstError.line > 0) {
+            if (!valid) rejected++;
+            printf("  %s:%d:%d: %s%s\n", file.name.c_str(), result.firstError.line, result.firstError.column,
+                   result.firstError.message, valid ? "" : " (rejected)");
+        }
+    }
+    printf("Rejected: %d of %zu\n", rejected, files.size());
+
+    // Fuzz
+    mt19937 random(12345);
+    int failures = 0;
+    size_t fuzzCases = 0;
+    auto fuzzStart = chrono::steady_clock::now();
+    for (int round = 0; round < fuzzRounds; round++) {
+        for (const CorpusFile& file : files) {
+            string input = mutate(file.content, random);
+            bool valid = ScalaParser::parse(input, result);
+            fuzzCases++;
+            if (!checkInvariants(input, result, valid)) {
+                if (failures++ < 10) {
+                    printf("  invariant failed for mutation of %s (round %d)\n", file.name.c_str(), round);
+                }
+            }
+        }
+    }
+    double fuzzSeconds = chrono::duration<double>(chrono::steady_clock::now() - fuzzStart).count();
+    printf("Fuzz: %zu cases, %d failures, %.0f files/s\n", fuzzCases, failures, fuzzCases / fuzzSeconds);
+
+    return (failures > 0 || checksum == 0) ? 1 : 0;
+}
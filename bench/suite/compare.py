@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON results and fail on regressions.
+
+Usage:
+  bench/suite/compare.py BASELINE.json CURRENT.json [--threshold 0.10] [--metric cpu_time]
+
+Benchmarks are matched by name. With --benchmark_repetitions the median aggregate is
+compared, otherwise the single run. Exits 1 when any benchmark is slower than the
+baseline by more than the threshold (a fraction: 0.10 = 10%), 0 otherwise. Benchmarks
+present in only one file are listed but never fail the comparison.
+"""
+
+import argparse
+import json
+import sys
+
+NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric):
+    """Returns {name: time in ns}, preferring median aggregates over single runs."""
+    try:
+        with open(path) as f:
+            document = json.load(f)
+    except (OSError, ValueError) as error:
+        sys.exit("Could not read %s: %s" % (path, error))
+
+    singles = {}
+    medians = {}
+    for entry in document.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        time = entry[metric] * NANOSECONDS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = time
+        else:
+            singles.setdefault(entry.get("run_name", entry["name"]), time)
+    singles.update(medians)
+    return singles
+
+
+def format_time(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "%.2f %s" % (ns / scale, unit)
+    return "%.1f ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline, args.metric)
+    current = load_times(args.current, args.metric)
+
+    # Run order, benchmarks gone from the current run last
+    names = list(current) + [name for name in baseline if name not in current]
+    regressions = []
+    width = max([len(name) for name in names] + [9])
+    print("%-*s %12s %12s %9s" % (width, "Benchmark", "Baseline", "Current", "Change"))
+    for name in names:
+        if name not in current:
+            print("%-*s %12s %12s %9s" % (width, name, format_time(baseline[name]), "-", "removed"))
+            continue
+        if name not in baseline:
+            print("%-*s %12s %12s %9s" % (width, name, "-", format_time(current[name]), "new"))
+            continue
+        change = current[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        regressed = change > args.threshold
+        if regressed:
+            regressions.append(name)
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name, format_time(baseline[name]),
+                                           format_time(current[name]), change * 100.0,
+                                           "  REGRESSION" if regressed else ""))
+
+    if regressions:
+        print("\n%d benchmark(s) more than %.0f%% slower than the baseline (%s)"
+              % (len(regressions), args.threshold * 100.0, args.metric))
+        return 1
+    print("\nNo regressions beyond %.0f%% (%s)" % (args.threshold * 100.0, args.metric))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,38 @@
+#include "bench_support.h"
+
+namespace {
+
+string benchConfigSource;
+
+}
+
+const string& getBenchConfigSource() {
+    return benchConfigSource;
+}
+
+void setBenchConfigSource(const string& path) {
+    benchConfigSource = path;
+}
+
+string makeBenchScalaContent(int steps) {
+    string content = "! bench_" + ofToString(steps) + ".scl\n!\n";
+    content += ofToString(steps) + " pitches, mixed cents and ratios\n";
+    content += " " + ofToString(steps) + "\n!\n";
+    for (int step = 1; step < steps; step++) {
+        if (step % 3 == 0) {
+            content += " " + ofToString(steps + step) + "/" + ofToString(steps) + "\n";
+        } else {
+            content += " " + ofToString(1200.0 * step / steps, 5) + "\n";
+        }
+    }
+    content += " 2/1\n";
+    return content;
+}
+
+string writeBenchScalaFile(int steps) {
+    string path = ofToDataPath("bench_" + ofToString(steps) + ".scl");
+    ofBuffer buffer;
+    buffer.set(makeBenchScalaContent(steps));
+    ofBufferToFile(path, buffer);
+    return path;
+}
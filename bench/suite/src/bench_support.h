@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Shared by the benchmark files. main() points ofToDataPath at a scratch directory
+// before any benchmark runs, so files written here never touch bin/data.
+
+// config.json the config benchmarks load (--config), empty when none was given
+const string& getBenchConfigSource();
+void setBenchConfigSource(const string& path);
+
+// Scala file text with the given number of pitches: cents, every third pitch a ratio,
+// closing on 2/1 like most of the Scala archive
+string makeBenchScalaContent(int steps);
+
+// Writes makeBenchScalaContent(steps) to bench_<steps>.scl in the data directory and
+// returns its path. ScaleManager names the scale after the file: "bench_<steps>".
+string writeBenchScalaFile(int steps);
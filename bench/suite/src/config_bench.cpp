@@ -0,0 +1,66 @@
+// Startup config load: ConfigManager::setup() + loadConfig(), from config.json text
+// (snapshot:0) or from the binary snapshot a previous run left next to it (snapshot:1).
+// Video and communication managers are not connected - their loads open devices and ports.
+
+#include "bench_support.h"
+#include "ConfigManager.h"
+#include "DetectionManager.h"
+#include "LineManager.h"
+#include "ScaleManager.h"
+#include "TempoManager.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void BM_ConfigLoad(benchmark::State& state) {
+    if (getBenchConfigSource().empty()) {
+        state.SkipWithError("no --config given");
+        return;
+    }
+    bool fromSnapshot = state.range(0) != 0;
+    string snapshotPath = ofToDataPath("config.snapshot");
+    ofFile::copyFromTo(getBenchConfigSource(), ofToDataPath("config.json"), false, true);
+    ofFile::removeFile(snapshotPath, false);
+
+    LineManager lineManager;
+    DetectionManager detectionManager;
+    TempoManager tempoManager;
+    ScaleManager scaleManager;
+    auto makeConfigManager = [&]() {
+        unique_ptr<ConfigManager> configManager(new ConfigManager());
+        configManager->setManagers(nullptr, &lineManager, nullptr, &detectionManager,
+                                   nullptr, &tempoManager, &scaleManager);
+        return configManager;
+    };
+
+    // A text load writes the snapshot on its way out; later loads restore from it
+    if (fromSnapshot) {
+        unique_ptr<ConfigManager> configManager = makeConfigManager();
+        configManager->setup();
+        configManager->loadConfig();
+    }
+
+    bool restoredAsExpected = true;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (!fromSnapshot) {
+            ofFile::removeFile(snapshotPath, false);
+        }
+        unique_ptr<ConfigManager> configManager = makeConfigManager();
+        state.ResumeTiming();
+
+        configManager->setup();
+        configManager->loadConfig();
+
+        state.PauseTiming();
+        restoredAsExpected = restoredAsExpected && configManager->wasRestoredFromSnapshot() == fromSnapshot;
+        configManager.reset();      // Joins the writer and watcher threads, untimed
+        state.ResumeTiming();
+    }
+    if (!restoredAsExpected) {
+        state.SkipWithError(fromSnapshot ? "snapshot was not used" : "snapshot was used");
+    }
+}
+BENCHMARK(BM_ConfigLoad)->ArgNames({"snapshot"})->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,154 @@
+// Detection post-processing: NMS, IoU, tracking and line crossing checks.
+// Inputs are generated up front so only the DetectionManager call is timed.
+
+#include "bench_support.h"
+#include "DetectionManager.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+
+typedef DetectionManager::Detection Detection;
+
+const float FRAME_WIDTH = 1920.0f;
+const float FRAME_HEIGHT = 1080.0f;
+const float TRAFFIC_SPEED = 4.0f;      // Pixels per frame, above the tracker's movement threshold
+const int VEHICLE_CLASSES[] = {2, 3, 5, 7};
+const char* VEHICLE_NAMES[] = {"car", "motorcycle", "bus", "truck"};
+
+// What the detector hands to NMS: every object reported several times with slightly
+// shifted boxes and varying confidence, in no particular order
+vector<Detection> makeRawDetections(int objects, int candidatesPerObject, std::mt19937& rng) {
+    std::uniform_real_distribution<float> x(0.0f, FRAME_WIDTH - 200.0f);
+    std::uniform_real_distribution<float> y(0.0f, FRAME_HEIGHT - 150.0f);
+    std::uniform_real_distribution<float> size(40.0f, 200.0f);
+    std::uniform_real_distribution<float> jitter(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> confidence(0.3f, 0.95f);
+
+    vector<Detection> raw;
+    raw.reserve(objects * candidatesPerObject);
+    for (int i = 0; i < objects; i++) {
+        float width = size(rng);
+        ofRectangle box(x(rng), y(rng), width, width * 0.75f);
+        for (int candidate = 0; candidate < candidatesPerObject; candidate++) {
+            Detection detection;
+            detection.box = ofRectangle(box.x + jitter(rng), box.y + jitter(rng),
+                                        box.width + jitter(rng), box.height + jitter(rng));
+            detection.confidence = confidence(rng);
+            detection.classId = VEHICLE_CLASSES[i % 4];
+            detection.className = VEHICLE_NAMES[i % 4];
+            detection.captureMicros = 0;
+            raw.push_back(detection);
+        }
+    }
+    std::shuffle(raw.begin(), raw.end(), rng);
+    return raw;
+}
+
+// Objects spread over a grid of lanes, all moving right. One frame per step until the
+// traffic has moved a full frame width, so replaying the frames in a loop is seamless;
+// objects leaving on the right come back on the left as new tracks.
+vector<vector<Detection>> makeTrafficFrames(int objects) {
+    int columns = (int)ceil(sqrt(objects * FRAME_WIDTH / FRAME_HEIGHT));
+    int rows = (objects + columns - 1) / columns;
+    float spacingX = FRAME_WIDTH / columns;
+    float spacingY = FRAME_HEIGHT / rows;
+    int frameCount = (int)(FRAME_WIDTH / TRAFFIC_SPEED);
+
+    vector<vector<Detection>> frames(frameCount);
+    for (int frame = 0; frame < frameCount; frame++) {
+        frames[frame].reserve(objects);
+        for (int i = 0; i < objects; i++) {
+            Detection detection;
+            float x = fmod((i % columns) * spacingX + frame * TRAFFIC_SPEED, FRAME_WIDTH);
+            detection.box = ofRectangle(x, (i / columns) * spacingY, spacingX * 0.6f, spacingY * 0.6f);
+            detection.confidence = 0.8f;
+            detection.classId = VEHICLE_CLASSES[i % 4];
+            detection.className = VEHICLE_NAMES[i % 4];
+            detection.captureMicros = frame;
+            frames[frame].push_back(detection);
+        }
+    }
+    return frames;
+}
+
+// Tracking runs on detections alone in replay mode - no model, nothing sent
+void setUpTracking(DetectionManager& manager) {
+    manager.replaying = true;
+    manager.selectedClassIds.assign(std::begin(VEHICLE_CLASSES), std::end(VEHICLE_CLASSES));
+}
+
+void BM_CalculateIoU(benchmark::State& state) {
+    DetectionManager manager;
+    std::mt19937 rng(1);
+    vector<Detection> boxes = makeRawDetections(256, 4, rng);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.calculateIoU(boxes[i].box, boxes[(i + 1) & 1023].box));
+        i = (i + 1) & 1023;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateIoU);
+
+// containment:1 adds the containment test the tiled path uses
+void BM_ApplyNMS(benchmark::State& state) {
+    int objects = state.range(0);
+    float containmentThreshold = state.range(1) ? 0.8f : 1.0f;
+    DetectionManager manager;
+    std::mt19937 rng(objects);
+    vector<Detection> raw = makeRawDetections(objects, 4, rng);
+    vector<Detection> filtered;
+    for (auto _ : state) {
+        manager.applyNMS(raw, filtered, 0.5f, containmentThreshold);
+        benchmark::DoNotOptimize(filtered.data());
+    }
+    state.SetItemsProcessed(state.iterations() * raw.size());
+}
+BENCHMARK(BM_ApplyNMS)->ArgNames({"objects", "containment"})->ArgsProduct({{8, 32, 128, 512}, {0, 1}});
+
+void BM_UpdateVehicleTracking(benchmark::State& state) {
+    int objects = state.range(0);
+    DetectionManager manager;
+    setUpTracking(manager);
+    vector<vector<Detection>> frames = makeTrafficFrames(objects);
+    size_t frame = 0;
+    for (auto _ : state) {
+        // Swapped in and out so no copy is timed
+        manager.detections.swap(frames[frame]);
+        manager.updateVehicleTrackingSafe();
+        manager.detections.swap(frames[frame]);
+        frame = (frame + 1) % frames.size();
+    }
+    state.SetItemsProcessed(state.iterations() * objects);
+    state.counters["tracks"] = manager.getTrackedVehiclesCount();
+}
+BENCHMARK(BM_UpdateVehicleTracking)->ArgNames({"objects"})->Arg(8)->Arg(64)->Arg(512);
+
+// Slightly slanted lines spread across the frame; most checks miss, as in the app
+void BM_CheckLineCrossings(benchmark::State& state) {
+    int objects = state.range(0);
+    int lineCount = state.range(1);
+    DetectionManager manager;
+    setUpTracking(manager);
+    for (int i = 0; i < lineCount; i++) {
+        float x = FRAME_WIDTH * (i + 1) / (lineCount + 1);
+        manager.replayLines.push_back(make_pair(ofPoint(x, 0.0f), ofPoint(x + 40.0f, FRAME_HEIGHT)));
+    }
+
+    // Two frames give every track a previous position to cross from
+    vector<vector<Detection>> frames = makeTrafficFrames(objects);
+    for (int frame = 0; frame < 2; frame++) {
+        manager.detections = frames[frame];
+        manager.updateVehicleTrackingSafe();
+    }
+
+    for (auto _ : state) {
+        manager.checkLineCrossingsSafe();
+        manager.crossingEvents.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * objects * lineCount);
+}
+BENCHMARK(BM_CheckLineCrossings)->ArgNames({"objects", "lines"})->ArgsProduct({{8, 64, 512}, {1, 4, 16}});
+
+}
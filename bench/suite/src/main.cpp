@@ -0,0 +1,73 @@
+// Google Benchmark suite for the detection, tracking, scale and config hot paths.
+//
+// Build and run from the repository root (openFrameworks as for the app, plus
+// Google Benchmark: brew install google-benchmark):
+//   make bench             run everything; JSON in bench/suite/results/latest.json
+//   make bench-baseline    run, then keep the results as results/baseline.json
+//   make bench-compare     run, then fail if a benchmark is more than BENCH_THRESHOLD
+//                          (default 0.10 = 10%) slower than the baseline
+//
+// The binary takes the usual Google Benchmark flags, e.g.
+//   bench/suite/bin/sonify_bench.app/Contents/MacOS/sonify_bench --benchmark_filter=NMS
+// plus --config <config.json> for the config load benchmarks (make bench passes
+// bin/data/config.json).
+//
+// --soak SECONDS runs synthetic traffic through tracking, crossings and MIDI instead of
+// the benchmarks, printing throughput every 10 s and exiting 1 if the frames are not
+// reproducible, tracks pile up or tracking time drifts (make bench-soak). The scene is
+// set with --objects N (default 1000), --lines N (default 200) and --seed S (default 1).
+//
+// Links the app's sources without main.cpp and ofApp.cpp. No window is opened, and
+// nothing loads the model or opens the camera or MIDI/OSC ports.
+
+#include "bench_support.h"
+#include "synthetic_load.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    // Takes the --benchmark_* flags out of argv
+    benchmark::Initialize(&argc, argv);
+    float soakSeconds = 0.0f;
+    int soakObjects = 1000;
+    int soakLines = 200;
+    uint32_t soakSeed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            setBenchConfigSource(ofFilePath::getAbsolutePath(argv[++i], false));
+        } else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            soakSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+            soakObjects = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lines") == 0 && i + 1 < argc) {
+            soakLines = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            soakSeed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    ofInit();
+    ofSetLogLevel(OF_LOG_ERROR);    // Tracking and config loads log every event
+
+    char scratch[] = "/tmp/sonify_bench.XXXXXX";
+    if (!mkdtemp(scratch)) {
+        fprintf(stderr, "Could not create a scratch directory: %s\n", strerror(errno));
+        return 1;
+    }
+    ofSetDataPathRoot(string(scratch) + "/");
+
+    int result = 0;
+    if (soakSeconds > 0.0f) {
+        result = runSyntheticSoak(soakSeconds, soakObjects, soakLines, soakSeed);
+    } else {
+        benchmark::RunSpecifiedBenchmarks();
+    }
+    benchmark::Shutdown();
+
+    ofDirectory::removeDirectory(scratch, true, false);
+    return result;
+}
@@ -0,0 +1,108 @@
+// Note lookup and Scala scale loading.
+
+#include "bench_support.h"
+#include "LineManager.h"
+#include "ScaleManager.h"
+#include "ScalaParser.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Built-in master scales of increasing size, indexed by the scale argument
+const char* MASTER_SCALES[] = {"Pentatonic", "Major", "Chromatic"};
+const int LINE_COUNT = 8;
+
+// Pitches per Scala scale: pentatonic, 12-TET, 31-EDO, Partch-sized, large archive entries
+const vector<int64_t> SCALA_STEPS = {5, 12, 31, 43, 171};
+
+// random:1 takes the weighted random degree path, as lines do by default
+void BM_GetMidiNoteFromMasterScale(benchmark::State& state) {
+    LineManager lineManager;
+    lineManager.setMasterScale(MASTER_SCALES[state.range(0)]);
+    lineManager.lines.resize(LINE_COUNT);
+    for (int i = 0; i < LINE_COUNT; i++) {
+        lineManager.lines[i].randomizeNote = state.range(1) != 0;
+        lineManager.lines[i].scaleNoteIndex = i;
+    }
+
+    int lineIndex = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lineManager.getMidiNoteFromMasterScale(lineIndex));
+        lineIndex = (lineIndex + 1) % LINE_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(ofToString(MASTER_SCALES[state.range(0)]) + ", " +
+                   ofToString(lineManager.getScaleIntervals(lineManager.getMasterScale()).size()) + " notes");
+}
+BENCHMARK(BM_GetMidiNoteFromMasterScale)->ArgNames({"scale", "random"})->ArgsProduct({{0, 1, 2}, {0, 1}});
+
+// Walks every degree, octave and root so the pitch table reads are not all cache hits
+template<class Lookup>
+void runMicrotonalLookups(benchmark::State& state, int degreeCount, Lookup lookup) {
+    int degree = 0;
+    int octave = 0;
+    int root = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lookup(degree, root, octave));
+        if (++degree == degreeCount) {
+            degree = 0;
+            octave = (octave + 1) % ScaleManager::PITCH_TABLE_OCTAVES;
+            root = (root + 5) % 12;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetMicrotonalNote(benchmark::State& state) {
+    int steps = state.range(0);
+    ScaleManager scales;
+    scales.loadScalaFile(writeBenchScalaFile(steps));
+    ScaleManager::ScaleHandle handle = scales.getScaleHandle("bench_" + ofToString(steps));
+    if (handle == ScaleManager::INVALID_SCALE) {
+        state.SkipWithError("bench scale did not load");
+        return;
+    }
+    runMicrotonalLookups(state, steps + 1, [&](int degree, int root, int octave) {
+        return scales.getMicrotonalNote(handle, degree, root, octave);
+    });
+}
+BENCHMARK(BM_GetMicrotonalNote)->ArgNames({"steps"})->ArgsProduct({SCALA_STEPS});
+
+// The name overload the UI and config boundary use - a hash lookup before the table read
+void BM_GetMicrotonalNoteByName(benchmark::State& state) {
+    int steps = state.range(0);
+    ScaleManager scales;
+    scales.loadScalaFile(writeBenchScalaFile(steps));
+    string name = "bench_" + ofToString(steps);
+    runMicrotonalLookups(state, steps + 1, [&](int degree, int root, int octave) {
+        return scales.getMicrotonalNote(name, degree, root, octave);
+    });
+}
+BENCHMARK(BM_GetMicrotonalNoteByName)->ArgNames({"steps"})->ArgsProduct({SCALA_STEPS});
+
+// ScaleManager::parseScalaContent is private; this is the parse it wraps, reusing one
+// Result the way the library index does
+void BM_ScalaParse(benchmark::State& state) {
+    string content = makeBenchScalaContent(state.range(0));
+    ScalaParser::Result result;
+    for (auto _ : state) {
+        ScalaParser::parse(content, result);
+        benchmark::DoNotOptimize(result.intervals.data());
+    }
+    state.SetBytesProcessed(state.iterations() * content.size());
+}
+BENCHMARK(BM_ScalaParse)->ArgNames({"steps"})->ArgsProduct({SCALA_STEPS});
+
+// The whole import: read, parseScalaContent, compile the pitch table, register. Loading
+// the same file again replaces the scale under its existing handle.
+void BM_LoadScalaFile(benchmark::State& state) {
+    ScaleManager scales;
+    string path = writeBenchScalaFile(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scales.loadScalaFile(path));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoadScalaFile)->ArgNames({"steps"})->ArgsProduct({SCALA_STEPS});
+
+}
@@ -0,0 +1,44 @@
+// Synthetic traffic at load-test densities through tracking, crossing checks and MIDI
+// dispatch, one iteration per frame. Generating and scoring the frame are not timed.
+
+#include "synthetic_load.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+const int WARM_UP_FRAMES = 30;      // Every track has a previous position to cross from
+
+void BM_SyntheticTraffic(benchmark::State& state) {
+    SyntheticLoad load;
+    load.setup(SyntheticTraffic::makeScene(state.range(0), state.range(1)));
+    for (int i = 0; i < WARM_UP_FRAMES; i++) {
+        load.generateFrame();
+        load.trackFrame();
+        load.scoreFrame();
+    }
+
+    uint64_t crossings = load.getCrossings();
+    uint64_t midiEvents = load.getMidiEvents();
+    uint64_t idSwitches = load.getIdSwitches();
+    for (auto _ : state) {
+        state.PauseTiming();
+        load.generateFrame();
+        state.ResumeTiming();
+
+        load.trackFrame();
+
+        state.PauseTiming();
+        load.scoreFrame();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["crossings/s"] = benchmark::Counter(load.getCrossings() - crossings, benchmark::Counter::kIsRate);
+    state.counters["midi/s"] = benchmark::Counter(load.getMidiEvents() - midiEvents, benchmark::Counter::kIsRate);
+    state.counters["id_switches/frame"] = benchmark::Counter(load.getIdSwitches() - idSwitches,
+                                                             benchmark::Counter::kAvgIterations);
+    state.counters["tracks"] = load.getTrackCount();
+}
+BENCHMARK(BM_SyntheticTraffic)->ArgNames({"objects", "lines"})->ArgsProduct({{100, 1000}, {20, 200}})
+    ->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,195 @@
+#include "synthetic_load.h"
+#include <cstring>
+
+namespace {
+
+const float SOAK_REPORT_SECONDS = 10.0f;
+const int DETERMINISM_FRAMES = 300;
+const int TRUTH_EXPIRY_FRAMES = 300;        // Ground-truth vehicles unseen this long are forgotten
+
+// Tracks matched this frame carry their detection's box unchanged
+uint64_t boxKey(const ofRectangle& box) {
+    uint32_t x, y;
+    memcpy(&x, &box.x, sizeof(x));
+    memcpy(&y, &box.y, sizeof(y));
+    return ((uint64_t)x << 32) | y;
+}
+
+bool isDeterministic(const SyntheticTraffic::Settings& scene) {
+    SyntheticTraffic first, second;
+    first.reset(scene);
+    second.reset(scene);
+    vector<DetectionManager::Detection> firstDetections, secondDetections;
+    vector<int> firstIds, secondIds;
+    for (int frame = 0; frame < DETERMINISM_FRAMES; frame++) {
+        first.nextFrame(firstDetections, firstIds);
+        second.nextFrame(secondDetections, secondIds);
+        if (firstIds != secondIds) return false;
+        for (size_t i = 0; i < firstDetections.size(); i++) {
+            if (firstDetections[i].box != secondDetections[i].box ||
+                firstDetections[i].confidence != secondDetections[i].confidence ||
+                firstDetections[i].classId != secondDetections[i].classId) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+SyntheticLoad::SyntheticLoad() {
+    idSwitches = 0;
+}
+
+void SyntheticLoad::setup(const SyntheticTraffic::Settings& scene) {
+    traffic.reset(scene);
+    srand(scene.seed);          // Random line notes
+
+    lineManager.lines.clear();
+    for (const auto& line : scene.lines) {
+        LineManager::MidiLine midiLine;
+        midiLine.startPoint = line.first;
+        midiLine.endPoint = line.second;
+        lineManager.lines.push_back(midiLine);
+    }
+
+    // No tempo manager, so crossings take the immediate send path
+    communicationManager.setManagers(&lineManager);
+    communicationManager.oscEnabled = false;
+    communicationManager.midiEnabled = true;
+
+    // Tracking only runs with a model loaded; the detector itself is never called
+    detectionManager.enableDetection = true;
+    detectionManager.yoloLoaded = true;
+    detectionManager.selectedClassIds = traffic.getClassIds();
+    detectionManager.setLineManager(&lineManager);
+    detectionManager.setCommunicationManager(&communicationManager);
+
+    lastTracks.clear();
+    idSwitches = 0;
+}
+
+void SyntheticLoad::generateFrame() {
+    traffic.nextFrame(frameDetections, frameVehicleIds);
+    uint64_t captureMicros = ofGetElapsedTimeMicros();
+    for (auto& detection : frameDetections) {
+        detection.captureMicros = captureMicros;
+    }
+}
+
+void SyntheticLoad::trackFrame() {
+    // Last frame's detections come back out and are overwritten by the next generateFrame()
+    detectionManager.detections.swap(frameDetections);
+    detectionManager.trackingClock = traffic.getTime();
+    detectionManager.detectorRanThisFrame = true;
+    detectionManager.runTrackingStage(false, 1.0f / traffic.getSettings().frameRate);
+    communicationManager.update();
+}
+
+void SyntheticLoad::scoreFrame() {
+    const vector<DetectionManager::Detection>& detections = detectionManager.detections;
+    boxVehicles.clear();
+    for (size_t i = 0; i < detections.size(); i++) {
+        if (frameVehicleIds[i] >= 0) {
+            boxVehicles[boxKey(detections[i].box)] = frameVehicleIds[i];
+        }
+    }
+
+    int frame = traffic.getFrame();
+    for (const auto& track : detectionManager.getTrackedVehicles()) {
+        if (track.framesSinceLastSeen != 0) continue;
+        auto vehicle = boxVehicles.find(boxKey(track.currentBox));
+        if (vehicle == boxVehicles.end()) continue;
+
+        TruthMatch& match = lastTracks.emplace(vehicle->second, TruthMatch{track.id, frame}).first->second;
+        if (match.trackId != track.id) {
+            idSwitches++;
+            match.trackId = track.id;
+        }
+        match.lastFrame = frame;
+    }
+
+    if (frame % TRUTH_EXPIRY_FRAMES == 0) {
+        for (auto it = lastTracks.begin(); it != lastTracks.end();) {
+            it = frame - it->second.lastFrame > TRUTH_EXPIRY_FRAMES ? lastTracks.erase(it) : std::next(it);
+        }
+    }
+}
+
+int runSyntheticSoak(float seconds, int objects, int lines, uint32_t seed) {
+    SyntheticTraffic::Settings scene = SyntheticTraffic::makeScene(objects, lines, seed);
+    if (!isDeterministic(scene)) {
+        printf("FAIL: two runs with seed %u produced different frames\n", seed);
+        return 1;
+    }
+
+    SyntheticLoad load;
+    load.setup(scene);
+    printf("Soak: %d objects, %d lines, seed %u, %.0f s\n", objects, lines, seed, seconds);
+    printf("%8s %8s %9s %9s %12s %10s %11s %13s\n",
+           "time", "fps", "p50 us", "p99 us", "crossings/s", "MIDI/s", "ID switches", "tracks/truth");
+
+    uint64_t startMicros = ofGetElapsedTimeMicros();
+    uint64_t windowMicros = startMicros;
+    uint64_t windowFrames = 0;
+    uint64_t windowCrossings = load.getCrossings();
+    uint64_t windowMidiEvents = load.getMidiEvents();
+    float baselineP99 = 0.0f;
+    vector<string> failures;
+
+    while (failures.empty()) {
+        load.generateFrame();
+        load.trackFrame();
+        load.scoreFrame();
+        windowFrames++;
+
+        uint64_t nowMicros = ofGetElapsedTimeMicros();
+        bool done = nowMicros - startMicros >= seconds * 1e6;
+        if (nowMicros - windowMicros < SOAK_REPORT_SECONDS * 1e6 && !done) continue;
+
+        const LatencyHistogram& latency = load.detectionManager.trackingLatency;
+        float windowSeconds = (nowMicros - windowMicros) / 1e6f;
+        float p99 = latency.getPercentileMicros(99.0f);
+        printf("%7.0fs %8.0f %9.0f %9.0f %12.0f %10.0f %11llu %6d/%-6d\n",
+               (nowMicros - startMicros) / 1e6, windowFrames / windowSeconds,
+               latency.getPercentileMicros(50.0f), p99,
+               (load.getCrossings() - windowCrossings) / windowSeconds,
+               (load.getMidiEvents() - windowMidiEvents) / windowSeconds,
+               (unsigned long long)load.getIdSwitches(),
+               load.getTrackCount(), load.traffic.getVehicleCount());
+        fflush(stdout);
+
+        // Tracks should die within maxFramesWithoutDetection of their vehicle leaving;
+        // many more than there are vehicles means they are not being cleaned up
+        if (load.getTrackCount() > 3 * load.traffic.getVehicleCount() + 50) {
+            failures.push_back("track count runaway");
+        }
+        // The first window is the reference; the scene is steady state from frame 0
+        if (baselineP99 == 0.0f) {
+            baselineP99 = std::max(p99, 100.0f);
+        } else if (p99 > 4.0f * baselineP99) {
+            failures.push_back("tracking p99 drifted to " + ofToString(p99, 0) + " us from " +
+                               ofToString(baselineP99, 0) + " us");
+        }
+        if (done) break;
+
+        load.detectionManager.trackingLatency.reset();
+        windowMicros = nowMicros;
+        windowFrames = 0;
+        windowCrossings = load.getCrossings();
+        windowMidiEvents = load.getMidiEvents();
+    }
+
+    printf("%d frames, %llu vehicles, %llu crossings, %llu MIDI events, %llu ID switches\n",
+           load.traffic.getFrame(), (unsigned long long)load.traffic.getSpawnedCount(),
+           (unsigned long long)load.getCrossings(), (unsigned long long)load.getMidiEvents(),
+           (unsigned long long)load.getIdSwitches());
+    for (const string& failure : failures) {
+        printf("FAIL: %s\n", failure.c_str());
+    }
+    if (failures.empty()) {
+        printf("PASS\n");
+    }
+    return failures.empty() ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "synthetic_traffic.h"
+#include "CommunicationManager.h"
+#include "DetectionManager.h"
+#include "LineManager.h"
+#include <unordered_map>
+
+// SyntheticTraffic driven through the live post-inference path: tracking, crossing
+// checks, crossing dispatch and MIDI note-offs, as after a detector run. No port is
+// opened - CommunicationManager::setup() is never called - so MIDI goes through the
+// whole send path and is counted rather than heard, and OSC is off.
+class SyntheticLoad {
+public:
+    SyntheticLoad();
+
+    void setup(const SyntheticTraffic::Settings& scene);
+
+    void generateFrame();       // The next frame's detections, not part of the measured work
+    void trackFrame();          // The measured work: tracking stage plus note-offs
+    void scoreFrame();          // ID switches against the ground truth
+
+    float getTrackingUs() const { return detectionManager.lastTrackingUs + detectionManager.lastCrossingUs; }
+    uint64_t getCrossings() const { return detectionManager.captureToEmitLatency.getCount(); }
+    uint64_t getMidiEvents() const { return (unsigned)communicationManager.getTotalMidiEvents(); }
+    uint64_t getIdSwitches() const { return idSwitches; }
+    int getTrackCount() const { return detectionManager.getTrackedVehiclesCount(); }
+
+    LineManager lineManager;
+    CommunicationManager communicationManager;
+    DetectionManager detectionManager;
+    SyntheticTraffic traffic;
+
+private:
+    struct TruthMatch {
+        int trackId;
+        int lastFrame;
+    };
+
+    vector<DetectionManager::Detection> frameDetections;
+    vector<int> frameVehicleIds;
+    std::unordered_map<uint64_t, int> boxVehicles;      // Detection box -> ground-truth vehicle, this frame
+    std::unordered_map<int, TruthMatch> lastTracks;     // Ground-truth vehicle -> track it was last matched to
+    uint64_t idSwitches;
+};
+
+// --soak: SyntheticLoad flat out for the given time, a status line every 10 s. Returns
+// the exit code - 1 if the frames are not deterministic, the track count runs away or
+// tracking time drifts, 0 otherwise.
+int runSyntheticSoak(float seconds, int objects, int lines, uint32_t seed);
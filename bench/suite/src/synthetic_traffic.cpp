@@ -0,0 +1,219 @@
+#include "synthetic_traffic.h"
+
+namespace {
+
+// Vehicle mix per lane: share of the lane's traffic, box length relative to a car,
+// speed in pixels per second (a car covers 8 px per frame at 30 fps)
+struct VehicleKind {
+    int classId;
+    const char* className;
+    float share;
+    float length;
+    float speedMean;
+    float speedStdDev;
+};
+
+const VehicleKind VEHICLE_MIX[] = {
+    {2, "car",        0.70f, 1.0f, 240.0f, 40.0f},
+    {3, "motorcycle", 0.10f, 0.5f, 280.0f, 50.0f},
+    {5, "bus",        0.05f, 2.2f, 160.0f, 20.0f},
+    {7, "truck",      0.15f, 1.8f, 180.0f, 25.0f},
+};
+
+const int VEHICLES_PER_LANE = 40;
+const float OVERPASS_WIDTH = 48.0f;     // Six frames out of sight for a car
+
+}
+
+SyntheticTraffic::Settings SyntheticTraffic::makeScene(int objects, int lines, uint32_t seed) {
+    Settings scene;
+    scene.seed = seed;
+    scene.frameRate = 30.0f;
+    scene.width = 1920.0f;
+    scene.height = 1080.0f;
+    scene.positionNoise = 1.5f;
+    scene.sizeNoise = 0.04f;
+    scene.dropoutRate = 0.02f;
+    scene.falsePositivesPerFrame = std::max(objects * 0.005f, 0.5f);
+
+    int lanes = ofClamp(objects / VEHICLES_PER_LANE, 2, 24);
+    float laneSpacing = scene.height / lanes;
+    float carHeight = std::min(laneSpacing * 0.7f, 90.0f);
+    float vehiclesPerLane = (float)objects / lanes;
+    for (int lane = 0; lane < lanes; lane++) {
+        float y = (lane + 0.5f) * laneSpacing;
+        Path path;
+        path.start = ofPoint(lane % 2 == 0 ? 0.0f : scene.width, y);
+        path.end = ofPoint(lane % 2 == 0 ? scene.width : 0.0f, y);
+        path.laneWidth = laneSpacing * 0.3f;
+        scene.paths.push_back(path);
+
+        for (const VehicleKind& kind : VEHICLE_MIX) {
+            Flow flow;
+            flow.path = lane;
+            flow.classId = kind.classId;
+            flow.className = kind.className;
+            flow.size = ofVec2f(carHeight * 1.4f * kind.length, carHeight);
+            // Little's law: vehicles in view = arrival rate x time to cross the frame
+            flow.vehiclesPerSecond = vehiclesPerLane * kind.share * kind.speedMean / scene.width;
+            flow.speedMean = kind.speedMean;
+            flow.speedStdDev = kind.speedStdDev;
+            scene.flows.push_back(flow);
+        }
+    }
+
+    for (int i = 0; i < lines; i++) {
+        float x = scene.width * (i + 1) / (lines + 1);
+        scene.lines.push_back(make_pair(ofPoint(x, 0.0f), ofPoint(x + 40.0f, scene.height)));
+    }
+
+    for (int i = 1; i <= 2; i++) {
+        float x = scene.width * i / 3.0f;
+        scene.occluders.push_back(ofRectangle(x - OVERPASS_WIDTH / 2, 0.0f, OVERPASS_WIDTH, scene.height));
+    }
+    return scene;
+}
+
+SyntheticTraffic::SyntheticTraffic() {
+    frame = 0;
+    nextVehicleId = 0;
+}
+
+void SyntheticTraffic::reset(const Settings& sceneSettings) {
+    settings = sceneSettings;
+    rng.seed(settings.seed);
+    vehicles.clear();
+    frame = 0;
+    nextVehicleId = 0;
+
+    pathLengths.clear();
+    for (const Path& path : settings.paths) {
+        pathLengths.push_back(path.start.distance(path.end));
+    }
+
+    // Steady state from the first frame: a Poisson number of each flow already on its
+    // path, spread evenly along it
+    nextArrival.assign(settings.flows.size(), 0.0);
+    for (size_t i = 0; i < settings.flows.size(); i++) {
+        const Flow& flow = settings.flows[i];
+        if (flow.vehiclesPerSecond <= 0.0f || flow.speedMean <= 0.0f) {
+            nextArrival[i] = std::numeric_limits<double>::max();
+            continue;
+        }
+        float length = pathLengths[flow.path];
+        std::poisson_distribution<int> inView(flow.vehiclesPerSecond * length / flow.speedMean);
+        std::uniform_real_distribution<float> distance(0.0f, length);
+        for (int count = inView(rng); count > 0; count--) {
+            spawn(i, distance(rng));
+        }
+        nextArrival[i] = std::exponential_distribution<double>(flow.vehiclesPerSecond)(rng);
+    }
+}
+
+void SyntheticTraffic::spawn(int flowIndex, float distance) {
+    const Flow& flow = settings.flows[flowIndex];
+    float laneWidth = settings.paths[flow.path].laneWidth;
+    std::normal_distribution<float> speed(flow.speedMean, flow.speedStdDev);
+    std::uniform_real_distribution<float> offset(-laneWidth / 2, laneWidth / 2);
+
+    Vehicle vehicle;
+    vehicle.id = nextVehicleId++;
+    vehicle.flow = flowIndex;
+    vehicle.distance = distance;
+    vehicle.speed = std::max(speed(rng), flow.speedMean * 0.25f);    // Nobody stops or reverses
+    vehicle.offset = offset(rng);
+    vehicles.push_back(vehicle);
+}
+
+bool SyntheticTraffic::isOccluded(const ofPoint& centre) const {
+    for (const ofRectangle& occluder : settings.occluders) {
+        if (occluder.inside(centre)) return true;
+    }
+    return false;
+}
+
+void SyntheticTraffic::nextFrame(vector<DetectionManager::Detection>& detections, vector<int>& vehicleIds) {
+    frame++;
+    float frameTime = 1.0f / settings.frameRate;
+    double now = getTime();
+
+    for (Vehicle& vehicle : vehicles) {
+        vehicle.distance += vehicle.speed * frameTime;
+    }
+    vehicles.erase(std::remove_if(vehicles.begin(), vehicles.end(), [this](const Vehicle& vehicle) {
+        return vehicle.distance > pathLengths[settings.flows[vehicle.flow].path];
+    }), vehicles.end());
+
+    // Vehicles that arrived during the frame are already as far in as they would have got
+    for (size_t i = 0; i < settings.flows.size(); i++) {
+        while (nextArrival[i] <= now) {
+            spawn(i, 0.0f);
+            vehicles.back().distance = vehicles.back().speed * (now - nextArrival[i]);
+            nextArrival[i] += std::exponential_distribution<double>(settings.flows[i].vehiclesPerSecond)(rng);
+        }
+    }
+
+    detections.clear();
+    vehicleIds.clear();
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> confidence(0.55f, 0.95f);
+    std::normal_distribution<float> jitter(0.0f, settings.positionNoise);
+    std::normal_distribution<float> scale(1.0f, settings.sizeNoise);
+
+    // Axis-aligned boxes, as the detector reports them, whatever the path direction
+    for (const Vehicle& vehicle : vehicles) {
+        const Flow& flow = settings.flows[vehicle.flow];
+        const Path& path = settings.paths[flow.path];
+        ofPoint direction = (path.end - path.start) / pathLengths[flow.path];
+        ofPoint side(-direction.y, direction.x);
+        ofPoint centre = path.start + direction * vehicle.distance + side * vehicle.offset;
+        if (isOccluded(centre) || unit(rng) < settings.dropoutRate) continue;
+
+        float width = flow.size.x * std::max(scale(rng), 0.5f);
+        float height = flow.size.y * std::max(scale(rng), 0.5f);
+        DetectionManager::Detection detection;
+        detection.box = ofRectangle(centre.x - width / 2 + jitter(rng), centre.y - height / 2 + jitter(rng), width, height);
+        detection.confidence = confidence(rng);
+        detection.classId = flow.classId;
+        detection.className = flow.className;
+        detection.captureMicros = 0;
+        detections.push_back(detection);
+        vehicleIds.push_back(vehicle.id);
+    }
+
+    if (settings.falsePositivesPerFrame > 0.0f && !settings.flows.empty()) {
+        std::poisson_distribution<int> falsePositives(settings.falsePositivesPerFrame);
+        std::uniform_int_distribution<int> anyFlow(0, settings.flows.size() - 1);
+        std::uniform_real_distribution<float> weakConfidence(0.3f, 0.6f);
+        for (int count = falsePositives(rng); count > 0; count--) {
+            const Flow& flow = settings.flows[anyFlow(rng)];
+            DetectionManager::Detection detection;
+            detection.box = ofRectangle(unit(rng) * (settings.width - flow.size.x),
+                                        unit(rng) * (settings.height - flow.size.y),
+                                        flow.size.x, flow.size.y);
+            detection.confidence = weakConfidence(rng);
+            detection.classId = flow.classId;
+            detection.className = flow.className;
+            detection.captureMicros = 0;
+            detections.push_back(detection);
+            vehicleIds.push_back(-1);
+        }
+    }
+
+    // Detector output order carries no meaning; the tracker must not depend on it
+    for (int i = (int)detections.size() - 1; i > 0; i--) {
+        int j = std::uniform_int_distribution<int>(0, i)(rng);
+        std::swap(detections[i], detections[j]);
+        std::swap(vehicleIds[i], vehicleIds[j]);
+    }
+}
+
+vector<int> SyntheticTraffic::getClassIds() const {
+    vector<int> classIds;
+    for (const Flow& flow : settings.flows) {
+        if (std::find(classIds.begin(), classIds.end(), flow.classId) == classIds.end()) {
+            classIds.push_back(flow.classId);
+        }
+    }
+    return classIds;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ofMain.h"
+#include "DetectionManager.h"
+#include <random>
+
+// Seeded synthetic traffic for load-testing tracking, crossings and MIDI at densities
+// no camera delivers. Vehicles arrive on straight paths (Poisson arrivals per flow),
+// drive along them at a speed drawn from the flow's distribution, and are reported as
+// per-frame detections with the failure modes of a real detector: box jitter, random
+// dropouts, misses behind occluders and false positives. The same settings and seed
+// always produce the same frames (for a given standard library - the <random>
+// distributions are implementation-defined).
+class SyntheticTraffic {
+public:
+    typedef vector<pair<ofPoint, ofPoint>> LineSet;    // Same layout as DetectionTrace::LineSet
+
+    struct Path {
+        ofPoint start;
+        ofPoint end;
+        float laneWidth;            // Vehicles are spread sideways across this, pixels
+    };
+
+    struct Flow {
+        int path;
+        int classId;                // COCO class reported for every vehicle of the flow
+        string className;
+        ofVec2f size;               // Box size, pixels
+        float vehiclesPerSecond;    // Mean arrival rate
+        float speedMean;            // Pixels per second
+        float speedStdDev;
+    };
+
+    struct Settings {
+        uint32_t seed;
+        float frameRate;
+        float width;
+        float height;
+        vector<Path> paths;
+        vector<Flow> flows;
+        LineSet lines;                  // Crossing lines for the harness, not used here
+        vector<ofRectangle> occluders;  // Vehicles centred inside one are not detected
+        float positionNoise;            // Box jitter standard deviation, pixels
+        float sizeNoise;                // Box size jitter standard deviation, fraction of the size
+        float dropoutRate;              // Chance a visible vehicle is missed in a frame
+        float falsePositivesPerFrame;   // Mean, boxes anywhere in the frame
+    };
+
+    // Multi-lane road across the frame, lanes alternating direction, with a mix of cars,
+    // motorcycles, buses and trucks sized so about `objects` vehicles are in view. `lines`
+    // slightly slanted crossing lines are spread across it and two overpasses hide
+    // vehicles for a few frames each.
+    static Settings makeScene(int objects, int lines, uint32_t seed = 1);
+
+    SyntheticTraffic();
+
+    // Starts the scene over at frame 0, already filled with its steady-state traffic
+    void reset(const Settings& sceneSettings);
+
+    // Advances one frame. detections gets this frame's boxes in no particular order and
+    // vehicleIds the ground-truth vehicle of each, -1 for a false positive.
+    void nextFrame(vector<DetectionManager::Detection>& detections, vector<int>& vehicleIds);
+
+    const Settings& getSettings() const { return settings; }
+    int getFrame() const { return frame; }
+    float getTime() const { return frame / settings.frameRate; }
+    int getVehicleCount() const { return vehicles.size(); }     // On a path, detected or not
+    int getSpawnedCount() const { return nextVehicleId; }
+    vector<int> getClassIds() const;
+
+private:
+    struct Vehicle {
+        int id;
+        int flow;
+        float distance;             // Along the path, pixels
+        float speed;                // Pixels per second
+        float offset;               // Sideways from the path centre, pixels
+    };
+
+    void spawn(int flowIndex, float distance);
+    bool isOccluded(const ofPoint& centre) const;
+
+    Settings settings;
+    std::mt19937 rng;
+    vector<Vehicle> vehicles;
+    vector<float> pathLengths;
+    vector<double> nextArrival;     // Per flow, seconds
+    int frame;
+    int nextVehicleId;
+};
@@ -0,0 +1,168 @@
+// Stress test and timing for VoiceAllocator.
+//
+// Build (from the repository root, no openFrameworks needed):
+//   c++ -std=c++17 -O2 -Isrc bench/voice_allocator_bench.cpp src/VoiceAllocator.cpp -o bench/voice_allocator_bench
+//
+// Run:
+//   bench/voice_allocator_bench [--notes N] [--events N] [--channels N]
+//
+// Keeps N notes outstanding (default 500, far more than the 15 member channels) and
+// plays random note-ons and note-offs against a reference model that checks every
+// result: one voice per channel, no steal while a channel is free, the oldest voice is
+// the one stolen, free channels are reused least recently released first, and stale
+// note-offs are rejected. Reports ns per operation. Exits non-zero on any mismatch.
+
+#include "VoiceAllocator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+struct ModelChannel {
+    uint32_t voice;            // 0 when free
+    int note;
+    uint64_t startOrder;
+    uint64_t releaseOrder;
+};
+
+struct Outstanding {
+    int channel;
+    uint32_t voice;
+};
+
+static int failures = 0;
+
+static void fail(const char* message, uint64_t event) {
+    if (failures++ < 10) {
+        printf("  mismatch at event %llu: %s\n", (unsigned long long)event, message);
+    }
+}
+
+int main(int argc, char** argv) {
+    int targetNotes = 500;
+    uint64_t events = 2000000;
+    int channels = 15;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--notes") == 0 && i + 1 < argc) targetNotes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) events = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--channels") == 0 && i + 1 < argc) channels = atoi(argv[++i]);
+    }
+    channels = max(1, min(channels, 15));
+    targetNotes = max(targetNotes, 1);
+
+    VoiceAllocator allocator;
+    allocator.configure(2, 1 + channels);
+
+    vector<ModelChannel> model(channels, ModelChannel{0, -1, 0, 0});
+    for (int i = 0; i < channels; i++) {
+        model[i].releaseOrder = i;     // Initial free order is channel order
+    }
+    uint64_t order = channels;
+    vector<Outstanding> outstanding;
+    outstanding.reserve(targetNotes * 2);
+    mt19937 random(4242);
+    uint64_t steals = 0;
+    uint64_t staleOffs = 0;
+
+    // Verification pass
+    for (uint64_t event = 0; event < events; event++) {
+        // Hover around targetNotes outstanding
+        bool playNote = outstanding.empty() ||
+                        ((int)outstanding.size() < targetNotes ? random() % 4 != 0 : random() % 4 == 0);
+
+        if (playNote) {
+            int note = random() % 128;
+
+            // Expected: least recently released free channel, else the oldest busy one
+            int expected = -1;
+            bool expectSteal = false;
+            for (int c = 0; c < channels; c++) {
+                if (model[c].voice == 0 && (expected < 0 || model[c].releaseOrder < model[expected].releaseOrder)) {
+                    expected = c;
+                }
+            }
+            if (expected < 0) {
+                expectSteal = true;
+                for (int c = 0; c < channels; c++) {
+                    if (expected < 0 || model[c].startOrder < model[expected].startOrder) {
+                        expected = c;
+                    }
+                }
+            }
+
+            VoiceAllocator::Allocation allocation = allocator.noteOn(note);
+            int slot = allocation.channel - 2;
+            if (slot != expected) fail("wrong channel", event);
+            if (allocation.stolen != expectSteal) fail("steal mismatch", event);
+            if (expectSteal && allocation.stolenNote != model[expected].note) fail("wrong stolen note", event);
+            if (allocation.voice == 0) fail("voice id 0", event);
+            if (slot < 0 || slot >= channels) {
+                fail("channel out of range", event);
+                break;
+            }
+
+            steals += allocation.stolen;
+            model[slot] = {allocation.voice, note, order++, 0};
+            outstanding.push_back({allocation.channel, allocation.voice});
+        } else {
+            size_t index = random() % outstanding.size();
+            Outstanding released = outstanding[index];
+            outstanding[index] = outstanding.back();
+            outstanding.pop_back();
+
+            ModelChannel& channel = model[released.channel - 2];
+            bool expected = channel.voice == released.voice;
+            bool result = allocator.noteOff(released.channel, released.voice);
+            if (result != expected) fail("noteOff result", event);
+            if (expected) {
+                channel.voice = 0;
+                channel.releaseOrder = order++;
+            } else {
+                staleOffs++;
+                // A second note-off for the same voice must also be rejected
+                if (allocator.noteOff(released.channel, released.voice)) fail("double noteOff accepted", event);
+            }
+        }
+
+        int active = 0;
+        for (const ModelChannel& channel : model) active += channel.voice != 0;
+        if (active != allocator.getActiveCount()) fail("active count", event);
+    }
+
+    printf("Verified %llu events, %d channels, ~%d notes outstanding: %llu steals, %llu stale note-offs, %d mismatches\n",
+           (unsigned long long)events, channels, targetNotes, (unsigned long long)steals,
+           (unsigned long long)staleOffs, failures);
+
+    // Timing pass - allocator only, same workload shape
+    allocator.reset();
+    outstanding.clear();
+    vector<uint32_t> randomBits(1 << 16);
+    for (uint32_t& bits : randomBits) bits = random();
+    uint64_t operations = 0;
+    uint64_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (uint64_t event = 0; event < events; event++) {
+        uint32_t bits = randomBits[event & 0xFFFF];
+        if (outstanding.empty() || ((int)outstanding.size() < targetNotes ? (bits & 3) != 0 : (bits & 3) == 0)) {
+            VoiceAllocator::Allocation allocation = allocator.noteOn(bits & 127);
+            outstanding.push_back({allocation.channel, allocation.voice});
+            checksum += allocation.channel;
+        } else {
+            size_t index = (bits >> 8) % outstanding.size();
+            checksum += allocator.noteOff(outstanding[index].channel, outstanding[index].voice);
+            outstanding[index] = outstanding.back();
+            outstanding.pop_back();
+        }
+        operations++;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("Timing: %.1f ns/op including bookkeeping (checksum %llu)\n", seconds * 1e9 / operations,
+           (unsigned long long)checksum);
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cstddef>
+
+// The built-in scales as compile-time tables - the single definition shared by
+// ScaleManager (which copies them into its scale table) and LineManager (which only
+// needs the 12-TET approximation). Cents for ratio-defined scales, ratios for
+// cents-defined ones, the per-degree key and pitch bend, and the 12-TET approximation
+// are all derived by the compiler, so nothing is computed at startup.
+//
+// The derivations mirror ScaleManager::computeDegree and compileScale (float
+// arithmetic, truncation to the key below, ±200 cent bend range); the static_asserts
+// at the bottom pin a few values so the two cannot drift apart unnoticed.
+// Independent of openFrameworks.
+namespace BuiltinScales {
+
+constexpr int MAX_INTERVALS = 30;          // 31-Tone Equal, root excluded
+constexpr int DESCRIPTION_LENGTH = 24;
+
+struct Interval {
+    float cents;
+    float ratio;
+    char description[DESCRIPTION_LENGTH];
+};
+
+// Key and bend for one degree above the root, before octave and root are applied
+struct Degree {
+    int semitones;
+    int pitchBend;
+};
+
+struct Definition {
+    const char* name;
+    const char* description;
+    bool isMicrotonal;
+    int intervalCount;
+    Interval intervals[MAX_INTERVALS];
+
+    // Derived
+    Degree degrees[MAX_INTERVALS + 1];     // Root first
+    int semitoneCount;
+    int semitoneIntervals[MAX_INTERVALS + 1];  // 12-TET approximation within one octave, root first
+};
+
+namespace detail {
+
+constexpr double LN2 = 0.69314718055994530942;
+
+// Natural log and exp to double precision, for ratio <-> cents conversion
+constexpr double log(double x) {
+    int exponent = 0;
+    while (x >= 2.0) { x /= 2.0; exponent++; }
+    while (x < 1.0) { x *= 2.0; exponent--; }
+    // ln(x) = 2 atanh((x - 1) / (x + 1)), which converges quickly for x in [1, 2)
+    double y = (x - 1.0) / (x + 1.0);
+    double term = y;
+    double sum = 0.0;
+    for (int n = 1; n < 61; n += 2) {
+        sum += term / n;
+        term *= y * y;
+    }
+    return 2.0 * sum + exponent * LN2;
+}
+
+constexpr double exp(double x) {
+    int exponent = (int)(x / LN2);
+    if (x < 0.0) exponent--;
+    double r = x - exponent * LN2;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 30; n++) {
+        term *= r / n;
+        sum += term;
+    }
+    for (; exponent > 0; exponent--) sum *= 2.0;
+    for (; exponent < 0; exponent++) sum /= 2.0;
+    return sum;
+}
+
+constexpr float ratioToCents(double ratio) {
+    return (float)(1200.0 * log(ratio) / LN2);
+}
+
+constexpr float centsToRatio(double cents) {
+    return (float)exp(cents / 1200.0 * LN2);
+}
+
+constexpr bool equal(const char* a, const char* b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+constexpr void copyDescription(char* out, const char* text, int number = 0) {
+    int length = 0;
+    while (text[length] && length < DESCRIPTION_LENGTH - 1) {
+        out[length] = text[length];
+        length++;
+    }
+    if (number > 0) {
+        char digits[8] = {};
+        int count = 0;
+        for (; number > 0; number /= 10) digits[count++] = (char)('0' + number % 10);
+        while (count > 0 && length < DESCRIPTION_LENGTH - 1) out[length++] = digits[--count];
+    }
+    out[length] = '\0';
+}
+
+// Same steps as ScaleManager::computeDegree and compileScale
+constexpr Definition derive(Definition scale) {
+    scale.degrees[0] = {0, 0};
+    scale.semitoneIntervals[0] = 0;
+    scale.semitoneCount = 1;
+    for (int i = 0; i < scale.intervalCount; i++) {
+        float cents = scale.intervals[i].cents;
+        int semitones = (int)(cents / 100.0f);
+        float remaining = cents - (semitones * 100.0f);
+        float clamped = remaining < -200.0f ? -200.0f : (remaining > 200.0f ? 200.0f : remaining);
+        scale.degrees[i + 1] = {semitones, scale.isMicrotonal ? (int)(clamped / 200.0f * 8191.0f) : 0};
+
+        if (cents < 1200.0f && scale.semitoneCount == i + 1) {
+            scale.semitoneIntervals[scale.semitoneCount++] = (int)(cents / 100.0f + 0.5f);
+        }
+    }
+    return scale;
+}
+
+struct CentsStep {
+    float cents;
+    float ratio;
+    const char* description;
+};
+
+struct SemitoneStep {
+    int semitones;
+    const char* description;
+};
+
+struct RatioStep {
+    double ratio;
+    const char* description;
+};
+
+}  // namespace detail
+
+// Degrees given in cents with their nominal just ratios
+template <size_t N>
+constexpr Definition fromCents(const char* name, const char* description, const detail::CentsStep (&steps)[N]) {
+    static_assert(N <= MAX_INTERVALS, "too many intervals");
+    Definition scale = {};
+    scale.name = name;
+    scale.description = description;
+    scale.isMicrotonal = false;
+    scale.intervalCount = (int)N;
+    for (size_t i = 0; i < N; i++) {
+        scale.intervals[i].cents = steps[i].cents;
+        scale.intervals[i].ratio = steps[i].ratio;
+        detail::copyDescription(scale.intervals[i].description, steps[i].description);
+    }
+    return detail::derive(scale);
+}
+
+// 12-TET degrees given in semitones, ratios exact powers of two
+template <size_t N>
+constexpr Definition fromSemitones(const char* name, const char* description, const detail::SemitoneStep (&steps)[N]) {
+    static_assert(N <= MAX_INTERVALS, "too many intervals");
+    Definition scale = {};
+    scale.name = name;
+    scale.description = description;
+    scale.isMicrotonal = false;
+    scale.intervalCount = (int)N;
+    for (size_t i = 0; i < N; i++) {
+        float cents = steps[i].semitones * 100.0f;
+        scale.intervals[i].cents = cents;
+        scale.intervals[i].ratio = detail::centsToRatio(cents);
+        detail::copyDescription(scale.intervals[i].description, steps[i].description);
+    }
+    return detail::derive(scale);
+}
+
+// Pure ratios, cents derived
+template <size_t N>
+constexpr Definition fromRatios(const char* name, const char* description, const detail::RatioStep (&steps)[N]) {
+    static_assert(N <= MAX_INTERVALS, "too many intervals");
+    Definition scale = {};
+    scale.name = name;
+    scale.description = description;
+    scale.isMicrotonal = true;
+    scale.intervalCount = (int)N;
+    for (size_t i = 0; i < N; i++) {
+        scale.intervals[i].cents = detail::ratioToCents(steps[i].ratio);
+        scale.intervals[i].ratio = (float)steps[i].ratio;
+        detail::copyDescription(scale.intervals[i].description, steps[i].description);
+    }
+    return detail::derive(scale);
+}
+
+// Equal divisions of a period; steps are labelled "<label> <n>"
+constexpr Definition equalDivisions(const char* name, const char* description, int divisions, float periodCents,
+                                    const char* label) {
+    Definition scale = {};
+    scale.name = name;
+    scale.description = description;
+    scale.isMicrotonal = true;
+    scale.intervalCount = divisions - 1;
+    for (int i = 1; i < divisions; i++) {
+        Interval& interval = scale.intervals[i - 1];
+        interval.cents = (i * periodCents) / (float)divisions;
+        interval.ratio = detail::centsToRatio(interval.cents);
+        detail::copyDescription(interval.description, label, i);
+    }
+    return detail::derive(scale);
+}
+
+inline constexpr Definition SCALES[] = {
+    // Traditional Western scales (12-tone equal temperament)
+    fromCents("Major", "Major scale (Ionian mode) - happy, bright character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {400.0f, 5.0f/4.0f, "major third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {900.0f, 27.0f/16.0f, "major sixth"},
+        {1100.0f, 15.0f/8.0f, "major seventh"}
+    }),
+    fromCents("Minor", "Natural minor scale (Aeolian mode) - sad, introspective character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {800.0f, 8.0f/5.0f, "minor sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromCents("Pentatonic", "Major pentatonic scale - universal, folk character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {400.0f, 5.0f/4.0f, "major third"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {900.0f, 27.0f/16.0f, "major sixth"}
+    }),
+    fromCents("Blues", "Blues scale - expressive, soulful character", {
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {600.0f, 7.0f/5.0f, "tritone"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromSemitones("Chromatic", "All 12 semitones - complete chromatic spectrum", {
+        {1, "minor second"},
+        {2, "major second"},
+        {3, "minor third"},
+        {4, "major third"},
+        {5, "perfect fourth"},
+        {6, "tritone"},
+        {7, "perfect fifth"},
+        {8, "minor sixth"},
+        {9, "major sixth"},
+        {10, "minor seventh"},
+        {11, "major seventh"}
+    }),
+    fromCents("Dorian", "Dorian mode - minor with raised 6th, jazzy character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {900.0f, 27.0f/16.0f, "major sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromCents("Phrygian", "Phrygian mode - minor with flat 2nd, Spanish/Middle Eastern character", {
+        {100.0f, 16.0f/15.0f, "minor second"},
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {800.0f, 8.0f/5.0f, "minor sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromCents("Lydian", "Lydian mode - major with raised 4th, dreamy character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {400.0f, 5.0f/4.0f, "major third"},
+        {600.0f, 45.0f/32.0f, "augmented fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {900.0f, 27.0f/16.0f, "major sixth"},
+        {1100.0f, 15.0f/8.0f, "major seventh"}
+    }),
+    fromCents("Mixolydian", "Mixolydian mode - major with flat 7th, bluesy character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {400.0f, 5.0f/4.0f, "major third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {900.0f, 27.0f/16.0f, "major sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromCents("Aeolian", "Aeolian mode (Natural Minor) - melancholic character", {
+        {200.0f, 9.0f/8.0f, "major second"},
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {700.0f, 3.0f/2.0f, "perfect fifth"},
+        {800.0f, 8.0f/5.0f, "minor sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+    fromCents("Locrian", "Locrian mode - diminished character, theoretical", {
+        {100.0f, 16.0f/15.0f, "minor second"},
+        {300.0f, 6.0f/5.0f, "minor third"},
+        {500.0f, 4.0f/3.0f, "perfect fourth"},
+        {600.0f, 64.0f/45.0f, "diminished fifth"},
+        {800.0f, 8.0f/5.0f, "minor sixth"},
+        {1000.0f, 16.0f/9.0f, "minor seventh"}
+    }),
+
+    // Microtonal scales
+    fromRatios("Just Intonation", "Just intonation major scale - pure harmonic ratios", {
+        {9.0/8.0, "major second (9:8)"},
+        {5.0/4.0, "major third (5:4)"},
+        {4.0/3.0, "perfect fourth (4:3)"},
+        {3.0/2.0, "perfect fifth (3:2)"},
+        {5.0/3.0, "major sixth (5:3)"},
+        {15.0/8.0, "major seventh (15:8)"}
+    }),
+    equalDivisions("Bohlen-Pierce", "13-tone equal temperament, 3:1 tritave", 13, 1901.955f, "BP step "),
+    equalDivisions("19-Tone Equal", "19 equal divisions of the octave", 19, 1200.0f, "19ED step "),
+    equalDivisions("31-Tone Equal", "31 equal divisions of the octave - quarter-comma meantone approximation", 31, 1200.0f,
+                   "31ED step ")
+};
+
+constexpr int COUNT = (int)(sizeof(SCALES) / sizeof(SCALES[0]));
+
+// nullptr for names that are not built in
+constexpr const Definition* find(const char* name) {
+    for (const Definition& scale : SCALES) {
+        if (detail::equal(scale.name, name)) return &scale;
+    }
+    return nullptr;
+}
+
+static_assert(find("Major")->semitoneCount == 7 && find("Major")->semitoneIntervals[6] == 11, "Major");
+static_assert(find("Blues")->semitoneIntervals[3] == 6, "Blues");
+static_assert(find("Just Intonation")->intervals[3].cents > 701.95f && find("Just Intonation")->intervals[3].cents < 701.96f,
+              "3:2 is 701.955 cents");
+static_assert(find("Just Intonation")->degrees[2].semitones == 3 && find("Just Intonation")->degrees[2].pitchBend == 3534,
+              "5:4 is key +3 bent 86.3 cents");
+static_assert(find("Bohlen-Pierce")->intervals[11].ratio > 2.75f && find("Bohlen-Pierce")->intervals[11].ratio < 2.77f,
+              "BP step 12 is 3^(12/13)");
+static_assert(find("31-Tone Equal")->intervalCount == MAX_INTERVALS, "31-TET fills the table");
+
+}  // namespace BuiltinScales
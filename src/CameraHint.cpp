@@ -0,0 +1,38 @@
+#include "CameraHint.h"
+#include <fstream>
+
+static const char HINT_MAGIC[4] = {'S', 'V', 'C', 'H'};
+static const size_t HINT_SIZE = sizeof(HINT_MAGIC) + sizeof(uint16_t) + 3 * sizeof(int32_t);
+
+bool CameraHint::load(const string& path) {
+    char bytes[HINT_SIZE];
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(bytes, HINT_SIZE)) {
+        return false;
+    }
+
+    uint16_t version;
+    memcpy(&version, bytes + 4, sizeof(version));
+    if (memcmp(bytes, HINT_MAGIC, sizeof(HINT_MAGIC)) != 0 || version != VERSION) {
+        return false;
+    }
+
+    CameraHint hint;
+    memcpy(&hint.deviceId, bytes + 6, sizeof(int32_t));
+    memcpy(&hint.width, bytes + 10, sizeof(int32_t));
+    memcpy(&hint.height, bytes + 14, sizeof(int32_t));
+    if (!hint.isValid()) {
+        return false;
+    }
+    *this = hint;
+    return true;
+}
+
+string CameraHint::encode() const {
+    string buffer(HINT_MAGIC, sizeof(HINT_MAGIC));
+    buffer.append(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    buffer.append(reinterpret_cast<const char*>(&deviceId), sizeof(deviceId));
+    buffer.append(reinterpret_cast<const char*>(&width), sizeof(width));
+    buffer.append(reinterpret_cast<const char*>(&height), sizeof(height));
+    return buffer;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ofMain.h"
+
+// The camera mode that opened last run, kept in data/camera.hint so VideoManager can
+// open it straight away instead of probing resolutions that fail. ConfigManager's
+// writer thread rewrites it only when the mode changes. A missing, short or foreign
+// file just means probing as before, so there is nothing to migrate.
+//
+// Layout (little-endian):
+//   "SVCH" | uint16 version | int32 deviceId | int32 width | int32 height
+struct CameraHint {
+    static constexpr uint16_t VERSION = 1;
+
+    int32_t deviceId;          // -1 = no hint
+    int32_t width;
+    int32_t height;
+
+    CameraHint() : deviceId(-1), width(0), height(0) {}
+
+    bool isValid() const { return deviceId >= 0 && width > 0 && height > 0; }
+    bool operator==(const CameraHint& other) const {
+        return deviceId == other.deviceId && width == other.width && height == other.height;
+    }
+    bool operator!=(const CameraHint& other) const { return !(*this == other); }
+
+    bool load(const string& path);
+    string encode() const;
+};
@@ -1,6 +1,7 @@
 #include "CommunicationManager.h"
 #include "LineManager.h"
 #include "ScaleManager.h"
+#include "TempoManager.h"
 
 CommunicationManager::CommunicationManager() {
     // OSC initialization
@@ -15,11 +16,27 @@ CommunicationManager::CommunicationManager() {
     midiActivityCounter = 0;
     totalMidiEvents = 0;  // Initialize MIDI event counter
     
+    // MPE lower zone over all member channels
+    mpeEnabled = false;
+    mpeFirstChannel = 2;
+    mpeLastChannel = 16;
+    mpePitchBendRange = 2;
+    mpeConfigurationPending = false;
+    voiceAllocator.configure(mpeFirstChannel, mpeLastChannel);
+    
     lineManager = nullptr;
     scaleManager = nullptr;
+    tempoManager = nullptr;
+    profiler = nullptr;
+    schedulerThreadNamed = false;
 }
 
 CommunicationManager::~CommunicationManager() {
+    // Stop the scheduler first - it flushes pending note-offs through the ports
+    noteScheduler.stop();
+    // Then the recorder, so those note-offs end up in the file
+    midiRecorder.stop();
+    
     // Close all MIDI ports
     for (auto& midiOut : midiOuts) {
         if (midiOut.isOpen()) {
@@ -34,11 +51,22 @@ void CommunicationManager::setup() {
     
     // Setup MIDI
     setupMIDI();
+    noteScheduler.start([this](const NoteScheduler::Event& event) { dispatchScheduledEvent(event); });
     
     ofLogNotice() << "CommunicationManager: Initialized";
 }
 
 void CommunicationManager::update() {
+    // Send MTS retuning when the master scale or root changed
+    syncMIDITuning();
+    
+    if (mpeConfigurationPending) {
+        mpeConfigurationPending = false;
+        if (mpeEnabled) {
+            sendMPEConfiguration();
+        }
+    }
+    
     // Update MIDI timing for note-offs
     updateMIDITiming();
     processMIDINoteOffs();
@@ -61,9 +89,15 @@ void CommunicationManager::setupOSC(const string& host, int port) {
 
 void CommunicationManager::sendOSCLineCrossing(int lineId, int vehicleId, int vehicleType, 
                                               const string& className, float confidence, float speed, 
-                                              float speedMph, const ofPoint& crossingPoint) {
+                                              float speedMph, const ofPoint& crossingPoint,
+                                              uint64_t captureMicros) {
     if (!oscEnabled) return;
     
+    // Frame capture time (app monotonic clock, microseconds) and its age at send time,
+    // so receivers can subtract the age to place the event at capture time
+    uint64_t sendMicros = ofGetElapsedTimeMicros();
+    int64_t ageMicros = captureMicros > 0 && sendMicros >= captureMicros ? (int64_t)(sendMicros - captureMicros) : 0;
+    
     // Send detailed OSC message
     ofxOscMessage message;
     message.setAddress("/line_cross");
@@ -77,6 +111,8 @@ void CommunicationManager::sendOSCLineCrossing(int lineId, int vehicleId, int ve
     message.addFloatArg(crossingPoint.x);
     message.addFloatArg(crossingPoint.y);
     message.addInt64Arg(ofGetElapsedTimeMillis());
+    message.addInt64Arg((int64_t)captureMicros);
+    message.addInt64Arg(ageMicros);
     
     oscSender.sendMessage(message, false);
     
@@ -86,6 +122,8 @@ void CommunicationManager::sendOSCLineCrossing(int lineId, int vehicleId, int ve
     noteMessage.addIntArg(lineId);
     noteMessage.addIntArg(60 + lineId);  // Simple note mapping
     noteMessage.addIntArg((int)(confidence * 127));  // Velocity from confidence
+    noteMessage.addInt64Arg((int64_t)captureMicros);
+    noteMessage.addInt64Arg(ageMicros);
     
     oscSender.sendMessage(noteMessage, false);
     
@@ -113,37 +151,59 @@ void CommunicationManager::sendOSCPoseCrossing(int lineId, int personId, const s
                  << " Person:" << personId << " Joint:" << jointName;
 }
 
+// Adaptive detection cadence: frames between detector runs, detector rate and its cost
+void CommunicationManager::sendOSCDetectionCadence(int frameSkip, float detectionHz, float inferenceMs, float latencyMs) {
+    if (!oscEnabled) return;
+    
+    ofxOscMessage message;
+    message.setAddress("/detection/cadence");
+    message.addIntArg(frameSkip);
+    message.addFloatArg(detectionHz);
+    message.addFloatArg(inferenceMs);
+    message.addFloatArg(latencyMs);
+    message.addInt64Arg(ofGetElapsedTimeMillis());
+    
+    oscSender.sendMessage(message, false);
+}
+
 void CommunicationManager::setupMIDI() {
     refreshMIDIPorts();
     ofLogNotice() << "CommunicationManager: MIDI setup complete";
 }
 
 void CommunicationManager::refreshMIDIPorts() {
-    // Close existing ports
-    for (auto& midiOut : midiOuts) {
-        if (midiOut.isOpen()) {
-            midiOut.closePort();
+    int numPorts = 0;
+    {
+        std::lock_guard<std::mutex> lock(midiMutex);
+        
+        // Close existing ports
+        for (auto& midiOut : midiOuts) {
+            if (midiOut.isOpen()) {
+                midiOut.closePort();
+            }
         }
-    }
-    
-    midiOuts.clear();
-    midiPortNames.clear();
-    midiPortSelected.clear();
-    midiPortConnected.clear();
-    
-    // Get available MIDI ports
-    ofxMidiOut tempMidiOut;
-    tempMidiOut.listOutPorts();
-    
-    int numPorts = tempMidiOut.getNumOutPorts();
-    for (int i = 0; i < numPorts; i++) {
-        string portName = tempMidiOut.getOutPortName(i);
-        midiPortNames.push_back(portName);
-        midiPortSelected.push_back(false);
-        midiPortConnected.push_back(false);
         
-        ofxMidiOut newMidiOut;
-        midiOuts.push_back(newMidiOut);
+        midiOuts.clear();
+        midiPortNames.clear();
+        midiPortSelected.clear();
+        midiPortConnected.clear();
+        midiPortClock.clear();
+        
+        // Get available MIDI ports
+        ofxMidiOut tempMidiOut;
+        tempMidiOut.listOutPorts();
+        
+        numPorts = tempMidiOut.getNumOutPorts();
+        for (int i = 0; i < numPorts; i++) {
+            string portName = tempMidiOut.getOutPortName(i);
+            midiPortNames.push_back(portName);
+            midiPortSelected.push_back(false);
+            midiPortConnected.push_back(false);
+            midiPortClock.push_back(false);
+            
+            ofxMidiOut newMidiOut;
+            midiOuts.push_back(newMidiOut);
+        }
     }
     
     // Auto-select first available port if available
@@ -155,10 +215,15 @@ void CommunicationManager::refreshMIDIPorts() {
 }
 
 void CommunicationManager::connectMIDIPort(int portIndex) {
+    std::lock_guard<std::mutex> lock(midiMutex);
     if (portIndex >= 0 && portIndex < midiOuts.size()) {
         if (!midiOuts[portIndex].isOpen()) {
             if (midiOuts[portIndex].openPort(portIndex)) {
                 midiPortConnected[portIndex] = true;
+                if (scaleManager) {
+                    scaleManager->invalidateTuning(); // New port has not seen the tuning yet
+                }
+                mpeConfigurationPending = true;
                 ofLogNotice() << "CommunicationManager: Connected to MIDI port: " 
                              << midiPortNames[portIndex];
             } else {
@@ -171,6 +236,7 @@ void CommunicationManager::connectMIDIPort(int portIndex) {
 }
 
 void CommunicationManager::disconnectMIDIPort(int portIndex) {
+    std::lock_guard<std::mutex> lock(midiMutex);
     if (portIndex >= 0 && portIndex < midiOuts.size()) {
         if (midiOuts[portIndex].isOpen()) {
             midiOuts[portIndex].closePort();
@@ -183,11 +249,14 @@ void CommunicationManager::disconnectMIDIPort(int portIndex) {
 
 void CommunicationManager::setMIDIPortSelected(int portIndex, bool selected) {
     if (portIndex >= 0 && portIndex < midiPortSelected.size()) {
-        midiPortSelected[portIndex] = selected;
+        {
+            std::lock_guard<std::mutex> lock(midiMutex);
+            midiPortSelected[portIndex] = selected;
+        }
         
         if (selected) {
             connectMIDIPort(portIndex);
-        } else {
+        } else if (!midiPortClock[portIndex]) {
             disconnectMIDIPort(portIndex);
         }
     }
@@ -208,6 +277,7 @@ void CommunicationManager::sendMIDINote(int note, int velocity, int channel) {
     noteEvent.timestamp = ofGetElapsedTimeMillis();
     noteEvent.duration = midiNoteDuration;
     noteEvent.noteOffSent = false;
+    noteEvent.voice = 0;
     
     activeMidiNotes.push_back(noteEvent);
 }
@@ -218,6 +288,19 @@ void CommunicationManager::sendMIDINoteOff(int note, int channel) {
     sendMIDINoteOffToAllPorts(note, channel);
 }
 
+// HARD_SNAP waits for the next subdivision, GRADUAL_TRANSITION for quantizeStrength of the way there
+static uint64_t getQuantizedTimeMicros(const TempoManager& tempoManager, const LineManager::MidiLine& line, uint64_t nowMicros) {
+    double nowSeconds = nowMicros / 1000000.0;
+    double gridSeconds = tempoManager.getNextSubdivisionTime(nowSeconds);
+    double delaySeconds = std::max(gridSeconds - nowSeconds, 0.0);
+    
+    if (line.quantizeMode == LineManager::MidiLine::GRADUAL_TRANSITION) {
+        delaySeconds *= ofClamp(line.quantizeStrength, 0.0f, 1.0f);
+    }
+    
+    return nowMicros + (uint64_t)(delaySeconds * 1000000.0 + 0.5);
+}
+
 void CommunicationManager::sendMIDILineCrossing(int lineId, const string& vehicleType, 
                                                float confidence, float speed) {
     if (!midiEnabled || !lineManager) return;
@@ -284,25 +367,68 @@ void CommunicationManager::sendMIDILineCrossing(int lineId, const string& vehicl
             noteIndex = line.scaleNoteIndex;
         }
         
+        // MTS mode: make sure the synth holds this scale's tuning before looking up the key
+        syncMIDITuning();
+        
         // Get microtonal note data using the properly calculated note index
-        microNote = scaleManager->getMicrotonalNote(currentScale, noteIndex, 
+        microNote = scaleManager->getMicrotonalNote(scaleManager->getScaleHandle(currentScale), noteIndex, 
                                                    rootNote, line.octave);
         // Microtonal note generated
         
-        // Use microtonal if pitch bend is needed (non-zero)
-        useMicrotonal = (microNote.pitchBend != 0);
+        // Use microtonal if pitch bend is needed (non-zero). MTS always plays the retuned
+        // key, which carries no bend once the synth holds the tuning.
+        useMicrotonal = scaleManager->getTuningMode() == ScaleManager::TUNING_MTS || microNote.pitchBend != 0;
     }
     
-    // Send appropriate MIDI note type
+    int channel = line.midiChannel;
+    int pitchBend = useMicrotonal ? microNote.pitchBend : 0;
     if (useMicrotonal) {
+        midiNote = microNote.midiNote;
+    }
+    
+    // MPE: the note gets a member channel of its own, so its bend cannot detune other notes
+    uint32_t voice = 0;
+    if (mpeEnabled) {
+        VoiceAllocator::Allocation allocation;
+        {
+            std::lock_guard<std::mutex> lock(voiceMutex);
+            allocation = voiceAllocator.noteOn(midiNote);
+        }
+        if (allocation.stolen) {
+            sendMIDINoteOff(allocation.stolenNote, allocation.channel);
+        }
+        channel = allocation.channel;
+        voice = allocation.voice;
+    }
+    
+    // Tempo-synced lines go to the scheduler, which sends on the beat grid
+    if (line.enableTempoSync && tempoManager && tempoManager->getIsRunning() && noteScheduler.isRunning()) {
+        uint64_t nowMicros = ofGetElapsedTimeMicros();
+        uint64_t emitMicros = getQuantizedTimeMicros(*tempoManager, line, nowMicros);
+        noteScheduler.scheduleNote(emitMicros, duration, channel, midiNote, velocity, pitchBend, voice);
+        midiActivityCounter = 60;
+        totalMidiEvents++;
+        
+        ofLogNotice() << "CommunicationManager: MIDI line crossing scheduled - Line:" << lineId 
+                     << " Note:" << midiNote << " Velocity:" << velocity << " Duration:" << duration
+                     << " Delay:" << (emitMicros - nowMicros) / 1000.0f << "ms";
+        return;
+    }
+    
+    // Send appropriate MIDI note type
+    if (voice != 0) {
+        // MPE voice - bend always goes out, the channel may hold the previous voice's bend
+        sendMIDIPitchBend(pitchBend, channel);
+        sendMIDINote(midiNote, velocity, channel);
+        activeMidiNotes.back().voice = voice;
+    } else if (useMicrotonal) {
         // Send microtonal note with pitch bend
         // Using microtonal path
-        sendMicrotonalNote(microNote.midiNote, microNote.pitchBend, velocity, line.midiChannel);
-        midiNote = microNote.midiNote; // Update for logging
+        sendMicrotonalNote(midiNote, pitchBend, velocity, channel);
     } else {
         // Send standard MIDI note
         // Using standard path
-        sendMIDINote(midiNote, velocity, line.midiChannel);
+        sendMIDINote(midiNote, velocity, channel);
     }
     
     // Update duration for this specific note
@@ -324,20 +450,90 @@ void CommunicationManager::sendTestMIDINote() {
     ofLogNotice() << "CommunicationManager: Test MIDI note sent";
 }
 
+void CommunicationManager::sendMIDIClockMessage(vector<unsigned char>& message) {
+    std::lock_guard<std::mutex> lock(midiMutex);
+    for (int i = 0; i < midiOuts.size(); i++) {
+        if (midiPortClock[i] && midiPortConnected[i]) {
+            midiOuts[i].sendMidiBytes(message);
+        }
+    }
+}
+
+void CommunicationManager::setMIDIPortClock(int portIndex, bool enabled) {
+    if (portIndex >= 0 && portIndex < midiPortClock.size()) {
+        {
+            std::lock_guard<std::mutex> lock(midiMutex);
+            midiPortClock[portIndex] = enabled;
+        }
+        
+        // Clock-only ports still need to be open
+        if (enabled) {
+            connectMIDIPort(portIndex);
+        } else if (!midiPortSelected[portIndex]) {
+            disconnectMIDIPort(portIndex);
+        }
+    }
+}
+
 void CommunicationManager::sendMIDINoteToAllPorts(int note, int velocity, int channel) {
+    std::lock_guard<std::mutex> lock(midiMutex);
     for (int i = 0; i < midiOuts.size(); i++) {
         if (midiPortSelected[i] && midiPortConnected[i]) {
             midiOuts[i].sendNoteOn(channel, note, velocity);
         }
     }
+    midiRecorder.recordChannelEvent(0x90 | ((channel - 1) & 0x0F), note, velocity);
 }
 
 void CommunicationManager::sendMIDINoteOffToAllPorts(int note, int channel) {
+    std::lock_guard<std::mutex> lock(midiMutex);
     for (int i = 0; i < midiOuts.size(); i++) {
         if (midiPortSelected[i] && midiPortConnected[i]) {
             midiOuts[i].sendNoteOff(channel, note, 0);
         }
     }
+    midiRecorder.recordChannelEvent(0x80 | ((channel - 1) & 0x0F), note, 0);
+}
+
+void CommunicationManager::sendMIDIPitchBendToAllPorts(int lsb, int msb, int channel) {
+    std::lock_guard<std::mutex> lock(midiMutex);
+    for (int i = 0; i < midiOuts.size(); i++) {
+        if (midiPortSelected[i] && midiPortConnected[i]) {
+            midiOuts[i].sendPitchBend(channel, lsb, msb);
+        }
+    }
+    midiRecorder.recordChannelEvent(0xE0 | ((channel - 1) & 0x0F), lsb, msb);
+}
+
+// Runs on the scheduler thread - only touches the ports
+void CommunicationManager::dispatchScheduledEvent(const NoteScheduler::Event& event) {
+    if (profiler && !schedulerThreadNamed) {
+        profiler->setThreadName("MIDI Scheduler");
+        schedulerThreadNamed = true;
+    }
+    FrameProfiler::Scope dispatchScope(profiler, FrameProfiler::STAGE_MIDI_DISPATCH);
+    
+    // MPE voices stolen before they sounded are dropped; a stolen voice's note-off went out at steal time
+    if (event.voice != 0) {
+        std::lock_guard<std::mutex> lock(voiceMutex);
+        bool current = event.type == NoteScheduler::NOTE_OFF ? voiceAllocator.noteOff(event.channel, event.voice)
+                                                              : voiceAllocator.isActive(event.channel, event.voice);
+        if (!current) return;
+    }
+    
+    switch (event.type) {
+        case NoteScheduler::PITCH_BEND: {
+            int pitchBendValue = ofClamp(event.value, -8192, 8191) + 8192;
+            sendMIDIPitchBendToAllPorts(pitchBendValue & 0x7F, (pitchBendValue >> 7) & 0x7F, event.channel);
+            break;
+        }
+        case NoteScheduler::NOTE_ON:
+            sendMIDINoteToAllPorts(event.note, event.value, event.channel);
+            break;
+        case NoteScheduler::NOTE_OFF:
+            sendMIDINoteOffToAllPorts(event.note, event.channel);
+            break;
+    }
 }
 
 void CommunicationManager::updateMIDIConnectionStatus() {
@@ -362,8 +558,17 @@ void CommunicationManager::processMIDINoteOffs() {
         MidiNoteEvent& noteEvent = activeMidiNotes[i];
         
         if (!noteEvent.noteOffSent && (currentTime - noteEvent.timestamp) >= noteEvent.duration) {
+            // A stolen MPE voice already had its note-off when the channel was taken
+            bool released = true;
+            if (noteEvent.voice != 0) {
+                std::lock_guard<std::mutex> lock(voiceMutex);
+                released = voiceAllocator.noteOff(noteEvent.channel, noteEvent.voice);
+            }
+            
             // Send note off
-            sendMIDINoteOff(noteEvent.note, noteEvent.channel);
+            if (released) {
+                sendMIDINoteOff(noteEvent.note, noteEvent.channel);
+            }
             noteEvent.noteOffSent = true;
             
             // Remove from active notes
@@ -405,6 +610,9 @@ void CommunicationManager::saveToJSON(ofxJSONElement& json) {
     // MIDI settings
     json["midiEnabled"] = midiEnabled;
     json["midiNoteDuration"] = midiNoteDuration;
+    json["mpeEnabled"] = mpeEnabled;
+    json["mpeFirstChannel"] = mpeFirstChannel;
+    json["mpeLastChannel"] = mpeLastChannel;
     
     // MIDI port selections
     ofxJSONElement portsJson;
@@ -414,6 +622,14 @@ void CommunicationManager::saveToJSON(ofxJSONElement& json) {
         }
     }
     json["selectedMidiPorts"] = portsJson;
+    
+    ofxJSONElement clockPortsJson;
+    for (int i = 0; i < midiPortNames.size(); i++) {
+        if (midiPortClock[i]) {
+            clockPortsJson[clockPortsJson.size()] = midiPortNames[i];
+        }
+    }
+    json["clockMidiPorts"] = clockPortsJson;
 }
 
 void CommunicationManager::loadFromJSON(const ofxJSONElement& json) {
@@ -436,6 +652,12 @@ void CommunicationManager::loadFromJSON(const ofxJSONElement& json) {
     if (json.isMember("midiNoteDuration")) {
         midiNoteDuration = json["midiNoteDuration"].asInt();
     }
+    if (json.isMember("mpeFirstChannel") && json.isMember("mpeLastChannel")) {
+        setMPEChannelRange(json["mpeFirstChannel"].asInt(), json["mpeLastChannel"].asInt());
+    }
+    if (json.isMember("mpeEnabled")) {
+        setMPEEnabled(json["mpeEnabled"].asBool());
+    }
     
     // MIDI port selections
     if (json.isMember("selectedMidiPorts")) {
@@ -460,6 +682,20 @@ void CommunicationManager::loadFromJSON(const ofxJSONElement& json) {
             }
         }
     }
+    
+    if (json.isMember("clockMidiPorts")) {
+        const ofxJSONElement& clockPortsJson = json["clockMidiPorts"];
+        for (int i = 0; i < clockPortsJson.size(); i++) {
+            string savedPortName = clockPortsJson[i].asString();
+            for (int j = 0; j < midiPortNames.size(); j++) {
+                if (midiPortNames[j] == savedPortName || 
+                    findClosestMidiPort(savedPortName) == midiPortNames[j]) {
+                    setMIDIPortClock(j, true);
+                    break;
+                }
+            }
+        }
+    }
 }
 
 void CommunicationManager::setDefaults() {
@@ -470,10 +706,13 @@ void CommunicationManager::setDefaults() {
     midiNoteDuration = 500;
     midiActivityCounter = 0;
     totalMidiEvents = 0;
+    setMPEEnabled(false);
+    setMPEChannelRange(2, 16);
     
     // Clear MIDI selections
     for (int i = 0; i < midiPortSelected.size(); i++) {
         midiPortSelected[i] = false;
+        setMIDIPortClock(i, false);
     }
     
     // Auto-select first port if available
@@ -500,11 +739,7 @@ void CommunicationManager::sendMIDIPitchBend(int pitchBend, int channel) {
     int msb = (pitchBendValue >> 7) & 0x7F;   // Upper 7 bits
     
     // Send pitch bend message to all connected ports
-    for (int i = 0; i < midiOuts.size(); i++) {
-        if (midiPortSelected[i] && midiPortConnected[i]) {
-            midiOuts[i].sendPitchBend(channel, lsb, msb);
-        }
-    }
+    sendMIDIPitchBendToAllPorts(lsb, msb, channel);
     
     midiActivityCounter = 30; // Show activity in UI
     totalMidiEvents++;
@@ -521,10 +756,14 @@ void CommunicationManager::sendMIDIControlChange(int controller, int value, int
     value = ofClamp(value, 0, 127);
     
     // Send CC message to all connected ports
-    for (int i = 0; i < midiOuts.size(); i++) {
-        if (midiPortSelected[i] && midiPortConnected[i]) {
-            midiOuts[i].sendControlChange(channel, controller, value);
+    {
+        std::lock_guard<std::mutex> lock(midiMutex);
+        for (int i = 0; i < midiOuts.size(); i++) {
+            if (midiPortSelected[i] && midiPortConnected[i]) {
+                midiOuts[i].sendControlChange(channel, controller, value);
+            }
         }
+        midiRecorder.recordChannelEvent(0xB0 | ((channel - 1) & 0x0F), controller, value);
     }
     
     midiActivityCounter = 30;
@@ -565,6 +804,148 @@ void CommunicationManager::sendMicrotonalNoteOff(int baseNote, int channel) {
                    << " Channel:" << channel << " (pitch bend reset)";
 }
 
+void CommunicationManager::sendMIDISysEx(vector<unsigned char>& message) {
+    if (!midiEnabled) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(midiMutex);
+        for (int i = 0; i < midiOuts.size(); i++) {
+            if (midiPortSelected[i] && midiPortConnected[i]) {
+                midiOuts[i].sendMidiBytes(message);
+            }
+        }
+        midiRecorder.recordSysEx(message);
+    }
+    
+    midiActivityCounter = 30;
+    totalMidiEvents++;
+}
+
+bool CommunicationManager::startMIDIRecording() {
+    string recordingDir = ofToDataPath("recordings");
+    if (!ofDirectory::doesDirectoryExist(recordingDir, false)) {
+        ofDirectory::createDirectory(recordingDir, false, true);
+    }
+    
+    string path = recordingDir + "/midi_" + ofGetTimestampString("%Y%m%d-%H%M%S") + ".mid";
+    float bpm = tempoManager ? tempoManager->getBPM() : 120.0f;
+    if (!midiRecorder.start(path, bpm)) return false;
+    
+    // The synth was retuned before recording began; open the file with the same tuning
+    if (scaleManager && scaleManager->getTuningMode() == ScaleManager::TUNING_MTS) {
+        for (const vector<unsigned char>& message : scaleManager->getTuningMessages()) {
+            midiRecorder.recordSysEx(message);
+        }
+    }
+    return true;
+}
+
+void CommunicationManager::stopMIDIRecording() {
+    midiRecorder.stop();
+}
+
+// Called by TempoManager on BPM changes so the file's tempo map follows the grid
+void CommunicationManager::recordMIDITempo(float bpm) {
+    midiRecorder.recordTempo(bpm);
+}
+
+// In MTS mode the master scale's key map is sent once per scale/root change; leaving MTS
+// mode sends plain 12-TET back so the synth does not stay retuned
+void CommunicationManager::syncMIDITuning() {
+    if (!scaleManager || !lineManager || !midiEnabled) return;
+    
+    ScaleManager::ScaleHandle handle = ScaleManager::INVALID_SCALE;
+    int rootNote = 0;
+    if (scaleManager->getTuningMode() == ScaleManager::TUNING_MTS && scaleManager->isMicrotonalityEnabled()) {
+        handle = scaleManager->getScaleHandle(lineManager->getMasterScale());
+        rootNote = lineManager->getMasterRootNote();
+    }
+    
+    if (!scaleManager->updateTuning(handle, rootNote)) return;
+    
+    vector<vector<unsigned char>> messages = scaleManager->getTuningMessages();
+    for (vector<unsigned char>& message : messages) {
+        sendMIDISysEx(message);
+    }
+    
+    // Pitch bend left over from per-note mode would detune every retuned key
+    for (int channel = 1; channel <= 16; channel++) {
+        resetPitchBend(channel);
+    }
+    
+    ofLogNotice() << "CommunicationManager: MTS tuning sent (" << messages.size() << " SysEx, "
+                  << scaleManager->getTunedKeyCount() << " keys retuned)";
+}
+
+// =============================================================================
+// MPE VOICE ALLOCATION
+// =============================================================================
+
+void CommunicationManager::setMPEEnabled(bool enabled) {
+    if (enabled == mpeEnabled) return;
+    
+    // Voices already sounding keep their channels and are released normally
+    mpeEnabled = enabled;
+    if (mpeEnabled) {
+        sendMPEConfiguration();
+    }
+    ofLogNotice() << "CommunicationManager: MPE " << (mpeEnabled ? "enabled" : "disabled")
+                  << " - member channels " << mpeFirstChannel << "-" << mpeLastChannel;
+}
+
+void CommunicationManager::setMPEChannelRange(int firstChannel, int lastChannel) {
+    // Channel 1 is the lower zone's master channel
+    firstChannel = ofClamp(firstChannel, 2, 16);
+    lastChannel = ofClamp(lastChannel, firstChannel, 16);
+    if (firstChannel == mpeFirstChannel && lastChannel == mpeLastChannel) return;
+    
+    // Reconfiguring forgets the sounding voices, so silence the old member channels first
+    for (int channel = mpeFirstChannel; channel <= mpeLastChannel; channel++) {
+        sendMIDIControlChange(123, 0, channel);  // All Notes Off
+    }
+    
+    mpeFirstChannel = firstChannel;
+    mpeLastChannel = lastChannel;
+    {
+        std::lock_guard<std::mutex> lock(voiceMutex);
+        voiceAllocator.configure(mpeFirstChannel, mpeLastChannel);
+    }
+    
+    if (mpeEnabled) {
+        sendMPEConfiguration();
+    }
+}
+
+void CommunicationManager::sendMPEConfiguration() {
+    // MPE Configuration Message: RPN 6 on the master channel, value = member channel count
+    sendMIDIControlChange(101, 0, 1);
+    sendMIDIControlChange(100, 6, 1);
+    sendMIDIControlChange(6, mpeLastChannel - 1, 1);
+    
+    // Pitch bend sensitivity (RPN 0) on every member channel - MPE defaults to 48 semitones
+    for (int channel = mpeFirstChannel; channel <= mpeLastChannel; channel++) {
+        sendMIDIControlChange(101, 0, channel);
+        sendMIDIControlChange(100, 0, channel);
+        sendMIDIControlChange(6, mpePitchBendRange, channel);
+        sendMIDIControlChange(38, 0, channel);
+        sendMIDIControlChange(101, 127, channel);  // RPN null
+        sendMIDIControlChange(100, 127, channel);
+    }
+    
+    ofLogNotice() << "CommunicationManager: MPE configuration sent - " << (mpeLastChannel - 1) 
+                  << " member channels, bend range " << mpePitchBendRange << " semitones";
+}
+
+int CommunicationManager::getMPEActiveVoices() {
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    return voiceAllocator.getActiveCount();
+}
+
+uint64_t CommunicationManager::getMPEStealCount() {
+    std::lock_guard<std::mutex> lock(voiceMutex);
+    return voiceAllocator.getStealCount();
+}
+
 void CommunicationManager::resetPitchBend(int channel) {
     if (!midiEnabled) return;
     
@@ -4,6 +4,10 @@
 #include "ofxOsc.h"
 #include "ofxMidi.h"
 #include "ofxJSON.h"
+#include "NoteScheduler.h"
+#include "VoiceAllocator.h"
+#include "MidiFileRecorder.h"
+#include "FrameProfiler.h"
 
 class CommunicationManager {
 public:
@@ -18,9 +22,11 @@ public:
     void setupOSC(const string& host, int port);
     void sendOSCLineCrossing(int lineId, int vehicleId, int vehicleType, 
                             const string& className, float confidence, float speed, 
-                            float speedMph, const ofPoint& crossingPoint);
+                            float speedMph, const ofPoint& crossingPoint,
+                            uint64_t captureMicros = 0);
     void sendOSCPoseCrossing(int lineId, int personId, const string& jointName, 
                             const ofPoint& crossingPoint, float confidence);
+    void sendOSCDetectionCadence(int frameSkip, float detectionHz, float inferenceMs, float latencyMs);
     
     // MIDI methods - EXACT COPY from working backup  
     void setupMIDI();
@@ -33,12 +39,30 @@ public:
     void sendMIDILineCrossing(int lineId, const string& vehicleType, float confidence, float speed);
     void sendTestMIDINote();
     
+    // MIDI clock and transport (from TempoManager's clock thread) - clock ports only
+    void sendMIDIClockMessage(vector<unsigned char>& message);
+    void setMIDIPortClock(int portIndex, bool enabled);
+    
     // Microtonal MIDI support
     void sendMIDIPitchBend(int pitchBend, int channel);
     void sendMIDIControlChange(int controller, int value, int channel);
     void sendMicrotonalNote(int baseNote, int pitchBend, int velocity, int channel);
     void sendMicrotonalNoteOff(int baseNote, int channel);
     void resetPitchBend(int channel);
+    void sendMIDISysEx(vector<unsigned char>& message);
+    
+    // MPE lower zone - each line-crossing note gets a member channel of its own
+    void setMPEEnabled(bool enabled);
+    bool isMPEEnabled() const { return mpeEnabled; }
+    void setMPEChannelRange(int firstChannel, int lastChannel);
+    void sendMPEConfiguration();
+    int getMPEActiveVoices();
+    uint64_t getMPEStealCount();
+    
+    // Standard MIDI File of everything sent to the ports (data/recordings)
+    bool startMIDIRecording();
+    void stopMIDIRecording();
+    void recordMIDITempo(float bpm);
     
     // Configuration methods
     void saveToJSON(ofxJSONElement& json);
@@ -48,11 +72,15 @@ public:
     // Manager connections
     void setManagers(class LineManager* lineMgr) { lineManager = lineMgr; }
     void setScaleManager(class ScaleManager* scaleMgr) { scaleManager = scaleMgr; }
+    void setTempoManager(class TempoManager* tempoMgr) { tempoManager = tempoMgr; }
+    // Set before setup() - the scheduler thread reads it
+    void setProfiler(FrameProfiler* frameProfiler) { profiler = frameProfiler; }
     
     // UI Manager methods for MIDI port selection
     vector<string> getMidiPortNames() const { return midiPortNames; }
     vector<bool> getMidiPortSelected() const { return midiPortSelected; }
     vector<bool> getMidiPortConnected() const { return midiPortConnected; }
+    vector<bool> getMidiPortClock() const { return midiPortClock; }
     
     // Live tracking data getters for UI Manager
     int getTotalMidiEvents() const { return totalMidiEvents; }
@@ -68,6 +96,7 @@ public:
     vector<string> midiPortNames;
     vector<bool> midiPortSelected;
     vector<bool> midiPortConnected;
+    vector<bool> midiPortClock;
     bool midiEnabled;
     bool anyMidiConnected;
     int midiNoteDuration;
@@ -81,16 +110,32 @@ public:
         unsigned long timestamp;
         int duration;
         bool noteOffSent;
+        uint32_t voice;        // MPE voice, 0 when the note is on the line's own channel
     };
     vector<MidiNoteEvent> activeMidiNotes;
     
     // MIDI tracking for UI
     int totalMidiEvents;
     
+    // Tempo-synced notes are sent from the scheduler thread
+    NoteScheduler noteScheduler;
+    
+    // Tees every note, pitch bend and CC sent to the ports
+    MidiFileRecorder midiRecorder;
+    
+    // MPE voice allocation (master channel 1, members mpeFirstChannel..mpeLastChannel)
+    bool mpeEnabled;
+    int mpeFirstChannel;
+    int mpeLastChannel;
+    int mpePitchBendRange;     // Semitones, matches the ±200 cents of ScaleManager::centsToPitchBend
+    
 private:
     // Helper methods
     void sendMIDINoteToAllPorts(int note, int velocity, int channel);
     void sendMIDINoteOffToAllPorts(int note, int channel);
+    void sendMIDIPitchBendToAllPorts(int lsb, int msb, int channel);
+    void dispatchScheduledEvent(const NoteScheduler::Event& event);
+    void syncMIDITuning();
     void updateMIDIConnectionStatus();
     void updateMIDITiming();
     void processMIDINoteOffs();
@@ -99,4 +144,15 @@ private:
     
     class LineManager* lineManager;
     class ScaleManager* scaleManager;
+    class TempoManager* tempoManager;
+    FrameProfiler* profiler;
+    bool schedulerThreadNamed;     // Scheduler thread only
+    
+    // Port list and ports are shared with the scheduler thread
+    std::mutex midiMutex;
+    
+    // Shared with the scheduler thread, which releases voices on note-off
+    VoiceAllocator voiceAllocator;
+    std::mutex voiceMutex;
+    bool mpeConfigurationPending;  // Resend zone setup after a port connects
 };
\ No newline at end of file
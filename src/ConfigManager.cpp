@@ -6,7 +6,43 @@
 #include "DetectionManager.h"
 #include "CommunicationManager.h"
 #include "ScaleManager.h"
+#include <fcntl.h>
+#include <unistd.h>
 
+namespace {
+    // config.json keys, in Section order
+    const char* SECTION_KEYS[ConfigManager::SECTION_COUNT] = {
+        "ui", "lines", "video", "detection", "communication", "tempo", "scales"
+    };
+    
+    // Run on the watcher thread before an edited config.json is published. Catches what
+    // would otherwise trip a manager's loadFromJSON halfway through applying it.
+    bool validateReload(const ofxJSONElement& json, string& error) {
+        if (!json.isObject()) {
+            error = "top level is not an object";
+            return false;
+        }
+        for (const char* key : SECTION_KEYS) {
+            if (json.isMember(key) && !json[key].isObject() && !json[key].isNull()) {
+                error = string("\"") + key + "\" is not an object";
+                return false;
+            }
+        }
+        const Json::Value& lines = json["lines"];
+        if (lines.isObject() && lines.isMember("lines") && !lines["lines"].isArray()) {
+            error = "\"lines.lines\" is not an array";
+            return false;
+        }
+        const Json::Value& detection = json["detection"];
+        for (const char* key : {"enabledClasses", "selectedClassIds", "categoryEnabled"}) {
+            if (detection.isObject() && detection.isMember(key) && !detection[key].isArray()) {
+                error = string("\"detection.") + key + "\" is not an array";
+                return false;
+            }
+        }
+        return true;
+    }
+}
 
 ConfigManager::ConfigManager() {
     uiManager = nullptr;
@@ -17,14 +53,37 @@ ConfigManager::ConfigManager() {
     
     configLoaded = false;
     configFilePath = "";
+    loadMs = 0.0f;
+    
+    autosaveEnabled = true;
+    autosaveSeconds = 30.0f;
+    debounceSeconds = 1.0f;
+    hotReloadEnabled = true;
+    dirtySections = 0;
+    lastDirtyTime = 0.0f;
+    lastAutosaveTime = 0.0f;
+    writePending = false;
+    cameraHintPending = false;
+    writing = false;
+    writerRunning = false;
+    stats = {0, 0, 0, 0.0f, 0.0f, 0.0f};
 }
 
 ConfigManager::~ConfigManager() {
+    stopWriter();
 }
 
 void ConfigManager::setup() {
     configFilePath = getConfigPath();
+    cameraHintPath = ofToDataPath("camera.hint");
     ensureConfigDirectory();
+    
+    // Read now so VideoManager can use it before the config is loaded
+    cameraHint.load(cameraHintPath);
+    
+    writerRunning = true;
+    writerThread = std::thread(&ConfigManager::writerThreadFunction, this);
+    watcher.start(configFilePath, validateReload);
     ofLogNotice() << "ConfigManager: Setup complete - " << configFilePath;
 }
 
@@ -41,67 +100,315 @@ void ConfigManager::setManagers(UIManager* uiMgr, LineManager* lineMgr,
     scaleManager = scaleMgr;
 }
 
+void ConfigManager::update() {
+    float now = ofGetElapsedTimef();
+    uint32_t sections = 0;
+    
+    // Wait for edits to settle, e.g. a slider drag, before serializing
+    if (dirtySections != 0 && now - lastDirtyTime >= debounceSeconds) {
+        sections = dirtySections;
+        dirtySections = 0;
+    }
+    
+    // Periodic sweep catches changes nobody marked; unchanged sections are not written
+    if (autosaveEnabled && now - lastAutosaveTime >= autosaveSeconds) {
+        sections |= ALL_SECTIONS;
+        lastAutosaveTime = now;
+    }
+    
+    if (sections != 0) {
+        persist(sections, false);
+    }
+}
+
+// Swap in a config.json edited outside the app. The watcher has already parsed and
+// validated it; only sections that differ from what is loaded are applied, so the camera
+// and detector are not touched unless their own settings changed.
+void ConfigManager::applyReload() {
+    if (!hotReloadEnabled || !watcher.hasReload()) return;
+    
+    ConfigWatcher::Document reloaded = watcher.takeReload();
+    if (!reloaded) return;
+    
+    int applied = 0;
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        if (!reloaded->isMember(SECTION_KEYS[i])) continue;
+        
+        const Json::Value& section = (*reloaded)[SECTION_KEYS[i]];
+        if (section == savedSections[i]) continue;
+        applySection((Section)i, ofxJSONElement(section));
+        savedSections[i] = section;
+        dirtySections &= ~sectionBit((Section)i);  // The file wins over unsaved GUI edits
+        applied++;
+    }
+    if (applied == 0) return;
+    
+    ofLogNotice() << "ConfigManager: Reloaded " << applied << " changed section(s) from " << configFilePath;
+}
+
+void ConfigManager::markDirty(uint32_t sections) {
+    dirtySections |= sections & ALL_SECTIONS;
+    lastDirtyTime = ofGetElapsedTimef();
+}
+
 void ConfigManager::saveConfig() {
     if (configFilePath.empty()) {
         ofLogNotice() << "ConfigManager: No config path set, cannot save";
         return;
     }
     
-    ofxJSONElement json;
-    
-    // Save all manager configurations
-    if (uiManager) {
-        ofxJSONElement uiJson;
-        // UI settings would be saved here
-        json["ui"] = uiJson;
+    dirtySections = 0;
+    persist(ALL_SECTIONS, true);
+}
+
+void ConfigManager::serializeSection(Section section, ofxJSONElement& json) {
+    switch (section) {
+        case SECTION_UI:
+            // UI settings would be saved here
+            break;
+        case SECTION_LINES:
+            if (lineManager) lineManager->saveToJSON(json);
+            break;
+        case SECTION_VIDEO:
+            if (videoManager) videoManager->saveToJSON(json);
+            break;
+        case SECTION_DETECTION:
+            if (detectionManager) detectionManager->saveToJSON(json);
+            break;
+        case SECTION_COMMUNICATION:
+            if (commManager) commManager->saveToJSON(json);
+            break;
+        case SECTION_TEMPO:
+            if (tempoManager) tempoManager->saveToJSON(json);
+            break;
+        case SECTION_SCALES:
+            if (scaleManager) scaleManager->saveToJSON(json);
+            break;
+        default:
+            break;
     }
+}
+
+void ConfigManager::applySection(Section section, const ofxJSONElement& json) {
+    switch (section) {
+        case SECTION_UI:
+            // UI settings would be loaded here
+            break;
+        case SECTION_LINES:
+            if (lineManager) lineManager->loadFromJSON(json);
+            break;
+        case SECTION_VIDEO:
+            if (videoManager) videoManager->loadFromJSON(json);
+            break;
+        case SECTION_DETECTION:
+            if (detectionManager) detectionManager->loadFromJSON(json);
+            break;
+        case SECTION_COMMUNICATION:
+            if (commManager) commManager->loadFromJSON(json);
+            break;
+        case SECTION_TEMPO:
+            if (tempoManager) tempoManager->loadFromJSON(json);
+            break;
+        case SECTION_SCALES:
+            if (scaleManager) scaleManager->loadFromJSON(json);
+            break;
+        default:
+            break;
+    }
+}
+
+// Serialize the requested sections on the calling (main) thread, then hand the whole
+// document to the writer. Untouched sections are reused from the last save.
+void ConfigManager::persist(uint32_t sections, bool force) {
+    if (configFilePath.empty()) return;
     
-    if (lineManager) {
-        ofxJSONElement lineJson;
-        lineManager->saveToJSON(lineJson);
-        json["lines"] = lineJson;
+    uint64_t startMicros = ofGetElapsedTimeMicros();
+    bool changed = force;
+    int unchanged = 0;
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        if (!(sections & sectionBit((Section)i))) continue;
+        
+        ofxJSONElement sectionJson;
+        serializeSection((Section)i, sectionJson);
+        if (sectionJson == savedSections[i]) {
+            unchanged++;
+            continue;
+        }
+        savedSections[i] = sectionJson;
+        changed = true;
     }
     
-    if (videoManager) {
-        ofxJSONElement videoJson;
-        videoManager->saveToJSON(videoJson);
-        json["video"] = videoJson;
+    ofxJSONElement document;
+    if (changed) {
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            document[SECTION_KEYS[i]] = savedSections[i];
+        }
+        document["version"] = "1.0";
+        document["timestamp"] = ofGetTimestampString();
     }
+    float serializeMs = (ofGetElapsedTimeMicros() - startMicros) / 1000.0f;
     
-    if (detectionManager) {
-        ofxJSONElement detectionJson;
-        detectionManager->saveToJSON(detectionJson);
-        json["detection"] = detectionJson;
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stats.unchangedSkips += unchanged;
+        stats.lastSerializeMs = serializeMs;
+    }
+    if (changed) {
+        queueWrite(document);
+    }
+    queueCameraHint();
+}
+
+// Hand a complete document to the writer
+void ConfigManager::queueWrite(ofxJSONElement& document) {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (writerRunning) {
+        // A newer document replaces one the writer has not picked up yet
+        pendingDocument.swap(document);
+        writePending = true;
+        writerCondition.notify_all();
+        return;
     }
     
-    if (commManager) {
-        ofxJSONElement commJson;
-        commManager->saveToJSON(commJson);
-        json["communication"] = commJson;
+    // Writer already stopped (after saveOnExit) - write here
+    lock.unlock();
+    bool ok = writeDocument(document);
+    lock.lock();
+    if (ok) {
+        stats.writes++;
+    } else {
+        stats.failures++;
     }
+}
+
+// The camera mode working now, so the next launch can open it without probing. Only
+// written when it differs from the last one, so saves do not pay for it.
+void ConfigManager::queueCameraHint() {
+    if (!videoManager || !videoManager->isCameraConnected()) return;
     
-    if (tempoManager) {
-        ofxJSONElement tempoJson;
-        tempoManager->saveToJSON(tempoJson);
-        json["tempo"] = tempoJson;
+    CameraHint hint;
+    hint.deviceId = videoManager->getCurrentCameraDevice();
+    hint.width = (int32_t)videoManager->camera.getWidth();
+    hint.height = (int32_t)videoManager->camera.getHeight();
+    if (!hint.isValid() || hint == cameraHint) return;
+    cameraHint = hint;
+    
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (writerRunning) {
+        pendingCameraHint = hint;
+        cameraHintPending = true;
+        writerCondition.notify_all();
+        return;
     }
+    lock.unlock();
+    writeAtomically(cameraHintPath, hint.encode());
+}
+
+void ConfigManager::writerThreadFunction() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerCondition.wait(lock, [this] { return writePending || cameraHintPending || !writerRunning; });
+        if (!writePending && !cameraHintPending) break;  // Stopped with nothing left to write
+        
+        bool writeConfig = writePending;
+        ofxJSONElement document;
+        document.swap(pendingDocument);
+        bool writeHint = cameraHintPending;
+        CameraHint hint = pendingCameraHint;
+        writePending = false;
+        cameraHintPending = false;
+        writing = true;
+        lock.unlock();
+        
+        // A lost hint only costs the next launch a camera probe
+        if (writeHint && !writeAtomically(cameraHintPath, hint.encode())) {
+            ofLogWarning() << "ConfigManager: Failed to write camera hint " << cameraHintPath;
+        }
+        uint64_t startMicros = ofGetElapsedTimeMicros();
+        bool ok = !writeConfig || writeDocument(document);
+        float writeMs = (ofGetElapsedTimeMicros() - startMicros) / 1000.0f;
+        
+        lock.lock();
+        writing = false;
+        if (writeConfig && ok) {
+            stats.writes++;
+            stats.lastWriteMs = writeMs;
+            stats.lastSaveTime = ofGetElapsedTimef();
+        } else if (writeConfig) {
+            stats.failures++;
+            ofLogError() << "ConfigManager: Failed to save configuration to " << configFilePath;
+        }
+        writerCondition.notify_all();
+    }
+}
+
+bool ConfigManager::writeDocument(const ofxJSONElement& document) {
+    string contents = document.getRawString(true);
+    watcher.ignoreContents(contents);  // Our own save is not an external edit
+    return writeAtomically(configFilePath, contents);
+}
+
+// Write to a temp file in the same directory, flush it to disk, then rename over the
+// config - a crash at any point leaves the previous config intact
+bool ConfigManager::writeAtomically(const string& path, const string& contents) {
+    string tempPath = path + ".tmp";
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
     
-    if (scaleManager) {
-        ofxJSONElement scaleJson;
-        scaleManager->saveToJSON(scaleJson);
-        json["scales"] = scaleJson;
+    const char* data = contents.data();
+    size_t remaining = contents.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            ::unlink(tempPath.c_str());
+            return false;
+        }
+        data += written;
+        remaining -= written;
     }
     
-    // Add metadata
-    json["version"] = "1.0";
-    json["timestamp"] = ofGetTimestampString();
+#ifdef __APPLE__
+    // fsync on macOS does not flush the drive's cache
+    bool synced = fcntl(fd, F_FULLFSYNC) == 0 || fsync(fd) == 0;
+#else
+    bool synced = fsync(fd) == 0;
+#endif
+    if (::close(fd) != 0 || !synced || ::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ::unlink(tempPath.c_str());
+        return false;
+    }
     
-    // Save to file
-    if (json.save(configFilePath, true)) {
-        ofLogNotice() << "ConfigManager: Configuration saved successfully";
-    } else {
-        ofLogNotice() << "ConfigManager: Failed to save configuration";
+    // Make the rename itself durable
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "." : path.substr(0, slash + 1);
+    int directoryFd = ::open(directory.c_str(), O_RDONLY);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        ::close(directoryFd);
+    }
+    return true;
+}
+
+void ConfigManager::stopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (!writerRunning) return;
+        writerRunning = false;
     }
+    writerCondition.notify_all();
+    writerThread.join();  // Finishes a pending write first
+}
+
+ConfigManager::PersistStats ConfigManager::getPersistStats() const {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    return stats;
+}
+
+bool ConfigManager::getCameraHint(CameraHint& hint) const {
+    hint = cameraHint;
+    return hint.isValid();
 }
 
 void ConfigManager::loadConfig() {
@@ -111,6 +418,7 @@ void ConfigManager::loadConfig() {
         return;
     }
     
+    uint64_t startMicros = ofGetElapsedTimeMicros();
     ofxJSONElement json;
     if (!json.open(configFilePath)) {
         ofLogNotice() << "ConfigManager: Config file not found, creating defaults";
@@ -126,36 +434,21 @@ void ConfigManager::loadConfig() {
     }
     
     // Load all manager configurations
-    if (uiManager && json.isMember("ui")) {
-        // UI settings would be loaded here
-    }
-    
-    if (lineManager && json.isMember("lines")) {
-        lineManager->loadFromJSON(json["lines"]);
-    }
-    
-    if (videoManager && json.isMember("video")) {
-        videoManager->loadFromJSON(json["video"]);
-    }
-    
-    if (detectionManager && json.isMember("detection")) {
-        detectionManager->loadFromJSON(json["detection"]);
-    }
-    
-    if (commManager && json.isMember("communication")) {
-        commManager->loadFromJSON(json["communication"]);
-    }
-    
-    if (tempoManager && json.isMember("tempo")) {
-        tempoManager->loadFromJSON(json["tempo"]);
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        if (json.isMember(SECTION_KEYS[i])) {
+            applySection((Section)i, json[SECTION_KEYS[i]]);
+        }
     }
     
-    if (scaleManager && json.isMember("scales")) {
-        scaleManager->loadFromJSON(json["scales"]);
+    // What is on disk now - later saves only write sections that differ from it
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        savedSections[i] = json.isMember(SECTION_KEYS[i]) ? json[SECTION_KEYS[i]] : Json::Value();
     }
+    dirtySections = 0;
     
     configLoaded = true;
-    ofLogNotice() << "ConfigManager: Configuration loaded successfully";
+    loadMs = (ofGetElapsedTimeMicros() - startMicros) / 1000.0f;
+    ofLogNotice() << "ConfigManager: Configuration loaded in " << loadMs << " ms";
 }
 
 void ConfigManager::setDefaultConfig() {
@@ -196,12 +489,15 @@ string ConfigManager::getConfigPath() const {
 }
 
 void ConfigManager::saveOnExit() {
+    watcher.stop();
     saveConfig();
+    stopWriter();
     ofLogNotice() << "ConfigManager: Configuration saved on exit";
 }
 
 void ConfigManager::resetToDefaults() {
     setDefaultConfig();
+    markDirty(ALL_SECTIONS);
     ofLogNotice() << "ConfigManager: Reset to defaults";
 }
 
@@ -2,19 +2,61 @@
 
 #include "ofMain.h"
 #include "ofxJSON.h"
+#include "CameraHint.h"
+#include "ConfigWatcher.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
+// Config persistence. Each manager's settings are one section of config.json; callers
+// mark sections dirty when something may have changed, and update() re-serializes only
+// those once edits have been quiet for debounceSeconds (or every autosaveSeconds for all
+// sections). Sections that serialize to the same JSON as last time are not written.
+// Formatting and writing happen on a writer thread: temp file, fsync, rename, so the
+// config on disk is always either the old or the new version, never a partial one.
+// The writer also keeps camera.hint (see CameraHint) up to date when the working camera
+// mode changes. Edits made to config.json while the app runs are picked up by a
+// ConfigWatcher and swapped in by applyReload().
 class ConfigManager {
 public:
+    enum Section {
+        SECTION_UI,
+        SECTION_LINES,
+        SECTION_VIDEO,
+        SECTION_DETECTION,
+        SECTION_COMMUNICATION,
+        SECTION_TEMPO,
+        SECTION_SCALES,
+        SECTION_COUNT
+    };
+    static const uint32_t ALL_SECTIONS = (1u << SECTION_COUNT) - 1;
+    static uint32_t sectionBit(Section section) { return 1u << section; }
+    
+    struct PersistStats {
+        int writes;
+        int unchangedSkips;        // Dirty sections that turned out identical
+        int failures;
+        float lastSerializeMs;     // Main thread
+        float lastWriteMs;         // Writer thread
+        float lastSaveTime;        // ofGetElapsedTimef of the last completed write
+    };
+    
     ConfigManager();
     ~ConfigManager();
     
     void setup();
     void update();
     void draw();
+    void applyReload();                     // Call at a frame boundary, before other updates
     
     void loadConfig();
-    void saveConfig();
-    void saveOnExit();
+    void saveConfig();                      // Every section, written in the background
+    void saveOnExit();                      // Every section, waits for the write
+    void markDirty(uint32_t sections);      // Mask of sectionBit()s
+    PersistStats getPersistStats() const;
+    float getLoadMs() const { return loadMs; }
+    bool getCameraHint(CameraHint& hint) const;    // Valid after setup()
+    ConfigWatcher::Stats getReloadStats() const { return watcher.getStats(); }
     void resetToDefaults(); // Public method to reset all settings to defaults
     
     // Manager connections
@@ -23,10 +65,18 @@ public:
                      class CommunicationManager* commMgr, class TempoManager* tempoMgr,
                      class ScaleManager* scaleMgr);
     
+    bool autosaveEnabled;
+    float autosaveSeconds;
+    float debounceSeconds;
+    bool hotReloadEnabled;                  // Off: external edits wait until turned back on
+    
 private:
     string configPath;
     string configFilePath;
+    string cameraHintPath;
     bool configLoaded;
+    float loadMs;
+    CameraHint cameraHint;                          // Read in setup(), then the last one queued
     
     // Helper methods
     string getConfigPath() const;
@@ -34,6 +84,36 @@ private:
     bool validateConfigFile(const ofxJSONElement& json);
     void setDefaultConfig();
     
+    // Persistence
+    void serializeSection(Section section, ofxJSONElement& json);
+    void applySection(Section section, const ofxJSONElement& json);
+    void persist(uint32_t sections, bool force);
+    void queueWrite(ofxJSONElement& document);
+    void queueCameraHint();
+    void writerThreadFunction();
+    bool writeDocument(const ofxJSONElement& document);
+    bool writeAtomically(const string& path, const string& contents);
+    void stopWriter();
+    
+    // Main thread only
+    ofxJSONElement savedSections[SECTION_COUNT];   // As last handed to the writer
+    uint32_t dirtySections;
+    float lastDirtyTime;
+    float lastAutosaveTime;
+    
+    std::thread writerThread;
+    mutable std::mutex writerMutex;
+    std::condition_variable writerCondition;
+    ofxJSONElement pendingDocument;
+    CameraHint pendingCameraHint;
+    bool writePending;
+    bool cameraHintPending;
+    bool writing;
+    bool writerRunning;
+    PersistStats stats;
+    
+    ConfigWatcher watcher;
+    
     // Manager references
     class UIManager* uiManager;
     class LineManager* lineManager;
@@ -0,0 +1,292 @@
+#include "ConfigWatcher.h"
+#include "ScalaIndex.h"
+#include <fcntl.h>
+#include <fstream>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#elif defined(__APPLE__)
+#include <sys/event.h>
+#endif
+
+static bool readFile(const string& path, string& contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static int64_t modificationTime(const string& path) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) return -1;
+#ifdef __APPLE__
+    return (int64_t)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    return (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+}
+
+ConfigWatcher::ConfigWatcher() {
+    settleMs = 150;
+    pollMs = 500;
+    running = false;
+    wakeFds[0] = wakeFds[1] = -1;
+    watchFd = -1;
+    directoryFd = -1;
+    fileFd = -1;
+    polledMtime = -1;
+    knownChecksum = 0;
+    reloadReady = false;
+    stats = {0, 0, "", 0.0f};
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+bool ConfigWatcher::start(const string& watchPath, Validator documentValidator) {
+    if (running) return true;
+
+    path = watchPath;
+    validator = documentValidator;
+    size_t slash = path.find_last_of('/');
+    directory = slash == string::npos ? "." : path.substr(0, slash + 1);
+    filename = slash == string::npos ? path : path.substr(slash + 1);
+
+    // What is on disk now was loaded at startup - only later changes are reloads
+    string contents;
+    readFile(path, contents);
+    knownChecksum = ScalaIndex::checksum(contents.data(), contents.size());
+    polledMtime = modificationTime(path);
+
+    if (pipe(wakeFds) != 0) {
+        ofLogError() << "ConfigWatcher: Could not create wake pipe";
+        return false;
+    }
+    bool watching = openWatch();
+
+    running = true;
+    thread = std::thread(&ConfigWatcher::threadedFunction, this);
+    ofLogNotice() << "ConfigWatcher: Watching " << path
+                  << (watching ? "" : " (polling every " + ofToString(pollMs) + " ms)");
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!running) return;
+
+    running = false;
+    char wake = 1;
+    ssize_t written = write(wakeFds[1], &wake, 1);  // Interrupts the wait
+    (void)written;
+    thread.join();
+
+    closeWatch();
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+    wakeFds[0] = wakeFds[1] = -1;
+    ofLogNotice() << "ConfigWatcher: Stopped";
+}
+
+void ConfigWatcher::ignoreContents(const string& contents) {
+    std::lock_guard<std::mutex> lock(mutex);
+    knownChecksum = ScalaIndex::checksum(contents.data(), contents.size());
+}
+
+ConfigWatcher::Document ConfigWatcher::takeReload() {
+    if (!reloadReady.load(std::memory_order_acquire)) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    reloadReady = false;
+    return std::move(pending);
+}
+
+ConfigWatcher::Stats ConfigWatcher::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void ConfigWatcher::threadedFunction() {
+    while (running) {
+        if (!waitForEvent(watchFd >= 0 ? -1 : pollMs)) continue;
+
+        // Editors often write in several steps; read once they have gone quiet
+        while (running && waitForEvent(settleMs)) {
+        }
+        if (running) {
+            readAndPublish();
+        }
+    }
+}
+
+void ConfigWatcher::readAndPublish() {
+    string contents;
+    if (!readFile(path, contents)) return;  // Mid-rename; the next event retries
+
+    uint64_t checksum = ScalaIndex::checksum(contents.data(), contents.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (checksum == knownChecksum) return;
+        knownChecksum = checksum;
+    }
+
+    std::shared_ptr<ofxJSONElement> json = std::make_shared<ofxJSONElement>();
+    string error;
+    if (!json->parse(contents)) {
+        error = "not valid JSON";
+    } else if (validator && !validator(*json, error) && error.empty()) {
+        error = "rejected by validator";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error.empty()) {
+        stats.rejected++;
+        stats.lastError = error;
+        ofLogWarning() << "ConfigWatcher: Ignoring change to " << filename << ": " << error;
+        return;
+    }
+    pending = json;
+    stats.reloads++;
+    stats.lastReloadTime = ofGetElapsedTimef();
+    reloadReady.store(true, std::memory_order_release);
+}
+
+// Fallback when no change notification is available
+bool ConfigWatcher::pollForChange(int timeoutMs) {
+    struct pollfd wake = {wakeFds[0], POLLIN, 0};
+    if (poll(&wake, 1, timeoutMs) != 0) return false;
+
+    int64_t mtime = modificationTime(path);
+    bool changed = mtime != polledMtime;
+    polledMtime = mtime;
+    return changed;
+}
+
+#if defined(__linux__)
+
+bool ConfigWatcher::openWatch() {
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) return false;
+
+    // Rename-over saves arrive as IN_MOVED_TO, in-place saves as IN_MODIFY/IN_CLOSE_WRITE
+    if (inotify_add_watch(watchFd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        closeWatch();
+        return false;
+    }
+    return true;
+}
+
+void ConfigWatcher::closeWatch() {
+    if (watchFd >= 0) {
+        ::close(watchFd);
+        watchFd = -1;
+    }
+}
+
+bool ConfigWatcher::waitForEvent(int timeoutMs) {
+    if (watchFd < 0) return pollForChange(timeoutMs);
+
+    struct pollfd fds[2] = {{watchFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+    if (poll(fds, 2, timeoutMs) <= 0 || (fds[1].revents & POLLIN)) return false;
+
+    alignas(struct inotify_event) char buffer[4096];
+    bool relevant = false;
+    ssize_t length;
+    while ((length = read(watchFd, buffer, sizeof(buffer))) > 0) {
+        for (char* cursor = buffer; cursor < buffer + length; ) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(cursor);
+            if (event->len > 0 && filename == event->name) {
+                relevant = true;
+            }
+            cursor += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return relevant;
+}
+
+#elif defined(__APPLE__)
+
+bool ConfigWatcher::openWatch() {
+    watchFd = kqueue();
+    directoryFd = ::open(directory.c_str(), O_EVTONLY);
+    if (watchFd < 0 || directoryFd < 0) {
+        closeWatch();
+        return false;
+    }
+
+    // The directory changes when a file is renamed over the config; the file itself
+    // changes on in-place saves. The wake pipe is in the same queue.
+    struct kevent changes[2];
+    EV_SET(&changes[0], directoryFd, EVFILT_VNODE, EV_ADD | EV_CLEAR, NOTE_WRITE, 0, nullptr);
+    EV_SET(&changes[1], wakeFds[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+    if (kevent(watchFd, changes, 2, nullptr, 0, nullptr) < 0) {
+        closeWatch();
+        return false;
+    }
+    fileFd = ::open(path.c_str(), O_EVTONLY);
+    if (fileFd >= 0) {
+        EV_SET(&changes[0], fileFd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+               NOTE_WRITE | NOTE_EXTEND | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+        kevent(watchFd, changes, 1, nullptr, 0, nullptr);
+    }
+    return true;
+}
+
+void ConfigWatcher::closeWatch() {
+    if (fileFd >= 0) {
+        ::close(fileFd);
+        fileFd = -1;
+    }
+    if (directoryFd >= 0) {
+        ::close(directoryFd);
+        directoryFd = -1;
+    }
+    if (watchFd >= 0) {
+        ::close(watchFd);
+        watchFd = -1;
+    }
+}
+
+bool ConfigWatcher::waitForEvent(int timeoutMs) {
+    if (watchFd < 0) return pollForChange(timeoutMs);
+
+    struct timespec timeout = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    struct kevent events[4];
+    int count = kevent(watchFd, nullptr, 0, events, 4, timeoutMs < 0 ? nullptr : &timeout);
+    if (count <= 0) return false;
+
+    for (int i = 0; i < count; i++) {
+        if ((int)events[i].ident == wakeFds[0]) return false;
+    }
+
+    // Directory events cannot be filtered by name, and the config may be a new file
+    // now - re-arm on the current one. Unchanged contents are dropped by checksum.
+    if (fileFd >= 0) {
+        ::close(fileFd);
+    }
+    fileFd = ::open(path.c_str(), O_EVTONLY);
+    if (fileFd >= 0) {
+        struct kevent change;
+        EV_SET(&change, fileFd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+               NOTE_WRITE | NOTE_EXTEND | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+        kevent(watchFd, &change, 1, nullptr, 0, nullptr);
+    }
+    return true;
+}
+
+#else
+
+bool ConfigWatcher::openWatch() {
+    return false;
+}
+
+void ConfigWatcher::closeWatch() {
+}
+
+bool ConfigWatcher::waitForEvent(int timeoutMs) {
+    return pollForChange(timeoutMs);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxJSON.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Watches one config file for changes made outside the app (inotify on Linux, kqueue on
+// macOS, mtime polling elsewhere). A watcher thread waits for writes to settle, reads and
+// parses the file, runs the validator and publishes the result as an immutable document.
+// The frame loop picks it up with takeReload(), which never waits on parsing - the lock
+// only guards swapping the pointer.
+//
+// The directory is watched rather than the file, so editors that save by renaming a new
+// file over the old one are seen too. Contents the app wrote itself (ignoreContents) and
+// saves that change nothing are not published.
+class ConfigWatcher {
+public:
+    typedef std::shared_ptr<const ofxJSONElement> Document;
+    typedef std::function<bool(const ofxJSONElement& json, string& error)> Validator;
+
+    struct Stats {
+        int reloads;           // Documents published
+        int rejected;          // Parse or validation failures
+        string lastError;
+        float lastReloadTime;  // ofGetElapsedTimef of the last publish
+    };
+
+    ConfigWatcher();
+    ~ConfigWatcher();
+
+    bool start(const string& path, Validator validator);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Called before the app writes the file so its own save is not reloaded
+    void ignoreContents(const string& contents);
+
+    // Latest published document, or null. Each document is returned once.
+    Document takeReload();
+    bool hasReload() const { return reloadReady.load(std::memory_order_acquire); }
+
+    Stats getStats() const;
+
+    int settleMs;              // Quiet time after the last event before reading
+    int pollMs;                // Fallback polling interval
+
+private:
+    void threadedFunction();
+    bool waitForEvent(int timeoutMs);     // True if the file may have changed
+    bool pollForChange(int timeoutMs);
+    void readAndPublish();
+    bool openWatch();
+    void closeWatch();
+
+    string path;
+    string directory;
+    string filename;
+    Validator validator;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    int wakeFds[2];            // Pipe that interrupts the wait on stop()
+    int watchFd;               // inotify instance or kqueue
+    int directoryFd;           // kqueue only
+    int fileFd;                // kqueue only
+    int64_t polledMtime;       // Polling fallback
+
+    mutable std::mutex mutex;
+    uint64_t knownChecksum;    // Contents last loaded or written by the app
+    Document pending;
+    std::atomic<bool> reloadReady;
+    Stats stats;
+};
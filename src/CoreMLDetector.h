@@ -15,6 +15,7 @@
 @property (nonatomic, assign) float confidence;
 @property (nonatomic, assign) int classId;
 @property (nonatomic, strong) NSString* className;
+@property (nonatomic, assign) int regionIndex;      // Tiled inference: the region that produced the box, -1 otherwise
 @end
 
 @interface CoreMLDetector : NSObject
@@ -27,4 +28,15 @@
                      channels:(int)channels
                    completion:(void(^)(NSArray<CoreMLDetection*>* detections))completion;
 
+// Tiled inference - each region (x, y, width, height in source pixels, 4 floats per region)
+// is letterboxed to the model input and all regions run as one batch.
+// Detections are returned in source pixel coordinates.
+- (void)detectObjectsInPixels:(unsigned char*)pixelData 
+                        width:(int)width 
+                       height:(int)height 
+                     channels:(int)channels
+                      regions:(const float*)regions
+                  regionCount:(int)regionCount
+                   completion:(void(^)(NSArray<CoreMLDetection*>* detections))completion;
+
 @end
\ No newline at end of file
@@ -13,6 +13,58 @@
 @property (nonatomic, strong) NSArray* classNames;
 @end
 
+// Nearest-neighbour sample of a source region into a letterboxed modelSize x modelSize BGRA buffer
+static void fillLetterboxedBGRA(const unsigned char* pixelData, int width, int height, int channels,
+                                int regionX, int regionY, int regionWidth, int regionHeight,
+                                unsigned char* bgraData, int modelSize,
+                                float* outScale, int* outOffsetX, int* outOffsetY) {
+    float scale = MIN((float)modelSize / regionWidth, (float)modelSize / regionHeight);
+    int scaledWidth = MIN(modelSize, (int)(regionWidth * scale));
+    int scaledHeight = MIN(modelSize, (int)(regionHeight * scale));
+    int offsetX = (modelSize - scaledWidth) / 2;
+    int offsetY = (modelSize - scaledHeight) / 2;
+    
+    // Gray letterbox background
+    memset(bgraData, 128, (size_t)modelSize * modelSize * 4);
+    for (int i = 3; i < modelSize * modelSize * 4; i += 4) {
+        bgraData[i] = 255;
+    }
+    
+    // Source column offsets are the same for every row
+    int* srcColumns = (int*)malloc(sizeof(int) * scaledWidth);
+    for (int dstX = 0; dstX < scaledWidth; dstX++) {
+        int srcX = MIN(regionX + (int)(dstX / scale), width - 1);
+        srcColumns[dstX] = srcX * channels;
+    }
+    
+    for (int dstY = 0; dstY < scaledHeight; dstY++) {
+        int srcY = MIN(regionY + (int)(dstY / scale), height - 1);
+        const unsigned char* srcRow = pixelData + (size_t)srcY * width * channels;
+        unsigned char* dstRow = bgraData + ((size_t)(dstY + offsetY) * modelSize + offsetX) * 4;
+        
+        if (channels >= 3) {
+            for (int dstX = 0; dstX < scaledWidth; dstX++) {
+                const unsigned char* src = srcRow + srcColumns[dstX];
+                dstRow[dstX * 4 + 0] = src[2]; // B
+                dstRow[dstX * 4 + 1] = src[1]; // G
+                dstRow[dstX * 4 + 2] = src[0]; // R
+            }
+        } else {
+            for (int dstX = 0; dstX < scaledWidth; dstX++) {
+                unsigned char gray = srcRow[srcColumns[dstX]];
+                dstRow[dstX * 4 + 0] = gray;
+                dstRow[dstX * 4 + 1] = gray;
+                dstRow[dstX * 4 + 2] = gray;
+            }
+        }
+    }
+    free(srcColumns);
+    
+    *outScale = scale;
+    *outOffsetX = offsetX;
+    *outOffsetY = offsetY;
+}
+
 @implementation CoreMLDetector
 
 - (instancetype)init {
@@ -222,6 +274,188 @@
     }
 }
 
+- (void)detectObjectsInPixels:(unsigned char*)pixelData 
+                        width:(int)width 
+                       height:(int)height 
+                     channels:(int)channels
+                      regions:(const float*)regions
+                  regionCount:(int)regionCount
+                   completion:(void(^)(NSArray<CoreMLDetection*>* detections))completion {
+    
+    if (!self.coremlModel || regionCount <= 0) {
+        completion(@[]);
+        return;
+    }
+    
+    const int modelSize = 640;
+    const size_t tileBytes = (size_t)modelSize * modelSize * 4;
+    
+    unsigned char* tileData = (unsigned char*)malloc(tileBytes * regionCount);
+    float* tileScales = (float*)calloc(regionCount, sizeof(float));
+    int* tileOffsetsX = (int*)calloc(regionCount, sizeof(int));
+    int* tileOffsetsY = (int*)calloc(regionCount, sizeof(int));
+    CVPixelBufferRef* pixelBuffers = (CVPixelBufferRef*)calloc(regionCount, sizeof(CVPixelBufferRef));
+    
+    if (!tileData || !tileScales || !tileOffsetsX || !tileOffsetsY || !pixelBuffers) {
+        NSLog(@"Failed to allocate tile buffers");
+        free(tileData); free(tileScales); free(tileOffsetsX); free(tileOffsetsY); free(pixelBuffers);
+        completion(@[]);
+        return;
+    }
+    
+    NSMutableArray<CoreMLDetection*>* detections = [NSMutableArray new];
+    
+    @try {
+        // Letterbox every tile in parallel
+        dispatch_apply(regionCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+            fillLetterboxedBGRA(pixelData, width, height, channels,
+                                (int)regions[i * 4 + 0], (int)regions[i * 4 + 1],
+                                (int)regions[i * 4 + 2], (int)regions[i * 4 + 3],
+                                tileData + i * tileBytes, modelSize,
+                                &tileScales[i], &tileOffsetsX[i], &tileOffsetsY[i]);
+        });
+        
+        MLFeatureValue* confThresholdValue = [MLFeatureValue featureValueWithDouble:0.15];
+        MLFeatureValue* iouThreshold = [MLFeatureValue featureValueWithDouble:0.7];
+        NSMutableArray<id<MLFeatureProvider>>* inputs = [NSMutableArray arrayWithCapacity:regionCount];
+        
+        for (int i = 0; i < regionCount; i++) {
+            CVReturn result = CVPixelBufferCreateWithBytes(NULL,
+                                                          modelSize, modelSize,
+                                                          kCVPixelFormatType_32BGRA,
+                                                          tileData + i * tileBytes,
+                                                          modelSize * 4,
+                                                          NULL, NULL, NULL,
+                                                          &pixelBuffers[i]);
+            if (result != kCVReturnSuccess) {
+                NSLog(@"Failed to create CVPixelBuffer for tile %d: %d", i, result);
+                break;
+            }
+            
+            NSError* inputError = nil;
+            MLDictionaryFeatureProvider* input = [[MLDictionaryFeatureProvider alloc]
+                                                initWithDictionary:@{@"image": [MLFeatureValue featureValueWithPixelBuffer:pixelBuffers[i]],
+                                                                   @"confidenceThreshold": confThresholdValue,
+                                                                   @"iouThreshold": iouThreshold}
+                                                error:&inputError];
+            if (inputError) {
+                NSLog(@"Failed to create input features for tile %d: %@", i, inputError.localizedDescription);
+                break;
+            }
+            [inputs addObject:input];
+        }
+        
+        if (inputs.count == (NSUInteger)regionCount) {
+            // One batched prediction for all tiles
+            NSError* error = nil;
+            MLArrayBatchProvider* batch = [[MLArrayBatchProvider alloc] initWithFeatureProviderArray:inputs];
+            id<MLBatchProvider> outputs = [self.coremlModel predictionsFromBatch:batch error:&error];
+            
+            if (error || !outputs) {
+                NSLog(@"CoreML batch prediction error: %@", error.localizedDescription);
+            } else {
+                for (NSInteger i = 0; i < outputs.count; i++) {
+                    [self appendYOLOOutput:[outputs featuresAtIndex:i]
+                                   toArray:detections
+                               regionIndex:(int)i
+                                   regionX:regions[i * 4 + 0]
+                                   regionY:regions[i * 4 + 1]
+                               regionWidth:regions[i * 4 + 2]
+                              regionHeight:regions[i * 4 + 3]
+                            letterboxScale:tileScales[i]
+                          letterboxOffsetX:tileOffsetsX[i]
+                          letterboxOffsetY:tileOffsetsY[i]];
+                }
+            }
+        }
+    } @catch (NSException* exception) {
+        NSLog(@"CoreML tiled detection exception: %@", exception.reason);
+        [detections removeAllObjects];
+    }
+    
+    for (int i = 0; i < regionCount; i++) {
+        if (pixelBuffers[i]) {
+            CVPixelBufferRelease(pixelBuffers[i]);
+        }
+    }
+    free(pixelBuffers);
+    free(tileData);
+    free(tileScales);
+    free(tileOffsetsX);
+    free(tileOffsetsY);
+    
+    completion(detections);
+}
+
+// Parse one tile's output and map boxes back to source pixel coordinates
+- (void)appendYOLOOutput:(id<MLFeatureProvider>)output
+                 toArray:(NSMutableArray<CoreMLDetection*>*)detections
+             regionIndex:(int)regionIndex
+                 regionX:(float)regionX
+                 regionY:(float)regionY
+             regionWidth:(float)regionWidth
+            regionHeight:(float)regionHeight
+          letterboxScale:(float)letterboxScale
+        letterboxOffsetX:(int)letterboxOffsetX
+        letterboxOffsetY:(int)letterboxOffsetY {
+    
+    MLFeatureValue* coordinatesFeature = [output featureValueForName:@"coordinates"];
+    MLFeatureValue* confidenceFeature = [output featureValueForName:@"confidence"];
+    
+    if (!coordinatesFeature || !confidenceFeature || 
+        coordinatesFeature.type != MLFeatureTypeMultiArray ||
+        confidenceFeature.type != MLFeatureTypeMultiArray) {
+        NSLog(@"Invalid YOLO output format");
+        return;
+    }
+    
+    MLMultiArray* coordinatesArray = coordinatesFeature.multiArrayValue;
+    MLMultiArray* confidenceArray = confidenceFeature.multiArrayValue;
+    int numDetections = [coordinatesArray.shape[0] intValue];
+    
+    for (int i = 0; i < numDetections; i++) {
+        float maxConfidence = 0.0f;
+        int bestClassId = -1;
+        for (int c = 0; c < 80; c++) {
+            float confidence = [confidenceArray[i * 80 + c] floatValue];
+            if (confidence > maxConfidence) {
+                maxConfidence = confidence;
+                bestClassId = c;
+            }
+        }
+        if (maxConfidence <= 0.15f) continue;
+        
+        // Normalized center format -> model pixels -> region pixels -> source pixels
+        float modelCenterX = [coordinatesArray[i * 4 + 0] floatValue] * 640.0f;
+        float modelCenterY = [coordinatesArray[i * 4 + 1] floatValue] * 640.0f;
+        float modelWidth = [coordinatesArray[i * 4 + 2] floatValue] * 640.0f;
+        float modelHeight = [coordinatesArray[i * 4 + 3] floatValue] * 640.0f;
+        
+        float x1 = (modelCenterX - modelWidth / 2.0f - letterboxOffsetX) / letterboxScale;
+        float y1 = (modelCenterY - modelHeight / 2.0f - letterboxOffsetY) / letterboxScale;
+        float x2 = (modelCenterX + modelWidth / 2.0f - letterboxOffsetX) / letterboxScale;
+        float y2 = (modelCenterY + modelHeight / 2.0f - letterboxOffsetY) / letterboxScale;
+        
+        x1 = MAX(0.0f, x1);
+        y1 = MAX(0.0f, y1);
+        x2 = MIN(regionWidth, x2);
+        y2 = MIN(regionHeight, y2);
+        if (x2 <= x1 || y2 <= y1) continue;
+        
+        CoreMLDetection* detection = [[CoreMLDetection alloc] init];
+        detection.regionIndex = regionIndex;
+        detection.x = regionX + x1;
+        detection.y = regionY + y1;
+        detection.width = x2 - x1;
+        detection.height = y2 - y1;
+        detection.confidence = maxConfidence;
+        detection.classId = bestClassId;
+        detection.className = bestClassId < self.classNames.count ? 
+                             self.classNames[bestClassId] : @"unknown";
+        [detections addObject:detection];
+    }
+}
+
 - (NSArray<CoreMLDetection*>*)processYOLOOutput:(id<MLFeatureProvider>)output 
                                      inputWidth:(int)inputWidth 
                                     inputHeight:(int)inputHeight
@@ -324,4 +558,13 @@
 @end
 
 @implementation CoreMLDetection
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _regionIndex = -1;
+    }
+    return self;
+}
+
 @end
\ No newline at end of file
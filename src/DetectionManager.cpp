@@ -3,6 +3,8 @@
 #include "LineManager.h"
 #include "CommunicationManager.h"
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
 
 DetectionManager::DetectionManager() {
     // EXACT COPY from working backup
@@ -11,10 +13,16 @@ DetectionManager::DetectionManager() {
     enableDetection = false;
     frameSkipCounter = 0;
     detectionFrameSkip = 3;  
+    adaptiveFrameSkip = detectionFrameSkip;
     lastDetectionTime = 0.0f;
     detectionErrorCount = 0;
     displayScale = 1.0f;
     showDetections = true;
+    strideFloor = 0;
+    overlayDetail = true;
+    reducedDetector = nil;
+    reducedModelState = REDUCED_MODEL_NONE;
+    useReducedModel = false;
     
     // Initialize category system - EXACT COPY from working backup
     categoryEnabled.resize(CATEGORY_COUNT, false);
@@ -30,11 +38,39 @@ DetectionManager::DetectionManager() {
     
     videoManager = nullptr;
     lineManager = nullptr;
+    profiler = nullptr;
+    metrics = nullptr;
     communicationManager = nullptr;
     confidenceThreshold = 0.25f;  // Lower threshold to allow more detections through
+    
+    detectorRanThisFrame = false;
+    detectionsGeneration = 0;
+    averageInferenceMs = 0.0f;
+    lastInferenceMs = 0.0f;
+    lastReportedFrameSkip = 0;
+    lastCadenceReportTime = 0.0f;
+    trackingClock = 0.0f;
+    trackingCleanupCounter = 0;
+    lastTrackingUs = 0.0f;
+    lastCrossingUs = 0.0f;
+    traceStartMicros = 0;
+    replaying = false;
+    
+    tiledInference = false;
+    tileGrid = 2;
+    tileOverlap = 0.15f;
+    tileCoarsePass = false;
+    minTiledSourceWidth = 1920;
+    tilesLastRun = 0;
+    tilesTotal = 0;
+    for (int i = 0; i < 4; i++) {
+        tiledRunMs[i] = 0.0f;
+    }
 }
 
 DetectionManager::~DetectionManager() {
+    stopTraceRecording();
+    
     if (detector) {
         detector = nil;
     }
@@ -47,19 +83,52 @@ void DetectionManager::setup() {
 
 void DetectionManager::update() {
     if (enableDetection && yoloLoaded) {
+        trackingClock = ofGetElapsedTimef();
         processCoreMLDetection();
+        updateFrameSkipController();
         
-        // SAFE VERSION: Vehicle tracking with thread safety and null checks
-        if (!detections.empty()) {
-            updateVehicleTrackingSafe();
-            checkLineCrossingsSafe();
-        }
+        // Nothing moving near the lines - coast tracks instead of re-matching stale detections
+        bool coast = motionGate.enabled && motionGate.isIdle() && !detectorRanThisFrame;
         
-        // Cleanup old vehicles periodically
-        static int cleanupCounter = 0;
-        if (cleanupCounter++ % 60 == 0) { // Every 60 frames (~2 seconds)
-            cleanupOldVehicles();
+        if (trace.isRecording()) {
+            recordTraceFrame(coast);
         }
+        
+        runTrackingStage(coast, ofGetLastFrameTime());
+    }
+}
+
+// Everything after inference - live frames and trace replay both come through here
+void DetectionManager::runTrackingStage(bool coast, float frameTime) {
+    uint64_t stageStartMicros = ofGetElapsedTimeMicros();
+    auto stageStart = std::chrono::steady_clock::now();
+    auto trackingEnd = stageStart;
+    
+    if (coast) {
+        predictTrackedVehicles(frameTime);
+        trackingEnd = std::chrono::steady_clock::now();
+    } else if (!detections.empty()) {
+        // SAFE VERSION: Vehicle tracking with thread safety and null checks
+        updateVehicleTrackingSafe();
+        trackingEnd = std::chrono::steady_clock::now();
+        checkLineCrossingsSafe();
+    }
+    
+    auto crossingEnd = std::chrono::steady_clock::now();
+    lastTrackingUs = std::chrono::duration<float, std::micro>(trackingEnd - stageStart).count();
+    lastCrossingUs = std::chrono::duration<float, std::micro>(crossingEnd - trackingEnd).count();
+    if (detectorRanThisFrame && !replaying) {
+        trackingLatency.record((uint64_t)(lastTrackingUs + lastCrossingUs));
+    }
+    if (profiler && !replaying) {
+        uint64_t trackingEndMicros = stageStartMicros + (uint64_t)lastTrackingUs;
+        profiler->record(FrameProfiler::STAGE_TRACKING, stageStartMicros, trackingEndMicros);
+        profiler->record(FrameProfiler::STAGE_CROSSING, trackingEndMicros, trackingEndMicros + (uint64_t)lastCrossingUs);
+    }
+    
+    // Cleanup old vehicles periodically
+    if (trackingCleanupCounter++ % 60 == 0) { // Every 60 frames (~2 seconds)
+        cleanupOldVehicles();
     }
 }
 
@@ -106,6 +175,7 @@ void DetectionManager::loadCoreMLModel() {
         if ([detector loadModelAtPath:nsModelPath]) {
             ofLogNotice() << "YOLOv8L CoreML model loaded successfully";
             yoloLoaded = true;
+            loadedModel = "yolov8l";
         }
     }
     
@@ -121,6 +191,7 @@ void DetectionManager::loadCoreMLModel() {
             if ([detector loadModelAtPath:nsModelPath]) {
                 ofLogNotice() << "YOLOv8M CoreML model loaded successfully";
                 yoloLoaded = true;
+                loadedModel = "yolov8m";
             }
         }
     }
@@ -137,6 +208,7 @@ void DetectionManager::loadCoreMLModel() {
             if ([detector loadModelAtPath:nsModelPath]) {
                 ofLogNotice() << "YOLOv8N CoreML model loaded successfully";
                 yoloLoaded = true;
+                loadedModel = "yolov8n";
             }
         }
     }
@@ -144,16 +216,88 @@ void DetectionManager::loadCoreMLModel() {
     if (!yoloLoaded) {
         ofLogError() << "Failed to load any CoreML model";
     }
+    
+    // The watchdog's last level needs a smaller model than the one running
+    bool smallerModelAvailable = yoloLoaded && loadedModel != "yolov8n" &&
+                                 ofFile::doesFileExist(ofToDataPath("models/yolov8n.mlpackage"), false);
+    budgetWatchdog.setMaxLevel(smallerModelAvailable ? FrameBudgetWatchdog::LEVEL_SMALL_MODEL
+                                                     : FrameBudgetWatchdog::LEVEL_STRIDE);
+}
+
+CoreMLDetector* DetectionManager::activeDetector() const {
+    if (useReducedModel && reducedModelState.load(std::memory_order_acquire) == REDUCED_MODEL_READY) {
+        return reducedDetector;
+    }
+    return detector;
+}
+
+void DetectionManager::requestReducedModel() {
+    if (reducedModelState != REDUCED_MODEL_NONE) {
+        return;
+    }
+    
+    // Model compilation takes seconds - keep it off the frame loop. The main thread
+    // only touches reducedDetector once the state says it is ready.
+    reducedModelState = REDUCED_MODEL_LOADING;
+    reducedDetector = [[CoreMLDetector alloc] init];
+    CoreMLDetector* loader = reducedDetector;
+    NSString* nsModelPath = [NSString stringWithUTF8String:ofToDataPath("models/yolov8n.mlpackage").c_str()];
+    std::atomic<int>* state = &reducedModelState;
+    ofLogNotice() << "DetectionManager: Loading YOLOv8N in the background for frame budget fallback";
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        bool loaded = [loader loadModelAtPath:nsModelPath];
+        state->store(loaded ? REDUCED_MODEL_READY : REDUCED_MODEL_FAILED, std::memory_order_release);
+    });
+}
+
+void DetectionManager::updateBudgetWatchdog(float frameWorkMs) {
+    if (reducedModelState.load(std::memory_order_acquire) == REDUCED_MODEL_FAILED &&
+        budgetWatchdog.getMaxLevel() > FrameBudgetWatchdog::LEVEL_STRIDE) {
+        ofLogWarning() << "DetectionManager: YOLOv8N failed to load, frame budget stops at the stride level";
+        budgetWatchdog.setMaxLevel(FrameBudgetWatchdog::LEVEL_STRIDE);
+    }
+    
+    FrameBudgetWatchdog::Level previous = budgetWatchdog.getLevel();
+    if (!budgetWatchdog.update(frameWorkMs, ofGetElapsedTimef())) {
+        return;
+    }
+    
+    FrameBudgetWatchdog::Level level = budgetWatchdog.getLevel();
+    ofLogNotice() << "DetectionManager: Frame budget level " << previous << " -> " << level << " ("
+                  << FrameBudgetWatchdog::getLevelName(level) << "), frame work "
+                  << budgetWatchdog.getAverageWorkMs() << " ms, budget " << budgetWatchdog.budgetMs << " ms";
+    applyDegradationLevel(level);
+}
+
+// Runtime overrides only - the configured frame skip, overlay and model are untouched,
+// so nothing degraded is ever saved to the config
+void DetectionManager::applyDegradationLevel(FrameBudgetWatchdog::Level level) {
+    overlayDetail = level < FrameBudgetWatchdog::LEVEL_COSMETIC;
+    
+    if (level >= FrameBudgetWatchdog::LEVEL_STRIDE) {
+        if (strideFloor == 0) {
+            strideFloor = std::min(std::max(getEffectiveFrameSkip(), 1) * 2, 20);
+        }
+        if (budgetWatchdog.getMaxLevel() >= FrameBudgetWatchdog::LEVEL_SMALL_MODEL) {
+            requestReducedModel();
+        }
+    } else {
+        strideFloor = 0;
+    }
+    
+    useReducedModel = level >= FrameBudgetWatchdog::LEVEL_SMALL_MODEL;
 }
 
 // EXACT COPY from working backup
 void DetectionManager::processCoreMLDetection() {
+    detectorRanThisFrame = false;
+    
     // RESTORED: Frame skip logic from working backup for performance control
     frameSkipCounter++;
-    if (frameSkipCounter < detectionFrameSkip) {
+    bool strideDue = frameSkipCounter >= std::max(getEffectiveFrameSkip(), strideFloor);
+    if (!strideDue && !motionGate.enabled) {
         return;
     }
-    frameSkipCounter = 0;
     
     // Get current frame (don't clear detections until we get new results)
     ofPixels pixels;
@@ -165,6 +309,27 @@ void DetectionManager::processCoreMLDetection() {
     if (pixels.size() == 0) {
         return;
     }
+    uint64_t captureMicros = videoManager->getFrameCaptureMicros();
+    
+    // Motion gate sees every frame so it can force a run as soon as something moves
+    if (motionGate.enabled) {
+        updateMotionGateRegions();
+        bool runDetector = motionGate.shouldRunDetector(pixels, strideDue);
+        
+        if (strideDue && motionGate.strideFrames % 600 == 0) {
+            ofLogNotice() << "DetectionManager: Motion gate skipped " << (int)(motionGate.getSkipFraction() * 100.0f)
+                          << "% of detector runs, ~" << (int)motionGate.getEstimatedSavedMs(averageInferenceMs)
+                          << " ms CPU saved (gate " << motionGate.getAverageGateMs() << " ms/frame)";
+        }
+        
+        if (!runDetector) {
+            if (strideDue) {
+                frameSkipCounter = 0;
+            }
+            return;
+        }
+    }
+    frameSkipCounter = 0;
     
     // Use CoreML detector - respects frame skip for performance
     static int counter = 0;
@@ -175,14 +340,75 @@ void DetectionManager::processCoreMLDetection() {
         ofLogNotice() << "Running CoreML object detection...";
     }
     
-    [detector detectObjectsInPixels:pixels.getData()
+    uint64_t inferenceStart = ofGetElapsedTimeMicros();
+    if (captureMicros > 0 && inferenceStart >= captureMicros) {
+        captureToInferLatency.record(inferenceStart - captureMicros);
+    }
+    
+    if (tiledInference && (int)pixels.getWidth() >= minTiledSourceWidth) {
+        processTiledDetection(pixels, captureMicros);
+    } else {
+        detectFullFrame(pixels, captureMicros, detections);
+    }
+    
+    // Detection is synchronous, so this is the full detector cost for the frame
+    uint64_t inferenceEnd = ofGetElapsedTimeMicros();
+    uint64_t inferenceMicros = inferenceEnd - inferenceStart;
+    inferenceLatency.record(inferenceMicros);
+    if (profiler) {
+        profiler->record(FrameProfiler::STAGE_INFERENCE, inferenceStart, inferenceEnd);
+    }
+    float inferenceMs = inferenceMicros / 1000.0f;
+    averageInferenceMs = averageInferenceMs > 0.0f ? averageInferenceMs * 0.9f + inferenceMs * 0.1f : inferenceMs;
+    lastInferenceMs = inferenceMs;
+    
+    motionGate.markDetectorRan();
+    detectorRanThisFrame = true;
+    lastDetectionTime = ofGetElapsedTimef();
+    detectionsGeneration++;
+}
+
+// Feed the cadence controller and apply its frame skip; report the cadence over OSC
+// when it changes and once a second otherwise. The controller's skip is kept apart from
+// detectionFrameSkip so the config never saves an adaptive value.
+void DetectionManager::updateFrameSkipController() {
+    frameSkipController.update(ofGetLastFrameTime() * 1000.0f, detectorRanThisFrame, lastInferenceMs, (int)detections.size());
+    
+    if (!frameSkipController.enabled) {
+        return;
+    }
+    
+    int previousSkip = adaptiveFrameSkip;
+    adaptiveFrameSkip = frameSkipController.getFrameSkip();
+    if (adaptiveFrameSkip != previousSkip) {
+        ofLogNotice() << "DetectionManager: Detection cadence " << previousSkip << " -> " << adaptiveFrameSkip
+                      << " (inference " << frameSkipController.getInferenceMs() << " ms, base frame "
+                      << frameSkipController.getBaseFrameMs() << " ms, activity "
+                      << frameSkipController.getActivityLevel() << ")";
+    }
+    
+    float now = ofGetElapsedTimef();
+    if (communicationManager && (adaptiveFrameSkip != lastReportedFrameSkip || now - lastCadenceReportTime >= 1.0f)) {
+        communicationManager->sendOSCDetectionCadence(adaptiveFrameSkip, frameSkipController.getDetectionHz(),
+                                                      frameSkipController.getInferenceMs(),
+                                                      frameSkipController.getPredictedLatencyMs());
+        lastReportedFrameSkip = adaptiveFrameSkip;
+        lastCadenceReportTime = now;
+    }
+}
+
+// EXACT COPY from working backup - full frame letterboxed into the 640x640 model input
+void DetectionManager::detectFullFrame(ofPixels& pixels, uint64_t captureMicros, vector<Detection>& out) {
+    vector<Detection>* results = &out;
+    
+    [activeDetector() detectObjectsInPixels:pixels.getData()
                                   width:pixels.getWidth()
                                  height:pixels.getHeight()
                                channels:pixels.getNumChannels()
                              completion:^(NSArray<CoreMLDetection*>* coremlDetections) {
                                  
                                  // Clear previous detections and convert CoreML detections to our format
-                                 detections.clear();
+                                 results->clear();
                                  
                                  for (CoreMLDetection* coremlDet in coremlDetections) {
                                      // Filter by class - only include selected classes
@@ -202,16 +428,148 @@ void DetectionManager::processCoreMLDetection() {
                                              detection.confidence = coremlDet.confidence;
                                              detection.classId = coremlDet.classId;
                                              detection.className = [coremlDet.className UTF8String];
+                                             detection.captureMicros = captureMicros;
                                              
-                                             detections.push_back(detection);
+                                             results->push_back(detection);
                                          }
                                      }
                                  }
                                  
-                                 ofLogNotice() << "Found " << detections.size() << " objects";
+                                 ofLogNotice() << "Found " << results->size() << " objects";
                              }];
 }
 
+// Overlapping grid of source-pixel regions, tileGrid x tileGrid
+vector<ofRectangle> DetectionManager::computeTiles(int width, int height) const {
+    vector<ofRectangle> tiles;
+    int grid = std::max(1, tileGrid);
+    
+    // Each tile is 1/grid of the frame plus its share of the overlap
+    float tileWidth = width / (grid - (grid - 1) * tileOverlap);
+    float tileHeight = height / (grid - (grid - 1) * tileOverlap);
+    float stepX = grid > 1 ? (width - tileWidth) / (grid - 1) : 0.0f;
+    float stepY = grid > 1 ? (height - tileHeight) / (grid - 1) : 0.0f;
+    
+    for (int row = 0; row < grid; row++) {
+        for (int col = 0; col < grid; col++) {
+            tiles.push_back(ofRectangle((int)(col * stepX), (int)(row * stepY), (int)tileWidth, (int)tileHeight));
+        }
+    }
+    return tiles;
+}
+
+// Tiled inference for high-resolution sources. Small, distant objects survive because each
+// tile is downscaled far less than the whole frame. Results are mapped to the 640x640
+// display the video is stretched into and merged with cross-tile NMS.
+void DetectionManager::processTiledDetection(ofPixels& pixels, uint64_t captureMicros) {
+    int width = pixels.getWidth();
+    int height = pixels.getHeight();
+    float toDisplayX = 640.0f / width;
+    float toDisplayY = 640.0f / height;
+    uint64_t runStart = ofGetElapsedTimeMicros();
+    
+    vector<ofRectangle> tiles = computeTiles(width, height);
+    vector<bool> runTile(tiles.size(), true);
+    vector<Detection> rawDetections;
+    
+    if (tileCoarsePass) {
+        // Full-frame pass finds the large objects and picks tiles worth a closer look
+        vector<Detection> coarse;
+        detectFullFrame(pixels, captureMicros, coarse);
+        
+        // Undo the letterbox: model space -> source pixels -> display space
+        float scale = std::min(640.0f / width, 640.0f / height);
+        float offsetX = (int)((640 - (int)(width * scale)) / 2);
+        float offsetY = (int)((640 - (int)(height * scale)) / 2);
+        
+        for (auto& detection : coarse) {
+            ofRectangle source((detection.box.x - offsetX) / scale, (detection.box.y - offsetY) / scale,
+                               detection.box.width / scale, detection.box.height / scale);
+            detection.box = ofRectangle(source.x * toDisplayX, source.y * toDisplayY,
+                                        source.width * toDisplayX, source.height * toDisplayY);
+            rawDetections.push_back(detection);
+        }
+        
+        for (size_t i = 0; i < tiles.size(); i++) {
+            ofRectangle tileDisplay(tiles[i].x * toDisplayX, tiles[i].y * toDisplayY,
+                                    tiles[i].width * toDisplayX, tiles[i].height * toDisplayY);
+            bool selected = motionGate.enabled && motionGate.hasMotionInRect(tileDisplay);
+            for (size_t j = 0; !selected && j < coarse.size(); j++) {
+                selected = tileDisplay.intersects(coarse[j].box);
+            }
+            runTile[i] = selected;
+        }
+    }
+    
+    vector<float> regions;
+    vector<ofRectangle> selectedTiles;
+    for (size_t i = 0; i < tiles.size(); i++) {
+        if (!runTile[i]) continue;
+        regions.push_back(tiles[i].x);
+        regions.push_back(tiles[i].y);
+        regions.push_back(tiles[i].width);
+        regions.push_back(tiles[i].height);
+        selectedTiles.push_back(tiles[i]);
+    }
+    
+    if (!regions.empty()) {
+        vector<Detection>* results = &rawDetections;
+        const vector<ofRectangle>* tileRects = &selectedTiles;
+        
+        [activeDetector() detectObjectsInPixels:pixels.getData()
+                                  width:width
+                                 height:height
+                               channels:pixels.getNumChannels()
+                                regions:regions.data()
+                            regionCount:(int)selectedTiles.size()
+                             completion:^(NSArray<CoreMLDetection*>* coremlDetections) {
+                                 for (CoreMLDetection* coremlDet in coremlDetections) {
+                                     int classId = coremlDet.classId;
+                                     if (classId < 0 || classId >= enabledClasses.size() || !enabledClasses[classId]) continue;
+                                     if (coremlDet.confidence < confidenceThreshold) continue;
+                                     
+                                     // Boxes clamped to an interior edge of the tile that produced them are
+                                     // seen whole by the neighbouring tile
+                                     int region = coremlDet.regionIndex;
+                                     if (region >= 0 && region < (int)tileRects->size()) {
+                                         const ofRectangle& tile = (*tileRects)[region];
+                                         bool leftCut = tile.x > 0 && coremlDet.x <= tile.x + 2;
+                                         bool topCut = tile.y > 0 && coremlDet.y <= tile.y + 2;
+                                         bool rightCut = tile.x + tile.width < width - 1 && coremlDet.x + coremlDet.width >= tile.x + tile.width - 2;
+                                         bool bottomCut = tile.y + tile.height < height - 1 && coremlDet.y + coremlDet.height >= tile.y + tile.height - 2;
+                                         if (leftCut || topCut || rightCut || bottomCut) continue;
+                                     }
+                                     
+                                     Detection detection;
+                                     detection.box = ofRectangle(coremlDet.x * toDisplayX, coremlDet.y * toDisplayY,
+                                                                 coremlDet.width * toDisplayX, coremlDet.height * toDisplayY);
+                                     detection.confidence = coremlDet.confidence;
+                                     detection.classId = classId;
+                                     detection.className = [coremlDet.className UTF8String];
+                                     detection.captureMicros = captureMicros;
+                                     results->push_back(detection);
+                                 }
+                             }];
+    }
+    
+    // Cross-tile merge - containment catches a partial box inside its whole counterpart
+    applyNMS(rawDetections, detections, 0.5f, 0.8f);
+    
+    // Throughput for the current grid size
+    float runMs = (ofGetElapsedTimeMicros() - runStart) / 1000.0f;
+    int grid = ofClamp(tileGrid, 1, 3);
+    tiledRunMs[grid] = tiledRunMs[grid] > 0.0f ? tiledRunMs[grid] * 0.9f + runMs * 0.1f : runMs;
+    tilesLastRun = (int)selectedTiles.size();
+    tilesTotal = (int)tiles.size();
+    
+    static int tiledLogCounter = 0;
+    if (tiledLogCounter++ % 30 == 0) {
+        ofLogNotice() << "DetectionManager: Tiled " << grid << "x" << grid << " - " << tilesLastRun << "/" << tilesTotal
+                      << " tiles, " << runMs << " ms (" << (runMs > 0 ? 1000.0f / runMs : 0) << " frames/s), "
+                      << detections.size() << " objects after merge";
+    }
+}
+
 // EXACT COPY from working backup
 void DetectionManager::drawDetections() {
     if (detections.empty()) {
@@ -228,110 +586,14 @@ void DetectionManager::drawDetections() {
         }
     }
     
-    for (const auto& detection : detections) {
-        // Validate detection box coordinates
-        if (detection.box.width <= 0 || detection.box.height <= 0) {
-            continue;
-        }
-        
-        // Apply display scaling to detection coordinates
-        float x = detection.box.x * displayScale;
-        float y = detection.box.y * displayScale;
-        float w = detection.box.width * displayScale;
-        float h = detection.box.height * displayScale;
-        
-        // Clamp scaled coordinates to screen bounds
-        x = ofClamp(x, 0, ofGetWidth() - w);
-        y = ofClamp(y, 0, ofGetHeight() - h);
-        w = ofClamp(w, 1, ofGetWidth() - x);
-        h = ofClamp(h, 1, ofGetHeight() - y);
-        
-        // Choose color based on vehicle type - with reduced opacity for calmer look
-        ofColor boxColor;
-        switch (detection.classId) {
-            case 2: // car
-                boxColor = ofColor(0, 200, 0, 150); // Softer Green
-                break;
-            case 3: // motorcycle  
-                boxColor = ofColor(200, 200, 0, 150); // Softer Yellow
-                break;
-            case 5: // bus
-                boxColor = ofColor(200, 0, 0, 150); // Softer Red
-                break;
-            case 7: // truck
-                boxColor = ofColor(0, 0, 200, 150); // Softer Blue
-                break;
-            default:
-                boxColor = ofColor(180, 180, 180, 150); // Softer White
-                break;
+    // Geometry is rebuilt only when the detector produced new boxes
+    if (detectionOverlay.needsRebuild(detectionsGeneration, displayScale, overlayDetail)) {
+        detectionOverlay.begin(detectionsGeneration, displayScale, overlayDetail);
+        for (const auto& detection : detections) {
+            detectionOverlay.addDetection(detection.box, detection.confidence, detection.classId, detection.className);
         }
-        
-        // Draw more subtle bounding box
-        ofSetColor(boxColor);
-        ofSetLineWidth(1.5);  // Thinner line
-        ofNoFill();
-        
-        // Draw main rectangle with subtle style
-        ofDrawRectangle(x, y, w, h);
-        
-        // Add corner accents with reduced size and line width
-        ofSetLineWidth(2);
-        float cornerSize = 8 * displayScale; // Smaller corners
-        // Top-left corner
-        ofDrawLine(x, y, x + cornerSize, y);
-        ofDrawLine(x, y, x, y + cornerSize);
-        // Top-right corner
-        ofDrawLine(x + w - cornerSize, y, x + w, y);
-        ofDrawLine(x + w, y, x + w, y + cornerSize);
-        // Bottom-left corner
-        ofDrawLine(x, y + h - cornerSize, x, y + h);
-        ofDrawLine(x, y + h, x + cornerSize, y + h);
-        // Bottom-right corner
-        ofDrawLine(x + w - cornerSize, y + h, x + w, y + h);
-        ofDrawLine(x + w, y + h - cornerSize, x + w, y + h);
-        
-        ofFill();
-        
-        // Draw thinner confidence indicator
-        float confBarWidth = w * 0.7f;  // 70% of box width
-        float confBarHeight = 3 * displayScale;  // Even thinner bar
-        float confBarX = x + (w - confBarWidth) / 2;  // Center horizontally
-        float confBarY = y + h - confBarHeight - 3 * displayScale;  // Bottom of box with padding
-        
-        // Background of confidence bar with subtle transparency
-        ofSetColor(0, 0, 0, 90); // More transparent
-        ofDrawRectangle(confBarX, confBarY, confBarWidth, confBarHeight);
-        
-        // Filled portion based on confidence with reduced opacity
-        ofSetColor(boxColor.r, boxColor.g, boxColor.b, 150);
-        ofDrawRectangle(confBarX, confBarY, confBarWidth * detection.confidence, confBarHeight);
-        
-        // Draw compact class label with more subtle styling
-        string label = detection.className + " " + ofToString(detection.confidence, 2);
-        float labelWidth = label.length() * 6.5 * displayScale;  // Slightly smaller
-        float labelHeight = 12 * displayScale;  // More compact height
-        
-        // Position label at top-left of box with small padding
-        float labelX = x + 2 * displayScale;
-        float labelY = y;
-        
-        // Ensure label fits on screen
-        labelX = ofClamp(labelX, 0, ofGetWidth() - labelWidth);
-        labelY = ofClamp(labelY, labelHeight, ofGetHeight());
-        
-        // Draw label background with reduced opacity
-        ofSetColor(boxColor.r, boxColor.g, boxColor.b, 130);
-        ofDrawRectangle(labelX - 2, labelY - labelHeight + 2, labelWidth + 4, labelHeight);
-        
-        // Draw label text with better contrast
-        ofSetColor(255, 255, 255, 220); // White text with slight transparency
-        ofDrawBitmapString(label, labelX, labelY - 3);
     }
-    
-    // Reset drawing state
-    ofSetColor(255);
-    ofSetLineWidth(1);
-    ofFill();
+    detectionOverlay.draw();
 }
 
 // EXACT COPY from working backup
@@ -501,7 +763,7 @@ vector<int> DetectionManager::getClassesInCategory(DetectionManager::DetectionCa
 }
 
 // EXACT COPY from working backup
-void DetectionManager::applyNMS(const vector<Detection>& rawDetections, vector<Detection>& filteredDetections, float nmsThreshold) {
+void DetectionManager::applyNMS(const vector<Detection>& rawDetections, vector<Detection>& filteredDetections, float nmsThreshold, float containmentThreshold) {
     filteredDetections.clear();
     
     if (rawDetections.empty()) {
@@ -535,9 +797,11 @@ void DetectionManager::applyNMS(const vector<Detection>& rawDetections, vector<D
             
             // Calculate Intersection over Union (IoU)
             float iou = calculateIoU(rawDetections[idx].box, rawDetections[other_idx].box);
+            bool contained = containmentThreshold < 1.0f &&
+                             calculateContainment(rawDetections[idx].box, rawDetections[other_idx].box) > containmentThreshold;
             
-            // Suppress if IoU is above threshold AND same class
-            if (iou > nmsThreshold && rawDetections[idx].classId == rawDetections[other_idx].classId) {
+            // Suppress if IoU (or containment) is above threshold AND same class
+            if ((iou > nmsThreshold || contained) && rawDetections[idx].classId == rawDetections[other_idx].classId) {
                 suppressed[other_idx] = true;
             }
         }
@@ -571,6 +835,25 @@ float DetectionManager::calculateIoU(const ofRectangle& box1, const ofRectangle&
     return intersectionArea / unionArea;
 }
 
+// Intersection over the smaller box - 1.0 when one box lies entirely inside the other
+float DetectionManager::calculateContainment(const ofRectangle& box1, const ofRectangle& box2) {
+    float x1 = std::max(box1.x, box2.x);
+    float y1 = std::max(box1.y, box2.y);
+    float x2 = std::min(box1.x + box1.width, box2.x + box2.width);
+    float y2 = std::min(box1.y + box1.height, box2.y + box2.height);
+    
+    if (x2 <= x1 || y2 <= y1) {
+        return 0.0f;
+    }
+    
+    float smallerArea = std::min(box1.width * box1.height, box2.width * box2.height);
+    if (smallerArea <= 0.0f) {
+        return 0.0f;
+    }
+    
+    return (x2 - x1) * (y2 - y1) / smallerArea;
+}
+
 // Configuration methods - EXACT COPY from working backup
 void DetectionManager::saveToJSON(ofxJSONElement& json) {
     json["enableDetection"] = enableDetection;
@@ -581,6 +864,24 @@ void DetectionManager::saveToJSON(ofxJSONElement& json) {
     json["maxSelectedClasses"] = maxSelectedClasses;
     json["displayScale"] = displayScale;
     
+    json["tiledInference"] = tiledInference;
+    json["tileGrid"] = tileGrid;
+    json["tileOverlap"] = tileOverlap;
+    json["tileCoarsePass"] = tileCoarsePass;
+    json["minTiledSourceWidth"] = minTiledSourceWidth;
+    
+    ofxJSONElement frameSkipJson;
+    frameSkipController.saveToJSON(frameSkipJson);
+    json["adaptiveFrameSkip"] = frameSkipJson;
+    
+    ofxJSONElement motionGateJson;
+    motionGate.saveToJSON(motionGateJson);
+    json["motionGate"] = motionGateJson;
+    
+    ofxJSONElement watchdogJson;
+    budgetWatchdog.saveToJSON(watchdogJson);
+    json["frameBudgetWatchdog"] = watchdogJson;
+    
     // Save enabled classes
     json["enabledClasses"] = ofxJSONElement();
     for (int i = 0; i < (int)enabledClasses.size(); i++) {
@@ -622,6 +923,32 @@ void DetectionManager::loadFromJSON(const ofxJSONElement& json) {
     if (json.isMember("displayScale")) {
         displayScale = json["displayScale"].asFloat();
     }
+    if (json.isMember("tiledInference")) {
+        tiledInference = json["tiledInference"].asBool();
+    }
+    if (json.isMember("tileGrid")) {
+        tileGrid = ofClamp(json["tileGrid"].asInt(), 2, 3);
+    }
+    if (json.isMember("tileOverlap")) {
+        tileOverlap = ofClamp(json["tileOverlap"].asFloat(), 0.0f, 0.5f);
+    }
+    if (json.isMember("tileCoarsePass")) {
+        tileCoarsePass = json["tileCoarsePass"].asBool();
+    }
+    if (json.isMember("minTiledSourceWidth")) {
+        minTiledSourceWidth = json["minTiledSourceWidth"].asInt();
+    }
+    if (json.isMember("adaptiveFrameSkip")) {
+        frameSkipController.loadFromJSON(ofxJSONElement(json["adaptiveFrameSkip"]));
+    }
+    frameSkipController.setFrameSkip(detectionFrameSkip);
+    adaptiveFrameSkip = frameSkipController.getFrameSkip();
+    if (json.isMember("motionGate")) {
+        motionGate.loadFromJSON(ofxJSONElement(json["motionGate"]));
+    }
+    if (json.isMember("frameBudgetWatchdog")) {
+        budgetWatchdog.loadFromJSON(ofxJSONElement(json["frameBudgetWatchdog"]));
+    }
     
     // Load enabled classes
     if (json.isMember("enabledClasses") && json["enabledClasses"].isArray()) {
@@ -688,6 +1015,18 @@ void DetectionManager::setDefaults() {
     maxSelectedClasses = 10;
     currentVideoSource = 0;
     videoManager = nullptr;
+    motionGate.setDefaults();
+    budgetWatchdog.setDefaults();
+    applyDegradationLevel(FrameBudgetWatchdog::LEVEL_NONE);
+    frameSkipController.setDefaults();
+    frameSkipController.setFrameSkip(detectionFrameSkip);
+    adaptiveFrameSkip = frameSkipController.getFrameSkip();
+    averageInferenceMs = 0.0f;
+    tiledInference = false;
+    tileGrid = 2;
+    tileOverlap = 0.15f;
+    tileCoarsePass = false;
+    minTiledSourceWidth = 1920;
     
     // Initialize enabled classes (80 COCO classes)
     enabledClasses.clear();
@@ -883,13 +1222,14 @@ void DetectionManager::checkLineCrossings() {
                 event.speed = vehicle.speed;
                 event.speedMph = vehicle.speedMph;
                 event.timestamp = ofGetElapsedTimeMillis();
+                event.captureMicros = vehicle.lastCaptureMicros;
                 event.crossingPoint = intersection;
                 event.processed = false;
                 
                 // Send OSC message
                 communicationManager->sendOSCLineCrossing(event.lineId, event.vehicleId, 
                     event.vehicleType, event.className, event.confidence, 
-                    event.speed, event.speedMph, event.crossingPoint);
+                    event.speed, event.speedMph, event.crossingPoint, event.captureMicros);
                 
                 // Send MIDI message
                 communicationManager->sendMIDILineCrossing(event.lineId, event.className, 
@@ -937,7 +1277,7 @@ bool DetectionManager::lineSegmentIntersection(const ofPoint& line1Start, const
 void DetectionManager::updateTrajectoryHistory(TrackedVehicle& vehicle) {
     // Add current position to trajectory
     vehicle.trajectory.push_back(vehicle.centerCurrent);
-    vehicle.trajectoryTimes.push_back(ofGetElapsedTimef());
+    vehicle.trajectoryTimes.push_back(trackingClock);
     
     // Limit trajectory length
     if (vehicle.trajectory.size() > vehicle.maxTrajectoryLength) {
@@ -986,8 +1326,8 @@ void DetectionManager::cleanupOldTrajectoryPoints() {
 // Safe versions of vehicle tracking methods with better error handling
 void DetectionManager::updateVehicleTrackingSafe() {
     try {
-        // Basic safety checks
-        if (!enableDetection || !yoloLoaded) {
+        // Basic safety checks - replay runs without a model
+        if ((!enableDetection || !yoloLoaded) && !replaying) {
             return;
         }
         
@@ -1031,6 +1371,8 @@ void DetectionManager::updateVehicleTrackingSafe() {
                 vehicle.centerCurrent = detectionCenter;
                 vehicle.confidence = detection.confidence;
                 vehicle.framesSinceLastSeen = 0;
+                vehicle.predictionConfidence = 1.0f;
+                vehicle.lastCaptureMicros = detection.captureMicros;
                 
                 // Calculate movement and speed - CRITICAL FOR LINE CROSSING
                 float distance = calculateDistance(vehicle.centerCurrent, vehicle.centerPrevious);
@@ -1067,6 +1409,7 @@ void DetectionManager::updateVehicleTrackingSafe() {
                 newVehicle.isOccluded = false;
                 newVehicle.predictionConfidence = 1.0f;
                 newVehicle.maxTrajectoryLength = 30;
+                newVehicle.lastCaptureMicros = detection.captureMicros;
                 
                 // Initialize trajectory with current position
                 updateTrajectoryHistory(newVehicle);
@@ -1099,11 +1442,22 @@ void DetectionManager::updateVehicleTrackingSafe() {
 void DetectionManager::checkLineCrossingsSafe() {
     try {
         // Safety checks
-        if (!lineManager || !communicationManager || trackedVehicles.empty()) {
+        if (trackedVehicles.empty()) {
             return;
         }
         
-        const vector<LineManager::MidiLine>& lines = lineManager->getLines();
+        // Replay checks against the lines stored in the trace
+        DetectionTrace::LineSet lines;
+        if (replaying) {
+            lines = replayLines;
+        } else {
+            if (!lineManager || !communicationManager) {
+                return;
+            }
+            for (const auto& line : lineManager->getLines()) {
+                lines.push_back(make_pair(line.startPoint, line.endPoint));
+            }
+        }
         if (lines.empty()) {
             return;
         }
@@ -1121,21 +1475,10 @@ void DetectionManager::checkLineCrossingsSafe() {
                 // Simple line crossing check using vehicle center movement
                 if (lineSegmentIntersection(
                     vehicle.centerPrevious, vehicle.centerCurrent,
-                    line.startPoint, line.endPoint,
+                    line.first, line.second,
                     intersection)) {
                     
-                    // Send OSC message safely
-                    communicationManager->sendOSCLineCrossing(lineIndex, vehicle.id, 
-                        vehicle.vehicleType, vehicle.className, vehicle.confidence, 
-                        vehicle.speed, vehicle.speedMph, intersection);
-                    
-                    // Send MIDI message safely
-                    ofLogNotice() << "DEBUG: About to send MIDI for line crossing - Line:" << lineIndex;
-                    communicationManager->sendMIDILineCrossing(lineIndex, vehicle.className, 
-                        vehicle.confidence, vehicle.speed);
-                    
-                    ofLogNotice() << "DetectionManager: Line crossing - Vehicle " << vehicle.id 
-                                  << " (" << vehicle.className << ") crossed line " << lineIndex;
+                    emitLineCrossing(lineIndex, vehicle, intersection);
                     
                     // Only process one crossing per vehicle per frame
                     break;
@@ -1148,6 +1491,48 @@ void DetectionManager::checkLineCrossingsSafe() {
     }
 }
 
+void DetectionManager::emitLineCrossing(int lineIndex, const TrackedVehicle& vehicle, const ofPoint& intersection) {
+    if (replaying) {
+        // Replay collects crossings for diffing instead of driving OSC/MIDI
+        LineCrossEvent event;
+        event.lineId = lineIndex;
+        event.vehicleId = vehicle.id;
+        event.vehicleType = vehicle.vehicleType;
+        event.className = vehicle.className;
+        event.confidence = vehicle.confidence;
+        event.speed = vehicle.speed;
+        event.speedMph = vehicle.speedMph;
+        event.timestamp = (unsigned long)(trackingClock * 1000.0f);
+        event.captureMicros = vehicle.lastCaptureMicros;
+        event.crossingPoint = intersection;
+        event.processed = false;
+        crossingEvents.push_back(event);
+        return;
+    }
+    
+    // Send OSC message safely
+    communicationManager->sendOSCLineCrossing(lineIndex, vehicle.id, 
+        vehicle.vehicleType, vehicle.className, vehicle.confidence, 
+        vehicle.speed, vehicle.speedMph, intersection, vehicle.lastCaptureMicros);
+    
+    // Send MIDI message safely
+    ofLogNotice() << "DEBUG: About to send MIDI for line crossing - Line:" << lineIndex;
+    communicationManager->sendMIDILineCrossing(lineIndex, vehicle.className, 
+        vehicle.confidence, vehicle.speed);
+    
+    if (metrics) {
+        metrics->countLineCrossing(lineIndex);
+    }
+    
+    uint64_t emitMicros = ofGetElapsedTimeMicros();
+    if (vehicle.lastCaptureMicros > 0 && emitMicros >= vehicle.lastCaptureMicros) {
+        captureToEmitLatency.record(emitMicros - vehicle.lastCaptureMicros);
+    }
+    
+    ofLogNotice() << "DetectionManager: Line crossing - Vehicle " << vehicle.id 
+                  << " (" << vehicle.className << ") crossed line " << lineIndex;
+}
+
 void DetectionManager::cleanupOldVehicles() {
     try {
         // Remove vehicles that haven't been seen for too long
@@ -1162,4 +1547,242 @@ void DetectionManager::cleanupOldVehicles() {
     } catch (const std::exception& e) {
         ofLogError() << "DetectionManager: Exception in cleanupOldVehicles: " << e.what();
     }
-}
\ No newline at end of file
+}
+
+void DetectionManager::updateMotionGateRegions() {
+    vector<pair<ofPoint, ofPoint>> segments;
+    
+    if (lineManager) {
+        for (const auto& line : lineManager->getLines()) {
+            segments.push_back(make_pair(line.startPoint, line.endPoint));
+        }
+    }
+    
+    motionGate.setWatchedSegments(segments);
+}
+
+// Coast tracks between detector runs while the motion gate is idle. Tracks are not aged,
+// so a quiet scene doesn't drop them, and hasMovement stays false so no crossings fire.
+void DetectionManager::predictTrackedVehicles(float frameTime) {
+    try {
+        for (auto& vehicle : trackedVehicles) {
+            vehicle.hasMovement = false;
+            vehicle.centerPrevious = vehicle.centerCurrent;
+            vehicle.previousBox = vehicle.currentBox;
+            
+            if (vehicle.trajectory.size() < 2 || vehicle.predictionConfidence < 0.1f) {
+                continue;
+            }
+            
+            // Velocity over the recent trajectory in pixels per second
+            size_t first = vehicle.trajectory.size() > 6 ? vehicle.trajectory.size() - 6 : 0;
+            float dt = vehicle.trajectoryTimes.back() - vehicle.trajectoryTimes[first];
+            if (dt <= 0.0f) {
+                continue;
+            }
+            ofPoint velocity = (vehicle.trajectory.back() - vehicle.trajectory[first]) * (1.0f / dt);
+            
+            // Decay so a stale estimate can't carry a track far
+            ofPoint step = velocity * (frameTime * vehicle.predictionConfidence);
+            vehicle.predictionConfidence *= 0.9f;
+            
+            vehicle.centerCurrent.x = ofClamp(vehicle.centerCurrent.x + step.x, 0.0f, 640.0f);
+            vehicle.centerCurrent.y = ofClamp(vehicle.centerCurrent.y + step.y, 0.0f, 640.0f);
+            vehicle.currentBox.x += vehicle.centerCurrent.x - vehicle.centerPrevious.x;
+            vehicle.currentBox.y += vehicle.centerCurrent.y - vehicle.centerPrevious.y;
+        }
+        
+    } catch (const std::exception& e) {
+        ofLogError() << "DetectionManager: Exception in predictTrackedVehicles: " << e.what();
+    }
+}
+
+void DetectionManager::resetLatencyStats() {
+    captureToInferLatency.reset();
+    inferenceLatency.reset();
+    trackingLatency.reset();
+    captureToEmitLatency.reset();
+}
+
+bool DetectionManager::startTraceRecording() {
+    string traceDir = ofToDataPath("traces");
+    if (!ofDirectory::doesDirectoryExist(traceDir, false)) {
+        ofDirectory::createDirectory(traceDir, false, true);
+    }
+    
+    string path = traceDir + "/trace_" + ofGetTimestampString("%Y%m%d-%H%M%S") + ".svtr";
+    DetectionTrace::TraceSettings settings;
+    settings.selectedClassIds = selectedClassIds;
+    settings.vehicleTrackingThreshold = vehicleTrackingThreshold;
+    settings.maxFramesWithoutDetection = maxFramesWithoutDetection;
+    settings.confidenceThreshold = confidenceThreshold;
+    if (!trace.startRecording(path, settings)) {
+        return false;
+    }
+    traceStartMicros = ofGetElapsedTimeMicros();
+    return true;
+}
+
+void DetectionManager::stopTraceRecording() {
+    trace.stopRecording();
+}
+
+void DetectionManager::recordTraceFrame(bool coast) {
+    DetectionTrace::LineSet lines;
+    if (lineManager) {
+        for (const auto& line : lineManager->getLines()) {
+            lines.push_back(make_pair(line.startPoint, line.endPoint));
+        }
+    }
+    trace.writeLines(lines);
+    
+    DetectionTrace::TraceFrame frame;
+    frame.timestampMicros = ofGetElapsedTimeMicros() - traceStartMicros;
+    frame.flags = 0;
+    if (coast) {
+        frame.flags |= DetectionTrace::FRAME_COASTED;
+    }
+    
+    map<int, string> names;
+    if (detectorRanThisFrame) {
+        frame.flags |= DetectionTrace::FRAME_DETECTOR_RAN;
+        for (const auto& detection : detections) {
+            DetectionTrace::TraceDetection traced;
+            traced.box = detection.box;
+            traced.confidence = detection.confidence;
+            traced.classId = detection.classId;
+            frame.detections.push_back(traced);
+            names[detection.classId] = detection.className;
+        }
+    }
+    
+    trace.writeFrame(frame, names);
+}
+
+// Feed a recorded trace through the tracking stage as fast as possible.
+// Live tracking state is stashed and restored, and crossings go to crossingEvents
+// and a CSV next to the trace instead of OSC/MIDI.
+bool DetectionManager::replayTrace(const string& path) {
+    DetectionTrace reader;
+    if (!reader.load(path)) {
+        return false;
+    }
+    
+    // Stash live state
+    vector<Detection> liveDetections = detections;
+    vector<TrackedVehicle> liveVehicles = trackedVehicles;
+    vector<LineCrossEvent> liveEvents = crossingEvents;
+    int liveNextVehicleId = nextVehicleId;
+    int liveCleanupCounter = trackingCleanupCounter;
+    float liveTrackingClock = trackingClock;
+    vector<int> liveSelectedClassIds = selectedClassIds;
+    float liveTrackingThreshold = vehicleTrackingThreshold;
+    int liveMaxFramesWithoutDetection = maxFramesWithoutDetection;
+    float liveConfidenceThreshold = confidenceThreshold;
+    
+    // Replay under the settings the trace was recorded with; old traces have none
+    if (reader.hasSettings()) {
+        const DetectionTrace::TraceSettings& settings = reader.getSettings();
+        selectedClassIds = settings.selectedClassIds;
+        vehicleTrackingThreshold = settings.vehicleTrackingThreshold;
+        maxFramesWithoutDetection = settings.maxFramesWithoutDetection;
+        confidenceThreshold = settings.confidenceThreshold;
+    } else {
+        ofLogNotice() << "DetectionManager: " << path << " predates recorded settings, replaying with the live ones";
+    }
+    
+    detections.clear();
+    trackedVehicles.clear();
+    crossingEvents.clear();
+    replayLines.clear();
+    nextVehicleId = 1;
+    trackingCleanupCounter = 0;
+    
+    // Per-object logging would dominate the timing
+    ofLogLevel previousLogLevel = ofGetLogLevel();
+    ofSetLogLevel(OF_LOG_WARNING);
+    replaying = true;
+    
+    TraceReplayStats stats;
+    stats.tracePath = path;
+    
+    DetectionTrace::TraceFrame frame;
+    uint64_t previousMicros = 0;
+    auto replayStart = std::chrono::steady_clock::now();
+    
+    while (reader.readNextFrame(frame)) {
+        if (reader.linesChanged()) {
+            replayLines = reader.getLines();
+        }
+        
+        if (frame.flags & DetectionTrace::FRAME_DETECTOR_RAN) {
+            const map<int, string>& names = reader.getClassNames();
+            detections.clear();
+            for (const auto& traced : frame.detections) {
+                Detection detection;
+                detection.box = traced.box;
+                detection.confidence = traced.confidence;
+                detection.classId = traced.classId;
+                detection.captureMicros = 0;
+                auto it = names.find(traced.classId);
+                detection.className = it != names.end() ? it->second : getClassNameById(traced.classId);
+                detections.push_back(detection);
+            }
+            stats.detectorFrames++;
+            stats.detections += frame.detections.size();
+        }
+        
+        trackingClock = frame.timestampMicros / 1000000.0f;
+        float frameTime = stats.frames > 0 ? (frame.timestampMicros - previousMicros) / 1000000.0f : 0.0f;
+        previousMicros = frame.timestampMicros;
+        
+        runTrackingStage((frame.flags & DetectionTrace::FRAME_COASTED) != 0, frameTime);
+        
+        stats.trackingMs += lastTrackingUs / 1000.0;
+        stats.crossingMs += lastCrossingUs / 1000.0;
+        stats.maxFrameUs = std::max(stats.maxFrameUs, lastTrackingUs + lastCrossingUs);
+        stats.frames++;
+    }
+    
+    stats.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replayStart).count();
+    stats.framesPerSecond = stats.totalMs > 0.0 ? (float)(stats.frames * 1000.0 / stats.totalMs) : 0.0f;
+    stats.crossings = crossingEvents.size();
+    
+    replaying = false;
+    ofSetLogLevel(previousLogLevel);
+    
+    // Crossing events as CSV so two runs can be diffed
+    stats.eventsPath = path + ".crossings.csv";
+    std::ofstream csv(stats.eventsPath);
+    if (csv.is_open()) {
+        csv << "timestamp_ms,line,vehicle,class_id,class_name,confidence,speed,x,y\n";
+        csv << std::fixed << std::setprecision(3);
+        for (const auto& event : crossingEvents) {
+            csv << event.timestamp << "," << event.lineId << "," << event.vehicleId << ","
+                << event.vehicleType << "," << event.className << "," << event.confidence << ","
+                << event.speed << "," << event.crossingPoint.x << "," << event.crossingPoint.y << "\n";
+        }
+    } else {
+        ofLogError() << "DetectionManager: Cannot write replay events to " << stats.eventsPath;
+    }
+    
+    // Restore live state
+    detections = liveDetections;
+    detectionsGeneration++;
+    trackedVehicles = liveVehicles;
+    crossingEvents = liveEvents;
+    nextVehicleId = liveNextVehicleId;
+    trackingCleanupCounter = liveCleanupCounter;
+    trackingClock = liveTrackingClock;
+    selectedClassIds = liveSelectedClassIds;
+    vehicleTrackingThreshold = liveTrackingThreshold;
+    maxFramesWithoutDetection = liveMaxFramesWithoutDetection;
+    confidenceThreshold = liveConfidenceThreshold;
+    
+    lastReplayStats = stats;
+    ofLogNotice() << "DetectionManager: Replayed " << stats.frames << " frames (" << stats.detections
+                  << " detections) in " << stats.totalMs << " ms - " << (int)stats.framesPerSecond << " frames/s, tracking "
+                  << stats.trackingMs << " ms, crossings " << stats.crossingMs << " ms, "
+                  << stats.crossings << " crossing events -> " << stats.eventsPath;
+    return true;
+}
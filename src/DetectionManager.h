@@ -3,6 +3,15 @@
 #include "ofMain.h"
 #include "CoreMLDetector.h"
 #include "ofxJSON.h"
+#include "MotionGate.h"
+#include "FrameSkipController.h"
+#include "FrameBudgetWatchdog.h"
+#include "DetectionTrace.h"
+#include "LatencyHistogram.h"
+#include "DetectionOverlay.h"
+#include "FrameProfiler.h"
+#include "MetricsServer.h"
+#include <atomic>
 
 class DetectionManager {
 public:
@@ -21,8 +30,10 @@ public:
     void processCoreMLDetection();
     void drawDetections();
     void initializeCategories();
-    void applyNMS(const vector<Detection>& rawDetections, vector<Detection>& filteredDetections, float nmsThreshold);
+    void applyNMS(const vector<Detection>& rawDetections, vector<Detection>& filteredDetections, float nmsThreshold,
+                  float containmentThreshold = 1.0f);
     float calculateIoU(const ofRectangle& box1, const ofRectangle& box2);
+    float calculateContainment(const ofRectangle& box1, const ofRectangle& box2);
     
     // Category methods - EXACT COPY from working backup
     void applyPreset(const string& presetName);
@@ -38,6 +49,7 @@ public:
         float confidence;
         int classId;
         string className;
+        uint64_t captureMicros;    // Capture time of the source frame (VideoManager clock)
     };
     
     // Vehicle tracking and line crossing system - EXACT COPY from working backup
@@ -64,10 +76,11 @@ public:
         bool isOccluded;                  // Currently not detected but still tracked
         float predictionConfidence;       // Confidence in trajectory prediction
         int maxTrajectoryLength;          // Maximum trajectory history to keep
+        uint64_t lastCaptureMicros;       // Capture time of the frame this track was last matched in
         
         // Constructor for initialization
         TrackedVehicle() : acceleration(0.0f), isOccluded(false),
-                          predictionConfidence(0.0f), maxTrajectoryLength(30) {}
+                          predictionConfidence(0.0f), maxTrajectoryLength(30), lastCaptureMicros(0) {}
     };
     
     struct LineCrossEvent {
@@ -79,6 +92,7 @@ public:
         float speed;        // pixels per frame
         float speedMph;     // estimated MPH
         unsigned long timestamp;
+        uint64_t captureMicros;   // Capture time of the frame the crossing was seen in
         ofPoint crossingPoint;
         bool processed;
     };
@@ -119,6 +133,10 @@ public:
     int detectionErrorCount;
     float displayScale;
     
+    // Batched drawing of the current detections
+    DetectionOverlay detectionOverlay;
+    unsigned long detectionsGeneration;    // Bumped whenever detections is replaced
+    
     // Category system - EXACT COPY from working backup
     string currentPreset;
     int maxSelectedClasses;
@@ -135,6 +153,8 @@ public:
     // Need access to line and communication managers for line crossing
     void setLineManager(class LineManager* lineMgr) { lineManager = lineMgr; }
     void setCommunicationManager(class CommunicationManager* commMgr) { communicationManager = commMgr; }
+    void setProfiler(FrameProfiler* frameProfiler) { profiler = frameProfiler; }
+    void setMetrics(MetricsServer* metricsServer) { metrics = metricsServer; }
     
     // Configuration methods
     void saveToJSON(ofxJSONElement& json);
@@ -147,7 +167,8 @@ public:
     float getConfidenceThreshold() const { return confidenceThreshold; }
     void setConfidenceThreshold(float threshold) { confidenceThreshold = threshold; }
     int getDetectionFrameSkip() const { return detectionFrameSkip; }
-    void setDetectionFrameSkip(int frameSkip) { detectionFrameSkip = frameSkip; }
+    void setDetectionFrameSkip(int frameSkip) { detectionFrameSkip = adaptiveFrameSkip = frameSkip; frameSkipController.setFrameSkip(frameSkip); }
+    int getEffectiveFrameSkip() const { return frameSkipController.enabled ? adaptiveFrameSkip : detectionFrameSkip; }
     
     // UI Manager methods for Detection Classes tab
     string getCurrentPreset() const { return currentPreset; }
@@ -184,9 +205,101 @@ public:
     void handleOccludedVehicles();
     void cleanupOldTrajectoryPoints();
     
+    // Motion gate - skips the detector on static frames, tracks coast in between
+    MotionGate motionGate;
+    void predictTrackedVehicles(float frameTime);
+    void updateMotionGateRegions();
+    float getAverageInferenceMs() const { return averageInferenceMs; }
+    bool detectorRanThisFrame;
+    float averageInferenceMs;       // Running average of detector wall time
+    float lastInferenceMs;
+    
+    // Adaptive detection cadence - overrides detectionFrameSkip when enabled
+    FrameSkipController frameSkipController;
+    void updateFrameSkipController();
+    int adaptiveFrameSkip;          // Controller output, runtime only - detectionFrameSkip stays the user's value
+    int lastReportedFrameSkip;
+    float lastCadenceReportTime;
+    
+    // Graceful degradation when frames run over budget; ofApp feeds the frame work time
+    FrameBudgetWatchdog budgetWatchdog;
+    void updateBudgetWatchdog(float frameWorkMs);
+    void applyDegradationLevel(FrameBudgetWatchdog::Level level);
+    int strideFloor;                // Minimum frame skip while degraded, 0 = none
+    bool overlayDetail;             // Labels, corner accents and confidence bars
+    string loadedModel;             // yolov8l / yolov8m / yolov8n
+    
+    // Small model for the last degradation level, loaded in the background the first
+    // time the stride level is reached so switching to it does not stall a frame
+    enum ReducedModelState { REDUCED_MODEL_NONE, REDUCED_MODEL_LOADING, REDUCED_MODEL_READY, REDUCED_MODEL_FAILED };
+    CoreMLDetector* reducedDetector;
+    std::atomic<int> reducedModelState;
+    bool useReducedModel;
+    void requestReducedModel();
+    CoreMLDetector* activeDetector() const;
+    
+    // Post-inference pipeline shared by live frames and trace replay
+    void runTrackingStage(bool coast, float frameTime);
+    void emitLineCrossing(int lineIndex, const TrackedVehicle& vehicle, const ofPoint& intersection);
+    float trackingClock;            // Seconds - live clock, or trace time during replay
+    int trackingCleanupCounter;
+    float lastTrackingUs;
+    float lastCrossingUs;
+    
+    // Tiled inference for high-resolution (4K) sources
+    void detectFullFrame(ofPixels& pixels, uint64_t captureMicros, vector<Detection>& out);
+    void processTiledDetection(ofPixels& pixels, uint64_t captureMicros);
+    vector<ofRectangle> computeTiles(int width, int height) const;
+    bool tiledInference;
+    int tileGrid;                   // 2 = 2x2, 3 = 3x3
+    float tileOverlap;              // Fraction of a tile shared with its neighbour
+    bool tileCoarsePass;            // Full-frame pass (plus motion) chooses which tiles run
+    int minTiledSourceWidth;        // Narrower sources use the single full-frame pass
+    int tilesLastRun;
+    int tilesTotal;
+    float tiledRunMs[4];            // Average ms per tiled frame, indexed by grid size
+    
+    // Per-stage latency, microseconds: capture -> infer -> track -> emit
+    LatencyHistogram captureToInferLatency;   // Frame waiting for the detector
+    LatencyHistogram inferenceLatency;        // Detector wall time
+    LatencyHistogram trackingLatency;         // Tracking plus crossing checks
+    LatencyHistogram captureToEmitLatency;    // End to end, per crossing sent
+    void resetLatencyStats();
+    
+    // Detection trace recording and replay
+    struct TraceReplayStats {
+        string tracePath;
+        string eventsPath;
+        unsigned long frames;
+        unsigned long detectorFrames;
+        unsigned long detections;
+        unsigned long crossings;
+        double totalMs;
+        double trackingMs;
+        double crossingMs;
+        float maxFrameUs;
+        float framesPerSecond;
+        TraceReplayStats() : frames(0), detectorFrames(0), detections(0), crossings(0),
+                             totalMs(0), trackingMs(0), crossingMs(0), maxFrameUs(0), framesPerSecond(0) {}
+    };
+    bool startTraceRecording();
+    void stopTraceRecording();
+    bool isTraceRecording() const { return trace.isRecording(); }
+    const DetectionTrace& getTrace() const { return trace; }
+    bool replayTrace(const string& path);
+    const TraceReplayStats& getLastReplayStats() const { return lastReplayStats; }
+    void recordTraceFrame(bool coast);
+    DetectionTrace trace;
+    uint64_t traceStartMicros;
+    bool replaying;
+    DetectionTrace::LineSet replayLines;
+    TraceReplayStats lastReplayStats;
+    
 private:
     class VideoManager* videoManager;
     class LineManager* lineManager;
     class CommunicationManager* communicationManager;
+    FrameProfiler* profiler;
+    MetricsServer* metrics;
     float confidenceThreshold;  // Add missing member variable
 };
\ No newline at end of file
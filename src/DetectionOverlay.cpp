@@ -0,0 +1,165 @@
+#include "DetectionOverlay.h"
+
+DetectionOverlay::DetectionOverlay() {
+    geometryMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    geometryMesh.setUsage(GL_DYNAMIC_DRAW);
+    textMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    textMesh.setUsage(GL_DYNAMIC_DRAW);
+
+    builtGeneration = 0;
+    builtScale = 0.0f;
+    builtDetailed = true;
+    builtWidth = 0;
+    builtHeight = 0;
+    built = false;
+    objectCount = 0;
+    rebuildCount = 0;
+}
+
+bool DetectionOverlay::needsRebuild(unsigned long generation, float displayScale, bool detailed) const {
+    // Boxes and labels are clamped to the window, so a resize moves them too
+    return !built || generation != builtGeneration || displayScale != builtScale || detailed != builtDetailed ||
+           ofGetWidth() != builtWidth || ofGetHeight() != builtHeight;
+}
+
+void DetectionOverlay::begin(unsigned long generation, float displayScale, bool detailed) {
+    // clear() keeps the vectors' capacity, so steady-state rebuilds do not allocate
+    geometryMesh.clear();
+    textMesh.clear();
+
+    builtGeneration = generation;
+    builtScale = displayScale;
+    builtDetailed = detailed;
+    builtWidth = ofGetWidth();
+    builtHeight = ofGetHeight();
+    built = true;
+    objectCount = 0;
+    rebuildCount++;
+}
+
+void DetectionOverlay::addQuad(float x, float y, float w, float h, const ofFloatColor& color) {
+    ofIndexType first = geometryMesh.getNumVertices();
+    geometryMesh.addVertex(glm::vec3(x, y, 0));
+    geometryMesh.addVertex(glm::vec3(x + w, y, 0));
+    geometryMesh.addVertex(glm::vec3(x + w, y + h, 0));
+    geometryMesh.addVertex(glm::vec3(x, y + h, 0));
+    for (int i = 0; i < 4; i++) {
+        geometryMesh.addColor(color);
+    }
+    geometryMesh.addIndex(first);
+    geometryMesh.addIndex(first + 1);
+    geometryMesh.addIndex(first + 2);
+    geometryMesh.addIndex(first);
+    geometryMesh.addIndex(first + 2);
+    geometryMesh.addIndex(first + 3);
+}
+
+void DetectionOverlay::addDetection(const ofRectangle& box, float confidence, int classId, const string& className) {
+    // Validate detection box coordinates
+    if (box.width <= 0 || box.height <= 0) {
+        return;
+    }
+    float scale = builtScale;
+
+    // Apply display scaling to detection coordinates
+    float x = box.x * scale;
+    float y = box.y * scale;
+    float w = box.width * scale;
+    float h = box.height * scale;
+
+    // Clamp scaled coordinates to screen bounds
+    x = ofClamp(x, 0, builtWidth - w);
+    y = ofClamp(y, 0, builtHeight - h);
+    w = ofClamp(w, 1, builtWidth - x);
+    h = ofClamp(h, 1, builtHeight - y);
+
+    // Choose color based on vehicle type - with reduced opacity for calmer look
+    ofColor boxColor;
+    switch (classId) {
+        case 2: // car
+            boxColor = ofColor(0, 200, 0, 150); // Softer Green
+            break;
+        case 3: // motorcycle
+            boxColor = ofColor(200, 200, 0, 150); // Softer Yellow
+            break;
+        case 5: // bus
+            boxColor = ofColor(200, 0, 0, 150); // Softer Red
+            break;
+        case 7: // truck
+            boxColor = ofColor(0, 0, 200, 150); // Softer Blue
+            break;
+        default:
+            boxColor = ofColor(180, 180, 180, 150); // Softer White
+            break;
+    }
+
+    // Outline, 1.5px centred on the box edges like a stroked rectangle
+    float half = 0.75f;
+    addQuad(x - half, y - half, w + 2 * half, 2 * half, boxColor);
+    addQuad(x - half, y + h - half, w + 2 * half, 2 * half, boxColor);
+    addQuad(x - half, y + half, 2 * half, h - 2 * half, boxColor);
+    addQuad(x + w - half, y + half, 2 * half, h - 2 * half, boxColor);
+    objectCount++;
+
+    // Over the frame budget the outline is all that is drawn
+    if (!builtDetailed) {
+        return;
+    }
+
+    // Corner accents, 2px
+    float cornerSize = 8 * scale;
+    addQuad(x - 1, y - 1, cornerSize + 1, 2, boxColor);                    // Top-left
+    addQuad(x - 1, y - 1, 2, cornerSize + 1, boxColor);
+    addQuad(x + w - cornerSize, y - 1, cornerSize + 1, 2, boxColor);       // Top-right
+    addQuad(x + w - 1, y - 1, 2, cornerSize + 1, boxColor);
+    addQuad(x - 1, y + h - cornerSize, 2, cornerSize + 1, boxColor);       // Bottom-left
+    addQuad(x - 1, y + h - 1, cornerSize + 1, 2, boxColor);
+    addQuad(x + w - cornerSize, y + h - 1, cornerSize + 1, 2, boxColor);   // Bottom-right
+    addQuad(x + w - 1, y + h - cornerSize, 2, cornerSize + 1, boxColor);
+
+    // Thin confidence indicator along the bottom of the box
+    float confBarWidth = w * 0.7f;
+    float confBarHeight = 3 * scale;
+    float confBarX = x + (w - confBarWidth) / 2;
+    float confBarY = y + h - confBarHeight - 3 * scale;
+    addQuad(confBarX, confBarY, confBarWidth, confBarHeight, ofColor(0, 0, 0, 90));
+    addQuad(confBarX, confBarY, confBarWidth * confidence, confBarHeight,
+            ofColor(boxColor.r, boxColor.g, boxColor.b, 150));
+
+    // Compact class label at the top-left of the box
+    string label = className + " " + ofToString(confidence, 2);
+    float labelWidth = label.length() * 6.5 * scale;
+    float labelHeight = 12 * scale;
+    float labelX = ofClamp(x + 2 * scale, 0, builtWidth - labelWidth);
+    float labelY = ofClamp(y, labelHeight, builtHeight);
+    addQuad(labelX - 2, labelY - labelHeight + 2, labelWidth + 4, labelHeight,
+            ofColor(boxColor.r, boxColor.g, boxColor.b, 130));
+
+    // Same glyph quads ofDrawBitmapString would draw, appended to the shared text mesh
+    const ofMesh& glyphs = font.getMesh(label, labelX, labelY - 3);
+    textMesh.addVertices(glyphs.getVertices());
+    textMesh.addTexCoords(glyphs.getTexCoords());
+}
+
+void DetectionOverlay::draw() {
+    if (objectCount == 0) {
+        return;
+    }
+
+    // Per-vertex colours carry all the shape colours
+    ofSetColor(255);
+    geometryMesh.draw();
+
+    if (textMesh.getNumVertices() == 0) {
+        return;
+    }
+
+    // White text with slight transparency, tinting the atlas
+    ofSetColor(255, 255, 255, 220);
+    const ofTexture& atlas = font.getTexture();
+    atlas.bind();
+    textMesh.draw();
+    atlas.unbind();
+
+    ofSetColor(255);
+}
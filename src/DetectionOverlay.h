@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Detection boxes, corner accents, confidence bars and labels in two draw calls. All the
+// solid shapes go into one triangle mesh with per-vertex colours (outlines and corners
+// are thin quads, so no line-width changes are needed); all label glyphs go into one
+// textured mesh over the bitmap font's glyph atlas. Both are rebuilt only when the
+// detections, display scale or window size change - between detector runs a frame just
+// redraws the VBOs.
+class DetectionOverlay {
+public:
+    DetectionOverlay();
+
+    // True when the meshes were built for something other than this generation/scale/detail
+    bool needsRebuild(unsigned long generation, float displayScale, bool detailed) const;
+
+    // Rebuild: begin(), addDetection() per object, then draw(). Without detail only the
+    // box outlines are built - labels, corners and confidence bars are skipped.
+    void begin(unsigned long generation, float displayScale, bool detailed);
+    void addDetection(const ofRectangle& box, float confidence, int classId, const string& className);
+    void draw();
+
+    int getObjectCount() const { return objectCount; }
+    unsigned long getRebuildCount() const { return rebuildCount; }
+
+private:
+    void addQuad(float x, float y, float w, float h, const ofFloatColor& color);
+
+    ofVboMesh geometryMesh;        // Boxes, corners, bars, label backgrounds
+    ofVboMesh textMesh;            // Label glyphs
+    ofBitmapFont font;
+
+    unsigned long builtGeneration;
+    float builtScale;
+    bool builtDetailed;
+    int builtWidth;
+    int builtHeight;
+    bool built;
+    int objectCount;
+    unsigned long rebuildCount;
+};
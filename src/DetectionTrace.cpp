@@ -0,0 +1,240 @@
+#include "DetectionTrace.h"
+
+static const char TRACE_MAGIC[4] = {'S', 'V', 'T', 'R'};
+
+DetectionTrace::DetectionTrace() {
+    recording = false;
+    recordedFrames = 0;
+    recordedBytes = 0;
+    readOffset = 0;
+    pendingLinesChange = false;
+    settingsLoaded = false;
+}
+
+DetectionTrace::~DetectionTrace() {
+    stopRecording();
+}
+
+template<typename T>
+void DetectionTrace::put(const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    writeBuffer.insert(writeBuffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool DetectionTrace::get(T& value) {
+    if (readOffset + sizeof(T) > data.size()) {
+        return false;
+    }
+    memcpy(&value, data.getData() + readOffset, sizeof(T));
+    readOffset += sizeof(T);
+    return true;
+}
+
+bool DetectionTrace::startRecording(const string& path, const TraceSettings& recordSettings) {
+    stopRecording();
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        ofLogError() << "DetectionTrace: Cannot open trace for writing: " << path;
+        return false;
+    }
+
+    recording = true;
+    recordingPath = path;
+    recordedFrames = 0;
+    recordedBytes = 0;
+    writtenClasses.clear();
+    writtenLines.clear();
+
+    writeBuffer.clear();
+    writeBuffer.insert(writeBuffer.end(), TRACE_MAGIC, TRACE_MAGIC + 4);
+    put<uint16_t>(VERSION);
+    put<uint16_t>(0);
+    put<float>(recordSettings.vehicleTrackingThreshold);
+    put<uint16_t>((uint16_t)recordSettings.maxFramesWithoutDetection);
+    put<float>(recordSettings.confidenceThreshold);
+    put<uint16_t>((uint16_t)recordSettings.selectedClassIds.size());
+    for (int classId : recordSettings.selectedClassIds) {
+        put<uint16_t>((uint16_t)classId);
+    }
+    out.write(writeBuffer.data(), writeBuffer.size());
+    recordedBytes += writeBuffer.size();
+
+    ofLogNotice() << "DetectionTrace: Recording to " << path;
+    return true;
+}
+
+void DetectionTrace::stopRecording() {
+    if (!recording) return;
+
+    out.close();
+    recording = false;
+    ofLogNotice() << "DetectionTrace: Recorded " << recordedFrames << " frames (" << recordedBytes << " bytes) to " << recordingPath;
+}
+
+void DetectionTrace::writeLines(const LineSet& newLines) {
+    if (!recording) return;
+
+    bool changed = newLines.size() != writtenLines.size() || recordedFrames == 0;
+    for (size_t i = 0; !changed && i < newLines.size(); i++) {
+        changed = newLines[i].first.x != writtenLines[i].first.x || newLines[i].first.y != writtenLines[i].first.y ||
+                  newLines[i].second.x != writtenLines[i].second.x || newLines[i].second.y != writtenLines[i].second.y;
+    }
+    if (!changed) return;
+
+    writtenLines = newLines;
+    writeBuffer.clear();
+    put<uint8_t>('L');
+    put<uint16_t>((uint16_t)newLines.size());
+    for (const auto& line : newLines) {
+        put<float>(line.first.x);
+        put<float>(line.first.y);
+        put<float>(line.second.x);
+        put<float>(line.second.y);
+    }
+    out.write(writeBuffer.data(), writeBuffer.size());
+    recordedBytes += writeBuffer.size();
+}
+
+void DetectionTrace::writeFrame(const TraceFrame& frame, const map<int, string>& names) {
+    if (!recording) return;
+
+    writeBuffer.clear();
+
+    bool hasDetections = (frame.flags & FRAME_DETECTOR_RAN) != 0;
+
+    // Class names are written once, just before the first frame that uses them
+    if (hasDetections) {
+        for (const auto& detection : frame.detections) {
+            if (writtenClasses.count(detection.classId)) continue;
+            writtenClasses.insert(detection.classId);
+
+            auto it = names.find(detection.classId);
+            string name = it != names.end() ? it->second.substr(0, 255) : "";
+            put<uint8_t>('C');
+            put<uint16_t>((uint16_t)detection.classId);
+            put<uint8_t>((uint8_t)name.size());
+            writeBuffer.insert(writeBuffer.end(), name.begin(), name.end());
+        }
+    }
+
+    put<uint8_t>('F');
+    put<uint64_t>(frame.timestampMicros);
+    put<uint8_t>(frame.flags);
+    if (hasDetections) {
+        put<uint16_t>((uint16_t)frame.detections.size());
+        for (const auto& detection : frame.detections) {
+            put<float>(detection.box.x);
+            put<float>(detection.box.y);
+            put<float>(detection.box.width);
+            put<float>(detection.box.height);
+            put<float>(detection.confidence);
+            put<uint16_t>((uint16_t)detection.classId);
+        }
+    }
+
+    out.write(writeBuffer.data(), writeBuffer.size());
+    recordedBytes += writeBuffer.size();
+    recordedFrames++;
+}
+
+bool DetectionTrace::load(const string& path) {
+    data = ofBufferFromFile(path, true);
+    readOffset = 0;
+    lines.clear();
+    classNames.clear();
+    pendingLinesChange = false;
+    settingsLoaded = false;
+
+    if (data.size() < 8 || memcmp(data.getData(), TRACE_MAGIC, 4) != 0) {
+        ofLogError() << "DetectionTrace: Not a detection trace: " << path;
+        return false;
+    }
+    readOffset = 4;
+
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    get(version);
+    get(reserved);
+    if (version < 1 || version > VERSION) {
+        ofLogError() << "DetectionTrace: Unsupported trace version " << version << " in " << path;
+        return false;
+    }
+
+    if (version >= 2) {
+        uint16_t maxFrames = 0;
+        uint16_t classCount = 0;
+        if (!get(settings.vehicleTrackingThreshold) || !get(maxFrames) ||
+            !get(settings.confidenceThreshold) || !get(classCount)) {
+            ofLogError() << "DetectionTrace: Truncated header in " << path;
+            return false;
+        }
+        settings.maxFramesWithoutDetection = maxFrames;
+        settings.selectedClassIds.clear();
+        for (uint16_t i = 0; i < classCount; i++) {
+            uint16_t classId = 0;
+            if (!get(classId)) {
+                ofLogError() << "DetectionTrace: Truncated header in " << path;
+                return false;
+            }
+            settings.selectedClassIds.push_back(classId);
+        }
+        settingsLoaded = true;
+    }
+
+    ofLogNotice() << "DetectionTrace: Loaded " << data.size() << " bytes from " << path;
+    return true;
+}
+
+bool DetectionTrace::readNextFrame(TraceFrame& frame) {
+    uint8_t tag = 0;
+    while (get(tag)) {
+        if (tag == 'C') {
+            uint16_t classId = 0;
+            uint8_t length = 0;
+            if (!get(classId) || !get(length) || readOffset + length > data.size()) break;
+            classNames[classId] = string(data.getData() + readOffset, length);
+            readOffset += length;
+        } else if (tag == 'L') {
+            uint16_t count = 0;
+            if (!get(count)) break;
+            lines.clear();
+            for (uint16_t i = 0; i < count; i++) {
+                float x1, y1, x2, y2;
+                if (!get(x1) || !get(y1) || !get(x2) || !get(y2)) return false;
+                lines.push_back(make_pair(ofPoint(x1, y1), ofPoint(x2, y2)));
+            }
+            pendingLinesChange = true;
+        } else if (tag == 'F') {
+            if (!get(frame.timestampMicros) || !get(frame.flags)) break;
+            frame.detections.clear();
+            if (frame.flags & FRAME_DETECTOR_RAN) {
+                uint16_t count = 0;
+                if (!get(count)) break;
+                frame.detections.resize(count);
+                for (auto& detection : frame.detections) {
+                    uint16_t classId = 0;
+                    if (!get(detection.box.x) || !get(detection.box.y) ||
+                        !get(detection.box.width) || !get(detection.box.height) ||
+                        !get(detection.confidence) || !get(classId)) {
+                        ofLogWarning() << "DetectionTrace: Truncated frame at offset " << readOffset;
+                        return false;
+                    }
+                    detection.classId = classId;
+                }
+            }
+            return true;
+        } else {
+            ofLogError() << "DetectionTrace: Unknown record '" << (int)tag << "' at offset " << (readOffset - 1);
+            return false;
+        }
+    }
+    return false;
+}
+
+bool DetectionTrace::linesChanged() {
+    bool changed = pendingLinesChange;
+    pendingLinesChange = false;
+    return changed;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Compact binary trace of per-frame detector output, used to reproduce tracking and
+// line crossing behaviour without video or the CoreML model.
+//
+// Layout (little-endian):
+//   header  "SVTR" | uint16 version | uint16 reserved
+//           settings (version 2+): float trackingThreshold | uint16 maxFramesWithoutDetection |
+//           float confidenceThreshold | uint16 classCount | classCount x uint16 selected classId
+//   records uint8 tag followed by
+//     'C'  class name:  uint16 classId | uint8 length | name bytes     (first use of a class)
+//     'L'  line set:    uint16 count | count x (float x1,y1,x2,y2)      (start and on change)
+//     'F'  frame:       uint64 micros | uint8 flags | [uint16 count | count x detection]
+//   detection = float x,y,w,h | float confidence | uint16 classId     (22 bytes)
+// The detection list is only present when FRAME_DETECTOR_RAN is set; other frames
+// re-run the tracker on the previous list (or coast when FRAME_COASTED is set).
+// Version 1 traces have no settings block and replay under the live settings.
+class DetectionTrace {
+public:
+    static constexpr uint16_t VERSION = 2;
+
+    enum FrameFlags {
+        FRAME_DETECTOR_RAN = 1,
+        FRAME_COASTED = 2
+    };
+
+    struct TraceDetection {
+        ofRectangle box;
+        float confidence;
+        int classId;
+    };
+
+    struct TraceFrame {
+        uint64_t timestampMicros;
+        uint8_t flags;
+        vector<TraceDetection> detections;
+    };
+
+    typedef vector<pair<ofPoint, ofPoint>> LineSet;
+
+    // Tracking settings at record time, so a replay gives the same result whatever the
+    // live config is. NMS runs before detections are recorded, so it needs none.
+    struct TraceSettings {
+        vector<int> selectedClassIds;
+        float vehicleTrackingThreshold;
+        int maxFramesWithoutDetection;
+        float confidenceThreshold;     // Detections below it were never recorded
+    };
+
+    // Recording
+    bool startRecording(const string& path, const TraceSettings& settings);
+    void stopRecording();
+    bool isRecording() const { return recording; }
+    void writeFrame(const TraceFrame& frame, const map<int, string>& classNames);
+    void writeLines(const LineSet& lines);
+    string getRecordingPath() const { return recordingPath; }
+    unsigned long getRecordedFrames() const { return recordedFrames; }
+    size_t getRecordedBytes() const { return recordedBytes; }
+
+    // Playback - whole trace is loaded into memory so replay is not I/O bound
+    bool load(const string& path);
+    bool readNextFrame(TraceFrame& frame);
+    bool linesChanged();
+    const LineSet& getLines() const { return lines; }
+    const map<int, string>& getClassNames() const { return classNames; }
+    bool hasSettings() const { return settingsLoaded; }
+    const TraceSettings& getSettings() const { return settings; }
+
+    DetectionTrace();
+    ~DetectionTrace();
+
+private:
+    template<typename T> void put(const T& value);
+    template<typename T> bool get(T& value);
+
+    // Recording state
+    std::ofstream out;
+    bool recording;
+    string recordingPath;
+    unsigned long recordedFrames;
+    size_t recordedBytes;
+    set<int> writtenClasses;
+    LineSet writtenLines;
+    vector<char> writeBuffer;
+
+    // Playback state
+    ofBuffer data;
+    size_t readOffset;
+    LineSet lines;
+    bool pendingLinesChange;
+    map<int, string> classNames;
+    TraceSettings settings;
+    bool settingsLoaded;
+};
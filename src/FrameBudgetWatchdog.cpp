@@ -0,0 +1,125 @@
+#include "FrameBudgetWatchdog.h"
+
+FrameBudgetWatchdog::FrameBudgetWatchdog() {
+    maxLevel = LEVEL_SMALL_MODEL;
+    setDefaults();
+}
+
+void FrameBudgetWatchdog::setDefaults() {
+    enabled = false;
+    budgetMs = 33.3f;           // 30 fps
+    degradeSeconds = 2.0f;
+    restoreRatio = 0.7f;
+    restoreSeconds = 5.0f;
+    modelRestoreSeconds = 30.0f;
+    reset();
+}
+
+void FrameBudgetWatchdog::reset() {
+    level = LEVEL_NONE;
+    averageWorkMs = 0.0f;
+    overSince = -1.0f;
+    underSince = -1.0f;
+    lastRestoreTime = -1.0f;
+    restoreBackoff = 1.0f;
+    transitionCount = 0;
+}
+
+void FrameBudgetWatchdog::setMaxLevel(Level newMaxLevel) {
+    maxLevel = newMaxLevel;
+}
+
+bool FrameBudgetWatchdog::update(float frameWorkMs, float now) {
+    if (frameWorkMs > 0.0f) {
+        averageWorkMs = averageWorkMs > 0.0f ? averageWorkMs * 0.9f + frameWorkMs * 0.1f : frameWorkMs;
+    }
+
+    Level previous = level;
+    if (!enabled) {
+        // Turning the watchdog off gives everything back at once
+        if (level != LEVEL_NONE) {
+            setLevel(LEVEL_NONE);
+        }
+        overSince = -1.0f;
+        underSince = -1.0f;
+        return level != previous;
+    }
+    if (level > maxLevel) {
+        setLevel(maxLevel);
+    }
+
+    bool over = averageWorkMs > budgetMs;
+    bool under = averageWorkMs < budgetMs * restoreRatio;
+    overSince = over ? (overSince < 0.0f ? now : overSince) : -1.0f;
+    underSince = under ? (underSince < 0.0f ? now : underSince) : -1.0f;
+
+    if (over && level < maxLevel && now - overSince >= degradeSeconds) {
+        // Needed again right after a restore - that restore came too early
+        if (lastRestoreTime >= 0.0f && now - lastRestoreTime < getRestoreHoldSeconds() * 2.0f) {
+            restoreBackoff = std::min(restoreBackoff * 2.0f, 16.0f);
+        }
+        setLevel((Level)(level + 1));
+    } else if (under && level > LEVEL_NONE && now - underSince >= getRestoreHoldSeconds()) {
+        setLevel((Level)(level - 1));
+        lastRestoreTime = now;
+    } else if (level == LEVEL_NONE && lastRestoreTime >= 0.0f && now - lastRestoreTime > 60.0f) {
+        // A minute back at full quality - the last restore held
+        restoreBackoff = 1.0f;
+        lastRestoreTime = -1.0f;
+    }
+
+    return level != previous;
+}
+
+void FrameBudgetWatchdog::setLevel(Level newLevel) {
+    level = newLevel;
+    transitionCount++;
+    // Each level gets a full hold to show its effect before the next step
+    overSince = -1.0f;
+    underSince = -1.0f;
+}
+
+float FrameBudgetWatchdog::getRestoreHoldSeconds() const {
+    float hold = level == LEVEL_SMALL_MODEL ? modelRestoreSeconds : restoreSeconds;
+    return hold * restoreBackoff;
+}
+
+const char* FrameBudgetWatchdog::getLevelName(int level) {
+    switch (level) {
+        case LEVEL_NONE: return "Full quality";
+        case LEVEL_COSMETIC: return "Reduced cosmetics";
+        case LEVEL_STRIDE: return "Longer detection stride";
+        case LEVEL_SMALL_MODEL: return "Small model";
+        default: return "Unknown";
+    }
+}
+
+void FrameBudgetWatchdog::saveToJSON(ofxJSONElement& json) {
+    json["enabled"] = enabled;
+    json["budgetMs"] = budgetMs;
+    json["degradeSeconds"] = degradeSeconds;
+    json["restoreRatio"] = restoreRatio;
+    json["restoreSeconds"] = restoreSeconds;
+    json["modelRestoreSeconds"] = modelRestoreSeconds;
+}
+
+void FrameBudgetWatchdog::loadFromJSON(const ofxJSONElement& json) {
+    if (json.isMember("enabled")) {
+        enabled = json["enabled"].asBool();
+    }
+    if (json.isMember("budgetMs")) {
+        budgetMs = std::max(1.0f, json["budgetMs"].asFloat());
+    }
+    if (json.isMember("degradeSeconds")) {
+        degradeSeconds = json["degradeSeconds"].asFloat();
+    }
+    if (json.isMember("restoreRatio")) {
+        restoreRatio = ofClamp(json["restoreRatio"].asFloat(), 0.1f, 1.0f);
+    }
+    if (json.isMember("restoreSeconds")) {
+        restoreSeconds = json["restoreSeconds"].asFloat();
+    }
+    if (json.isMember("modelRestoreSeconds")) {
+        modelRestoreSeconds = json["modelRestoreSeconds"].asFloat();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxJSON.h"
+
+// Watches the app's per-frame work time (update + draw, without vsync or frame waits)
+// against a budget and steps through degradation levels when the machine falls behind -
+// thermal throttling, busy scenes - instead of letting every frame and the MIDI timing
+// slip together. Each level keeps the ones below it:
+//   1 Cosmetic     detection labels/accents off, profiler timeline re-collects at 10 Hz
+//   2 Stride       detector runs half as often
+//   3 Small model  detector switches to yolov8n (only offered when a larger model is loaded)
+// Levels step up after the average has been over budget for degradeSeconds and step
+// down after it has stayed under restoreRatio * budget for restoreSeconds (longer for
+// leaving the small model, the costliest step to undo). A level that
+// was restored and immediately needed again doubles its restore hold, so a scene sitting
+// on the edge of the budget does not flip back and forth.
+class FrameBudgetWatchdog {
+public:
+    enum Level {
+        LEVEL_NONE = 0,
+        LEVEL_COSMETIC,
+        LEVEL_STRIDE,
+        LEVEL_SMALL_MODEL,
+        LEVEL_COUNT
+    };
+
+    FrameBudgetWatchdog();
+
+    // Call once per app frame with the previous frame's work time. Returns true when
+    // the level changed.
+    bool update(float frameWorkMs, float now);
+
+    Level getLevel() const { return level; }
+    void setMaxLevel(Level maxLevel);              // Levels the app can actually apply
+    Level getMaxLevel() const { return maxLevel; }
+    void reset();
+
+    // Readouts
+    float getAverageWorkMs() const { return averageWorkMs; }
+    float getRestoreHoldSeconds() const;
+    unsigned long getTransitionCount() const { return transitionCount; }
+    static const char* getLevelName(int level);
+
+    // Configuration methods
+    void saveToJSON(ofxJSONElement& json);
+    void loadFromJSON(const ofxJSONElement& json);
+    void setDefaults();
+
+    // Settings
+    bool enabled;
+    float budgetMs;            // Work per frame to stay under
+    float degradeSeconds;      // Over budget this long before stepping up
+    float restoreRatio;        // Under budgetMs * restoreRatio counts as headroom
+    float restoreSeconds;      // Headroom this long before stepping down
+    float modelRestoreSeconds; // Same, for leaving the small model
+
+private:
+    void setLevel(Level newLevel);
+
+    Level level;
+    Level maxLevel;
+    float averageWorkMs;
+    float overSince;           // < 0 while not over budget
+    float underSince;          // < 0 while not under the restore threshold
+    float lastRestoreTime;
+    float restoreBackoff;      // Multiplies the restore hold, 1-16
+    unsigned long transitionCount;
+};
@@ -0,0 +1,224 @@
+#include "FrameProfiler.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const char* STAGE_NAMES[FrameProfiler::STAGE_COUNT] = {
+    "Frame",
+    "Update",
+    "Video",
+    "Detection",
+    "Inference",
+    "Tracking",
+    "Crossing",
+    "Lines",
+    "Communication",
+    "Config",
+    "Draw",
+    "Draw Video",
+    "Draw Lines",
+    "Draw Detections",
+    "GUI",
+    "MIDI Dispatch",
+};
+
+// Which ring the calling thread writes, and how deep its open scopes are
+struct ThreadState {
+    const FrameProfiler* owner = nullptr;
+    int slot = -1;
+    int depth = 0;
+};
+thread_local ThreadState threadState;
+
+string escapeJSON(const string& text) {
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        if ((unsigned char)c >= 0x20) {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+}
+
+FrameProfiler::Scope::Scope(FrameProfiler* owner, Stage timedStage) {
+    profiler = owner && owner->isEnabled() ? owner : nullptr;
+    stage = timedStage;
+    startMicros = 0;
+    if (profiler) {
+        threadState.depth++;
+        startMicros = ofGetElapsedTimeMicros();
+    }
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (profiler) {
+        threadState.depth--;
+        profiler->record(stage, startMicros, ofGetElapsedTimeMicros());
+    }
+}
+
+FrameProfiler::FrameProfiler() : rings(new Ring[MAX_THREADS]) {
+    enabled = true;
+    threadCount = 0;
+    for (int i = 0; i < MAX_THREADS; i++) {
+        rings[i].written = 0;
+        rings[i].named = false;
+        rings[i].name[0] = '\0';
+    }
+    frameStartMicros = 0;
+    frameCursor = 0;
+    frameCount = 0;
+    std::fill(frameTimes, frameTimes + FRAME_HISTORY, 0.0f);
+}
+
+void FrameProfiler::beginFrame() {
+    uint64_t now = ofGetElapsedTimeMicros();
+    if (frameStartMicros > 0 && isEnabled()) {
+        record(STAGE_FRAME, frameStartMicros, now);
+        frameTimes[frameCursor] = (now - frameStartMicros) / 1000.0f;
+        frameCursor = (frameCursor + 1) % FRAME_HISTORY;
+        frameCount = std::min(frameCount + 1, FRAME_HISTORY);
+    }
+    frameStartMicros = now;
+}
+
+void FrameProfiler::record(Stage stage, uint64_t startMicros, uint64_t endMicros) {
+    if (!isEnabled() || endMicros < startMicros) return;
+
+    int slot = getThreadSlot();
+    if (slot >= 0) {
+        push(slot, stage, threadState.depth, startMicros, endMicros);
+    }
+    histograms[stage].record(endMicros - startMicros);
+}
+
+void FrameProfiler::setThreadName(const string& name) {
+    int slot = getThreadSlot();
+    if (slot < 0) return;
+
+    Ring& ring = rings[slot];
+    strncpy(ring.name, name.c_str(), sizeof(ring.name) - 1);
+    ring.name[sizeof(ring.name) - 1] = '\0';
+    ring.named.store(true, std::memory_order_release);
+}
+
+int FrameProfiler::getThreadSlot() {
+    if (threadState.owner != this) {
+        // First event from this thread: claim the next ring. Threads are long-lived
+        // (app, scheduler, writers), so slots are never given back.
+        int slot = threadCount.fetch_add(1);
+        if (slot >= MAX_THREADS) {
+            threadCount = MAX_THREADS;
+            slot = -1;
+            ofLogWarning() << "FrameProfiler: More than " << MAX_THREADS << " threads, not recording this one";
+        }
+        threadState.owner = this;
+        threadState.slot = slot;
+    }
+    return threadState.slot;
+}
+
+void FrameProfiler::push(int slot, Stage stage, int depth, uint64_t startMicros, uint64_t endMicros) {
+    Ring& ring = rings[slot];
+    uint64_t index = ring.written.load(std::memory_order_relaxed);
+    uint64_t duration = std::min<uint64_t>(endMicros - startMicros, 0xFFFFFFFF);
+    uint64_t packed = ((uint64_t)stage << 56) | ((uint64_t)(depth & 0xFF) << 48) | duration;
+
+    // Pairs with the fence in collect(): a reader that sees any part of this event
+    // also sees the counter move past the slot's previous occupant
+    std::atomic_thread_fence(std::memory_order_release);
+    ring.starts[index % RING_SIZE].store(startMicros, std::memory_order_relaxed);
+    ring.packed[index % RING_SIZE].store(packed, std::memory_order_relaxed);
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+void FrameProfiler::collect(uint64_t sinceMicros, vector<ThreadEvents>& out) const {
+    out.clear();
+    int threads = std::min(threadCount.load(), (int)MAX_THREADS);
+    for (int slot = 0; slot < threads; slot++) {
+        const Ring& ring = rings[slot];
+        ThreadEvents thread;
+        thread.thread = slot;
+        thread.name = ring.named.load(std::memory_order_acquire) ? string(ring.name) : "Thread " + ofToString(slot);
+
+        uint64_t written = ring.written.load(std::memory_order_acquire);
+        uint64_t first = written > RING_SIZE ? written - RING_SIZE : 0;
+        vector<Event> events;
+        events.reserve(written - first);
+        for (uint64_t index = first; index < written; index++) {
+            uint64_t start = ring.starts[index % RING_SIZE].load(std::memory_order_relaxed);
+            uint64_t packed = ring.packed[index % RING_SIZE].load(std::memory_order_relaxed);
+            events.push_back({(int)(packed >> 56), (int)((packed >> 48) & 0xFF), start, (uint32_t)(packed & 0xFFFFFFFF)});
+        }
+
+        // Drop anything the writer may have overwritten while we copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring.written.load(std::memory_order_relaxed);
+        uint64_t firstValid = after >= RING_SIZE ? after - RING_SIZE + 1 : 0;
+        size_t skip = firstValid > first ? std::min<size_t>(firstValid - first, events.size()) : 0;
+
+        for (size_t i = skip; i < events.size(); i++) {
+            if (events[i].startMicros + events[i].durationMicros >= sinceMicros) {
+                thread.events.push_back(events[i]);
+            }
+        }
+        out.push_back(std::move(thread));
+    }
+}
+
+void FrameProfiler::getFrameTimes(vector<float>& out) const {
+    out.clear();
+    for (int i = 0; i < frameCount; i++) {
+        out.push_back(frameTimes[(frameCursor - frameCount + i + FRAME_HISTORY) % FRAME_HISTORY]);
+    }
+}
+
+void FrameProfiler::resetStats() {
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        histograms[stage].reset();
+    }
+}
+
+bool FrameProfiler::exportChromeTrace(const string& path) const {
+    vector<ThreadEvents> threads;
+    collect(0, threads);
+
+    std::ofstream out(path);
+    if (!out) {
+        ofLogError() << "FrameProfiler: Could not write trace to " << path;
+        return false;
+    }
+
+    // Trace Event Format: complete ("X") events in microseconds, one tid per ring
+    size_t eventCount = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SonifyV1\"}}";
+    for (const ThreadEvents& thread : threads) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.thread
+            << ",\"args\":{\"name\":\"" << escapeJSON(thread.name) << "\"}}";
+        for (const Event& event : thread.events) {
+            out << ",\n{\"name\":\"" << getStageName(event.stage) << "\",\"cat\":\"stage\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << thread.thread << ",\"ts\":" << event.startMicros << ",\"dur\":" << event.durationMicros << "}";
+        }
+        eventCount += thread.events.size();
+    }
+    out << "\n]}\n";
+    out.close();
+
+    if (!out) {
+        ofLogError() << "FrameProfiler: Could not write trace to " << path;
+        return false;
+    }
+    ofLogNotice() << "FrameProfiler: Exported " << eventCount << " events to " << path;
+    return true;
+}
+
+const char* FrameProfiler::getStageName(int stage) {
+    return stage >= 0 && stage < STAGE_COUNT ? STAGE_NAMES[stage] : "Unknown";
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ofMain.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+
+// Per-stage frame profiler. Scoped timers record {stage, start, duration} into one ring
+// buffer per thread - each ring has a single writer and is read without locks - and into
+// a LatencyHistogram per stage for p50/p95/p99. The rings hold the last few seconds of
+// events for the UI timeline and for export as Chrome trace JSON (chrome://tracing or
+// ui.perfetto.dev).
+class FrameProfiler {
+public:
+    enum Stage {
+        STAGE_FRAME = 0,        // Update start to the next update start, vsync included
+        STAGE_UPDATE,
+        STAGE_VIDEO,            // Capture and decode
+        STAGE_DETECTION,
+        STAGE_INFERENCE,
+        STAGE_TRACKING,
+        STAGE_CROSSING,
+        STAGE_LINES,
+        STAGE_COMMUNICATION,    // MIDI/OSC sends and note-offs on the app thread
+        STAGE_CONFIG,
+        STAGE_DRAW,
+        STAGE_DRAW_VIDEO,
+        STAGE_DRAW_LINES,
+        STAGE_DRAW_DETECTIONS,
+        STAGE_GUI,
+        STAGE_MIDI_DISPATCH,    // Scheduled MIDI messages on the scheduler thread
+        STAGE_COUNT
+    };
+
+    static const int MAX_THREADS = 8;
+    static const int RING_SIZE = 16384;          // Events per thread, ~20 s at 60 fps
+    static const int FRAME_HISTORY = 240;
+
+    struct Event {
+        int stage;
+        int depth;              // Nesting level on its thread
+        uint64_t startMicros;   // ofGetElapsedTimeMicros
+        uint32_t durationMicros;
+    };
+
+    struct ThreadEvents {
+        int thread;
+        string name;
+        vector<Event> events;   // Oldest first
+    };
+
+    // Times the enclosing block. A null or disabled profiler records nothing.
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler, Stage stage);
+        ~Scope();
+    private:
+        FrameProfiler* profiler;
+        Stage stage;
+        uint64_t startMicros;
+    };
+
+    FrameProfiler();
+
+    // Call at the top of ofApp::update; records the previous frame
+    void beginFrame();
+
+    // For stages timed elsewhere (e.g. with existing stopwatches)
+    void record(Stage stage, uint64_t startMicros, uint64_t endMicros);
+
+    // Label for the calling thread's lane in the timeline and trace
+    void setThreadName(const string& name);
+
+    void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Events that ended at or after sinceMicros, per thread
+    void collect(uint64_t sinceMicros, vector<ThreadEvents>& out) const;
+
+    // Frame durations in ms, oldest first (app thread only)
+    void getFrameTimes(vector<float>& out) const;
+
+    const LatencyHistogram& getHistogram(Stage stage) const { return histograms[stage]; }
+    void resetStats();
+
+    // Everything still in the rings; returns false if the file could not be written
+    bool exportChromeTrace(const string& path) const;
+
+    static const char* getStageName(int stage);
+
+private:
+    // Two words per event so readers never see a torn write without locking
+    struct Ring {
+        std::atomic<uint64_t> starts[RING_SIZE];
+        std::atomic<uint64_t> packed[RING_SIZE];   // stage << 56 | depth << 48 | duration
+        std::atomic<uint64_t> written;
+        std::atomic<bool> named;
+        char name[32];
+    };
+
+    int getThreadSlot();        // -1 once all slots are taken
+    void push(int slot, Stage stage, int depth, uint64_t startMicros, uint64_t endMicros);
+
+    std::atomic<bool> enabled;
+    std::atomic<int> threadCount;
+    std::unique_ptr<Ring[]> rings;
+    LatencyHistogram histograms[STAGE_COUNT];
+
+    uint64_t frameStartMicros;
+    float frameTimes[FRAME_HISTORY];
+    int frameCursor;
+    int frameCount;
+};
@@ -0,0 +1,159 @@
+#include "FrameSkipController.h"
+
+FrameSkipController::FrameSkipController() {
+    setDefaults();
+}
+
+void FrameSkipController::setDefaults() {
+    enabled = false;
+    frameBudgetMs = 33.3f;      // 30 fps
+    latencyBudgetMs = 150.0f;
+    minSkip = 1;
+    maxSkip = 10;
+    busyObjectCount = 8;
+    hysteresisFrames = 45;      // ~1.5 seconds at 30fps
+
+    frameSkip = 3;
+    reset();
+}
+
+void FrameSkipController::reset() {
+    targetSkip = frameSkip;
+    minSkipForFrameBudget = minSkip;
+    maxSkipForLatency = maxSkip;
+    budgetConflict = false;
+
+    baseFrameMs = 0.0f;
+    averageFrameMs = 0.0f;
+    inferenceMs = 0.0f;
+    activityLevel = 0.0f;
+    previousFrameRanDetector = false;
+    hasInference = false;
+
+    pendingFrames = 0;
+    pendingDirection = 0;
+    changeCount = 0;
+}
+
+void FrameSkipController::setFrameSkip(int skip) {
+    frameSkip = ofClamp(skip, 1, std::max(1, maxSkip));
+    targetSkip = frameSkip;
+    pendingFrames = 0;
+    pendingDirection = 0;
+}
+
+void FrameSkipController::update(float lastFrameMs, bool detectorRan, float currentInferenceMs, int activeObjects) {
+    // The previous frame's duration belongs to the previous frame's detector decision
+    if (lastFrameMs > 0.0f) {
+        averageFrameMs = averageFrameMs > 0.0f ? averageFrameMs * 0.95f + lastFrameMs * 0.05f : lastFrameMs;
+        if (!previousFrameRanDetector) {
+            baseFrameMs = baseFrameMs > 0.0f ? baseFrameMs * 0.95f + lastFrameMs * 0.05f : lastFrameMs;
+        }
+    }
+    previousFrameRanDetector = detectorRan;
+
+    if (detectorRan) {
+        inferenceMs = hasInference ? inferenceMs * 0.8f + currentInferenceMs * 0.2f : currentInferenceMs;
+        hasInference = true;
+
+        float activity = busyObjectCount > 0 ? ofClamp(activeObjects / (float)busyObjectCount, 0.0f, 1.0f) : 1.0f;
+        activityLevel = activityLevel * 0.8f + activity * 0.2f;
+    }
+
+    if (!enabled || !hasInference || baseFrameMs <= 0.0f) {
+        return;
+    }
+
+    int lowest = std::max(1, minSkip);
+    int highest = std::max(lowest, maxSkip);
+
+    // Shortest cadence that keeps the average frame time inside the budget
+    float headroomMs = frameBudgetMs - baseFrameMs;
+    if (headroomMs <= 0.0f) {
+        minSkipForFrameBudget = highest;
+    } else {
+        minSkipForFrameBudget = ofClamp((int)ceil(inferenceMs / headroomMs), lowest, highest);
+    }
+
+    // Longest cadence that keeps the newest detection young enough
+    float intervalMs = std::max(averageFrameMs, 1.0f);
+    maxSkipForLatency = ofClamp((int)floor((latencyBudgetMs - inferenceMs) / intervalMs), lowest, highest);
+
+    // When the budgets cannot both be met, keep the render loop inside its budget -
+    // a stalled frame delays every downstream event as well
+    budgetConflict = minSkipForFrameBudget > maxSkipForLatency;
+    if (budgetConflict) {
+        targetSkip = minSkipForFrameBudget;
+    } else {
+        float span = maxSkipForLatency - minSkipForFrameBudget;
+        targetSkip = (int)roundf(maxSkipForLatency - activityLevel * span);
+    }
+
+    // Hysteresis - move one step once the target has held long enough.
+    // Budget violations react four times faster than comfort adjustments.
+    int direction = targetSkip > frameSkip ? 1 : (targetSkip < frameSkip ? -1 : 0);
+    if (direction == 0) {
+        pendingFrames = 0;
+        pendingDirection = 0;
+        return;
+    }
+
+    if (direction == pendingDirection) {
+        pendingFrames++;
+    } else {
+        pendingDirection = direction;
+        pendingFrames = 1;
+    }
+
+    bool violatingBudget = frameSkip < minSkipForFrameBudget || (!budgetConflict && frameSkip > maxSkipForLatency);
+    int requiredFrames = violatingBudget ? std::max(1, hysteresisFrames / 4) : hysteresisFrames;
+
+    if (pendingFrames >= requiredFrames) {
+        frameSkip = ofClamp(frameSkip + direction, lowest, highest);
+        pendingFrames = 0;
+        changeCount++;
+    }
+}
+
+float FrameSkipController::getDetectionHz() const {
+    if (averageFrameMs <= 0.0f || frameSkip <= 0) return 0.0f;
+    return 1000.0f / (averageFrameMs * frameSkip);
+}
+
+float FrameSkipController::getPredictedLatencyMs() const {
+    return frameSkip * averageFrameMs + inferenceMs;
+}
+
+void FrameSkipController::saveToJSON(ofxJSONElement& json) {
+    json["enabled"] = enabled;
+    json["frameBudgetMs"] = frameBudgetMs;
+    json["latencyBudgetMs"] = latencyBudgetMs;
+    json["minSkip"] = minSkip;
+    json["maxSkip"] = maxSkip;
+    json["busyObjectCount"] = busyObjectCount;
+    json["hysteresisFrames"] = hysteresisFrames;
+}
+
+void FrameSkipController::loadFromJSON(const ofxJSONElement& json) {
+    if (json.isMember("enabled")) {
+        enabled = json["enabled"].asBool();
+    }
+    if (json.isMember("frameBudgetMs")) {
+        frameBudgetMs = json["frameBudgetMs"].asFloat();
+    }
+    if (json.isMember("latencyBudgetMs")) {
+        latencyBudgetMs = json["latencyBudgetMs"].asFloat();
+    }
+    if (json.isMember("minSkip")) {
+        minSkip = std::max(1, json["minSkip"].asInt());
+    }
+    if (json.isMember("maxSkip")) {
+        maxSkip = std::max(minSkip, json["maxSkip"].asInt());
+    }
+    if (json.isMember("busyObjectCount")) {
+        busyObjectCount = json["busyObjectCount"].asInt();
+    }
+    if (json.isMember("hysteresisFrames")) {
+        hysteresisFrames = json["hysteresisFrames"].asInt();
+    }
+}
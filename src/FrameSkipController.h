@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxJSON.h"
+
+// Closed-loop controller for the detection cadence (detectionFrameSkip).
+// Inference is synchronous, so running it every N frames spreads its cost over N frames.
+// The controller measures frame time and inference time and picks N so that
+//   frame budget:    baseFrameMs + inferenceMs / N        <= frameBudgetMs
+//   latency budget:  N * frameMs + inferenceMs             <= latencyBudgetMs
+// Within that range busy scenes lean towards the shortest cadence and empty scenes
+// towards the longest. Changes move one step at a time and only after the target has
+// held for hysteresisFrames, so the cadence does not oscillate.
+class FrameSkipController {
+public:
+    FrameSkipController();
+
+    // Call once per app frame.
+    // lastFrameMs is the duration of the previous frame (ofGetLastFrameTime),
+    // inferenceMs is only read when detectorRan is true, activeObjects is the current
+    // number of detected objects.
+    void update(float lastFrameMs, bool detectorRan, float inferenceMs, int activeObjects);
+
+    int getFrameSkip() const { return frameSkip; }
+    void setFrameSkip(int skip);
+    void reset();
+
+    // Readouts
+    int getTargetSkip() const { return targetSkip; }
+    int getMinSkipForFrameBudget() const { return minSkipForFrameBudget; }
+    int getMaxSkipForLatency() const { return maxSkipForLatency; }
+    bool isBudgetConflict() const { return budgetConflict; }
+    float getBaseFrameMs() const { return baseFrameMs; }
+    float getInferenceMs() const { return inferenceMs; }
+    float getActivityLevel() const { return activityLevel; }
+    float getDetectionHz() const;
+    float getPredictedLatencyMs() const;
+    unsigned long getChangeCount() const { return changeCount; }
+
+    // Configuration methods
+    void saveToJSON(ofxJSONElement& json);
+    void loadFromJSON(const ofxJSONElement& json);
+    void setDefaults();
+
+    // Settings
+    bool enabled;
+    float frameBudgetMs;       // Average frame time to stay under (33.3 = 30 fps)
+    float latencyBudgetMs;     // Worst-case age of the newest detection
+    int minSkip;
+    int maxSkip;
+    int busyObjectCount;       // Objects at which the scene counts as fully busy
+    int hysteresisFrames;      // Frames the target must hold before the cadence moves
+
+private:
+    int frameSkip;
+    int targetSkip;
+    int minSkipForFrameBudget;
+    int maxSkipForLatency;
+    bool budgetConflict;
+
+    // Smoothed measurements
+    float baseFrameMs;         // Frames without inference
+    float averageFrameMs;      // All frames
+    float inferenceMs;
+    float activityLevel;       // 0 = empty scene, 1 = busy
+    bool previousFrameRanDetector;
+    bool hasInference;
+
+    int pendingFrames;         // Consecutive frames the target pointed the same way
+    int pendingDirection;
+    unsigned long changeCount;
+};
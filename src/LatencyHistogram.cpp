@@ -0,0 +1,90 @@
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::getBucketForMicros(uint64_t micros) {
+    if (micros < 1) {
+        return 0;
+    }
+
+    // Octave from the leading bit, sub-bucket from the next two bits
+    int octave = 63 - __builtin_clzll(micros);
+    if (octave >= OCTAVES) {
+        return BUCKET_COUNT - 1;
+    }
+    uint64_t fraction = micros - (1ULL << octave);
+    int sub = (int)((fraction * BUCKETS_PER_OCTAVE) >> octave);
+    return octave * BUCKETS_PER_OCTAVE + sub;
+}
+
+float LatencyHistogram::getBucketUpperMicros(int bucket) {
+    int octave = bucket / BUCKETS_PER_OCTAVE;
+    int sub = bucket % BUCKETS_PER_OCTAVE;
+    return ldexpf(1.0f + (sub + 1) / (float)BUCKETS_PER_OCTAVE, octave);
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets[getBucketForMicros(micros)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t previous = maxMicros.load(std::memory_order_relaxed);
+    while (micros > previous && !maxMicros.compare_exchange_weak(previous, micros, std::memory_order_relaxed)) {
+    }
+}
+
+float LatencyHistogram::getMeanMicros() const {
+    uint64_t n = getCount();
+    if (n == 0) return 0.0f;
+    return (float)((double)sum.load(std::memory_order_relaxed) / n);
+}
+
+float LatencyHistogram::getPercentileMicros(float percentile) const {
+    uint64_t n = getCount();
+    if (n == 0) return 0.0f;
+
+    uint64_t target = (uint64_t)ceil(n * ofClamp(percentile, 0.0f, 100.0f) / 100.0f);
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += getBucketCount(i);
+        if (seen >= target) {
+            return std::min(getBucketUpperMicros(i), (float)getMaxMicros());
+        }
+    }
+    return (float)getMaxMicros();
+}
+
+void LatencyHistogram::getPlotData(vector<float>& values, float& lowMicros, float& highMicros) const {
+    values.clear();
+    lowMicros = 0.0f;
+    highMicros = 0.0f;
+
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (getBucketCount(i) > 0) {
+            if (first < 0) first = i;
+            last = i;
+        }
+    }
+    if (first < 0) return;
+
+    for (int i = first; i <= last; i++) {
+        values.push_back((float)getBucketCount(i));
+    }
+    lowMicros = first > 0 ? getBucketUpperMicros(first - 1) : 0.0f;
+    highMicros = getBucketUpperMicros(last);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+
+// Lock-free log-scale latency histogram in microseconds.
+// Four buckets per power of two from 1 us to over a minute, so percentiles are
+// accurate to within ~19%. record() is safe to call from any thread.
+class LatencyHistogram {
+public:
+    static const int BUCKETS_PER_OCTAVE = 4;
+    static const int OCTAVES = 27;
+    static const int BUCKET_COUNT = BUCKETS_PER_OCTAVE * OCTAVES;
+
+    LatencyHistogram();
+
+    void record(uint64_t micros);
+    void reset();
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMaxMicros() const { return maxMicros.load(std::memory_order_relaxed); }
+    uint64_t getSumMicros() const { return sum.load(std::memory_order_relaxed); }
+    float getMeanMicros() const;
+    float getPercentileMicros(float percentile) const;   // Upper edge of the bucket holding the percentile
+
+    uint64_t getBucketCount(int bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+    static float getBucketUpperMicros(int bucket);
+    static int getBucketForMicros(uint64_t micros);
+
+    // Bucket counts trimmed to the populated range, for ImGui::PlotHistogram
+    void getPlotData(vector<float>& values, float& lowMicros, float& highMicros) const;
+
+private:
+    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> maxMicros;
+};
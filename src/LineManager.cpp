@@ -1,5 +1,6 @@
 #include "LineManager.h"
 #include "TempoManager.h"
+#include "BuiltinScales.h"
 
 LineManager::LineManager() {
     // EXACT initialization from working backup
@@ -367,18 +368,12 @@ vector<string> LineManager::getScaleNoteNames() {
 }
 
 vector<int> LineManager::getScaleIntervals(const string& scaleName) {
-    if (scaleName == "Major") {
-        return {0, 2, 4, 5, 7, 9, 11};
-    } else if (scaleName == "Minor") {
-        return {0, 2, 3, 5, 7, 8, 10};
-    } else if (scaleName == "Pentatonic") {
-        return {0, 2, 4, 7, 9};
-    } else if (scaleName == "Blues") {
-        return {0, 3, 5, 6, 7, 10};
-    } else if (scaleName == "Chromatic") {
-        return {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
-    }
-    return {0, 2, 4, 5, 7, 9, 11}; // Default to Major
+    // Same tables ScaleManager loads its built-ins from
+    const BuiltinScales::Definition* scale = BuiltinScales::find(scaleName.c_str());
+    if (!scale) {
+        scale = BuiltinScales::find("Major"); // Default to Major
+    }
+    return vector<int>(scale->semitoneIntervals, scale->semitoneIntervals + scale->semitoneCount);
 }
 
 int LineManager::getMidiNoteFromMasterScale(int lineIndex) {
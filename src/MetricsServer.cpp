@@ -0,0 +1,264 @@
+#include "MetricsServer.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0         // macOS: SO_NOSIGPIPE is set on the socket instead
+#endif
+
+namespace {
+
+void writeMetricHeader(std::ostringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+template<class T>
+void writeMetric(std::ostringstream& out, const char* name, const char* type, const char* help, T value) {
+    writeMetricHeader(out, name, type, help);
+    out << name << " " << value << "\n";
+}
+
+bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+}
+
+MetricsServer::MetricsServer() {
+    framesTotal = 0;
+    lateFramesTotal = 0;
+    videoFramesTotal = 0;
+    droppedVideoFramesTotal = 0;
+    midiEventsTotal = 0;
+    scrapesTotal = 0;
+    fps = 0.0;
+    trackedObjects = 0;
+    degradationLevel = 0;
+    midiSchedulerQueueDepth = 0;
+    activeMidiNotes = 0;
+    for (int i = 0; i < MAX_LINES; i++) {
+        lineCrossings[i] = 0;
+    }
+    overflowLineCrossings = 0;
+
+    running = false;
+    port = 0;
+    listenFd = -1;
+    wakeFds[0] = wakeFds[1] = -1;
+    startMicros = 0;
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(int listenPort, const string& bindAddress) {
+    if (running) return true;
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(listenPort);
+    if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1) {
+        ofLogError() << "MetricsServer: Invalid bind address " << bindAddress;
+        return false;
+    }
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        ofLogError() << "MetricsServer: Could not create socket";
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (::bind(listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 8) != 0) {
+        ofLogError() << "MetricsServer: Could not listen on " << bindAddress << ":" << listenPort
+                     << " (" << strerror(errno) << ")";
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    if (pipe(wakeFds) != 0) {
+        ofLogError() << "MetricsServer: Could not create wake pipe";
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    port = listenPort;
+    startMicros = ofGetElapsedTimeMicros();
+    running = true;
+    thread = std::thread(&MetricsServer::threadedFunction, this);
+    ofLogNotice() << "MetricsServer: Serving http://" << bindAddress << ":" << port << "/metrics";
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running) return;
+
+    running = false;
+    char wake = 1;
+    ssize_t written = write(wakeFds[1], &wake, 1);  // Interrupts the wait
+    (void)written;
+    thread.join();
+
+    ::close(listenFd);
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+    listenFd = -1;
+    wakeFds[0] = wakeFds[1] = -1;
+    ofLogNotice() << "MetricsServer: Stopped";
+}
+
+void MetricsServer::addHistogram(const string& name, const string& help, const LatencyHistogram* histogram) {
+    if (running) {
+        ofLogWarning() << "MetricsServer: Histograms must be added before start()";
+        return;
+    }
+    histograms.push_back({name, help, histogram});
+}
+
+void MetricsServer::countLineCrossing(int lineIndex) {
+    // Lines past MAX_LINES share one series rather than being credited to the last line
+    std::atomic<uint64_t>& counter = (lineIndex >= 0 && lineIndex < MAX_LINES) ? lineCrossings[lineIndex]
+                                                                           : overflowLineCrossings;
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricsServer::threadedFunction() {
+    while (running) {
+        struct pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) <= 0 || (fds[1].revents & POLLIN)) continue;
+
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd >= 0) {
+            serveConnection(clientFd);
+            ::close(clientFd);
+        }
+    }
+}
+
+// One request per connection; scrapers open a new one each time anyway
+void MetricsServer::serveConnection(int clientFd) {
+    struct timeval timeout = {2, 0};
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == string::npos && request.size() < 8192) {
+        ssize_t n = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return;
+        request.append(buffer, n);
+    }
+
+    string requestLine = request.substr(0, request.find("\r\n"));
+    vector<string> parts = ofSplitString(requestLine, " ");
+    string status;
+    string body;
+    string contentType = "text/plain; charset=utf-8";
+    if (parts.size() < 2 || (parts[0] != "GET" && parts[0] != "HEAD")) {
+        status = "405 Method Not Allowed";
+        body = "Only GET is supported\n";
+    } else if (parts[1] != "/metrics" && parts[1].rfind("/metrics?", 0) != 0) {
+        status = "404 Not Found";
+        body = "Metrics are at /metrics\n";
+    } else {
+        status = "200 OK";
+        contentType = "text/plain; version=0.0.4; charset=utf-8";
+        body = render();
+        scrapesTotal.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    string response = "HTTP/1.1 " + status + "\r\n"
+                      "Content-Type: " + contentType + "\r\n"
+                      "Content-Length: " + ofToString(body.size()) + "\r\n"
+                      "Connection: close\r\n\r\n";
+    if (parts.empty() || parts[0] != "HEAD") {
+        response += body;
+    }
+    sendAll(clientFd, response);
+}
+
+string MetricsServer::render() {
+    std::ostringstream out;
+    out.precision(9);
+
+    writeMetric(out, "sonify_uptime_seconds", "gauge", "Seconds since the metrics server started.",
+                (ofGetElapsedTimeMicros() - startMicros) / 1e6);
+    writeMetric(out, "sonify_frames_total", "counter", "App frames processed.",
+                framesTotal.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_frames_late_total", "counter", "App frames that took over 1.5x the target frame period.",
+                lateFramesTotal.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_fps", "gauge", "App frame rate.",
+                fps.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_video_frames_total", "counter", "New frames from the video source.",
+                videoFramesTotal.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_video_frames_dropped_total", "counter", "Video file frames decoded past without being processed.",
+                droppedVideoFramesTotal.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_tracked_objects", "gauge", "Objects currently tracked.",
+                trackedObjects.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_degradation_level", "gauge", "Frame budget degradation level, 0 = full quality.",
+                degradationLevel.load(std::memory_order_relaxed));
+
+    writeMetricHeader(out, "sonify_line_crossings_total", "counter",
+                      "Line crossings sent, by line index; lines past the first 64 are summed as line=\"overflow\".");
+    for (int i = 0; i < MAX_LINES; i++) {
+        uint64_t crossings = lineCrossings[i].load(std::memory_order_relaxed);
+        if (crossings > 0) {
+            out << "sonify_line_crossings_total{line=\"" << i << "\"} " << crossings << "\n";
+        }
+    }
+    uint64_t overflowCrossings = overflowLineCrossings.load(std::memory_order_relaxed);
+    if (overflowCrossings > 0) {
+        out << "sonify_line_crossings_total{line=\"overflow\"} " << overflowCrossings << "\n";
+    }
+
+    writeMetric(out, "sonify_midi_events_total", "counter",
+                "MIDI notes sent or scheduled, pitch bends, control changes and SysEx; note-offs and clock are not counted.",
+                midiEventsTotal.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_midi_scheduler_queue_depth", "gauge", "Tempo-synced MIDI events waiting to be sent.",
+                midiSchedulerQueueDepth.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_midi_active_notes", "gauge", "Notes waiting for their note-off.",
+                activeMidiNotes.load(std::memory_order_relaxed));
+    writeMetric(out, "sonify_metrics_scrapes_total", "counter", "Scrapes served, this one excluded.",
+                scrapesTotal.load(std::memory_order_relaxed));
+
+    // Cumulative buckets at each power of two; +Inf and _count from the same bucket
+    // reads so a scrape taken mid-record() stays self-consistent
+    for (const Histogram& entry : histograms) {
+        string name = entry.name + "_seconds";
+        writeMetricHeader(out, name.c_str(), "histogram", entry.help.c_str());
+        uint64_t cumulative = 0;
+        for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+            cumulative += entry.histogram->getBucketCount(bucket);
+            if ((bucket + 1) % LatencyHistogram::BUCKETS_PER_OCTAVE == 0 && bucket + 1 < LatencyHistogram::BUCKET_COUNT) {
+                out << name << "_bucket{le=\"" << LatencyHistogram::getBucketUpperMicros(bucket) / 1e6 << "\"} "
+                    << cumulative << "\n";
+            }
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+        out << name << "_sum " << entry.histogram->getSumMicros() / 1e6 << "\n";
+        out << name << "_count " << cumulative << "\n";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ofMain.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <thread>
+
+// Serves GET /metrics in the Prometheus text format from its own thread. Everything it
+// reports lives in atomics (or lock-free LatencyHistograms) that the app updates with
+// relaxed stores, so a scrape never takes a lock the frame loop holds and the hot paths
+// pay one uncontended atomic operation per update.
+//
+// Counters are bumped where the events happen; gauges are published once per frame by
+// ofApp. Bind to 127.0.0.1 unless the scraper runs on another machine.
+class MetricsServer {
+public:
+    static const int MAX_LINES = 64;       // Per-line crossing counters; higher indices are counted as line="overflow"
+
+    MetricsServer();
+    ~MetricsServer();
+
+    bool start(int port, const string& bindAddress = "127.0.0.1");
+    void stop();
+    bool isRunning() const { return running; }
+    int getPort() const { return port; }
+
+    // Exported as <name>_seconds histograms; register before start()
+    void addHistogram(const string& name, const string& help, const LatencyHistogram* histogram);
+
+    // Hot-path counters
+    void countLineCrossing(int lineIndex);
+
+    // Counters
+    std::atomic<uint64_t> framesTotal;
+    std::atomic<uint64_t> lateFramesTotal;         // App frames over 1.5x the target period
+    std::atomic<uint64_t> videoFramesTotal;        // New frames from the video source
+    std::atomic<uint64_t> droppedVideoFramesTotal;
+    std::atomic<uint64_t> midiEventsTotal;
+    std::atomic<uint64_t> scrapesTotal;
+
+    // Gauges
+    std::atomic<double> fps;
+    std::atomic<int> trackedObjects;
+    std::atomic<int> degradationLevel;             // FrameBudgetWatchdog::Level
+    std::atomic<int> midiSchedulerQueueDepth;
+    std::atomic<int> activeMidiNotes;
+
+private:
+    struct Histogram {
+        string name;
+        string help;
+        const LatencyHistogram* histogram;
+    };
+
+    void threadedFunction();
+    void serveConnection(int clientFd);
+    string render();
+
+    std::thread thread;
+    std::atomic<bool> running;
+    int port;
+    int listenFd;
+    int wakeFds[2];            // Pipe that interrupts accept on stop()
+    uint64_t startMicros;
+
+    vector<Histogram> histograms;
+    std::atomic<uint64_t> lineCrossings[MAX_LINES];
+    std::atomic<uint64_t> overflowLineCrossings;
+};
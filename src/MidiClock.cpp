@@ -0,0 +1,171 @@
+#include "MidiClock.h"
+#include <pthread.h>
+
+MidiClock::MidiClock() {
+    spinMicros = 2000;
+    alive = false;
+    running = false;
+    epochMicros = 0.0;
+    microsPerTick = 500000.0 / PPQN;
+    nextTick = 0;
+    resetStats();
+}
+
+MidiClock::~MidiClock() {
+    close();
+}
+
+void MidiClock::setup(Sender clockSender) {
+    if (alive) return;
+
+    sender = clockSender;
+    alive = true;
+    thread = std::thread(&MidiClock::threadedFunction, this);
+    ofLogNotice() << "MidiClock: Clock thread started";
+}
+
+void MidiClock::close() {
+    if (!alive) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) {
+            send(0xFC);
+            running = false;
+        }
+        alive = false;
+    }
+    condition.notify_all();
+    thread.join();
+}
+
+void MidiClock::start(double startMicros, double microsPerBeat) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        epochMicros = startMicros;
+        microsPerTick = microsPerBeat / PPQN;
+        nextTick = 0;
+        running = true;
+        send(0xFA);
+    }
+    condition.notify_all();
+}
+
+void MidiClock::resume(double startMicros, double microsPerBeat, int songPosition) {
+    songPosition = ofClamp(songPosition, 0, 16383);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        epochMicros = startMicros;
+        microsPerTick = microsPerBeat / PPQN;
+        nextTick = (uint64_t)songPosition * TICKS_PER_SONG_POSITION;
+
+        // Position must be set while stopped, so it goes out before Continue
+        if (sender) {
+            vector<unsigned char> position = {0xF2, (unsigned char)(songPosition & 0x7F),
+                                              (unsigned char)((songPosition >> 7) & 0x7F)};
+            sender(position);
+        }
+        running = true;
+        send(0xFB);
+    }
+    condition.notify_all();
+}
+
+void MidiClock::stop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) return;
+    running = false;
+    send(0xFC);
+}
+
+void MidiClock::setTempo(double startMicros, double microsPerBeat) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        epochMicros = startMicros;
+        microsPerTick = microsPerBeat / PPQN;
+    }
+    condition.notify_all();
+}
+
+bool MidiClock::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+MidiClock::Stats MidiClock::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void MidiClock::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = {0, 0, 0.0f, 0.0f, 0.0f};
+    squaredJitterSum = 0.0;
+}
+
+// Callers hold the mutex
+void MidiClock::send(unsigned char status) {
+    if (!sender) return;
+    vector<unsigned char> message = {status};
+    sender(message);
+}
+
+void MidiClock::threadedFunction() {
+    raiseThreadPriority();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (alive) {
+        if (!running) {
+            condition.wait(lock);
+            continue;
+        }
+
+        double due = epochMicros + nextTick * microsPerTick;
+        double now = (double)ofGetElapsedTimeMicros();
+        if (due > now + spinMicros) {
+            // Coarse sleep; transport or tempo changes wake the thread early
+            condition.wait_for(lock, std::chrono::microseconds((int64_t)(due - now) - spinMicros));
+            continue;
+        }
+        if (due > now) {
+            lock.unlock();
+            while ((double)ofGetElapsedTimeMicros() < due) {
+                std::this_thread::yield();
+            }
+            lock.lock();
+            continue;
+        }
+
+        // After a stall of more than a beat, rejoin the grid instead of bursting ticks
+        if (now - due > microsPerTick * PPQN) {
+            uint64_t currentTick = (uint64_t)((now - epochMicros) / microsPerTick);
+            stats.ticksSkipped += currentTick - nextTick;
+            nextTick = currentTick;
+            due = epochMicros + nextTick * microsPerTick;
+        }
+
+        send(0xF8);
+        nextTick++;
+
+        float jitter = (float)(now - due);
+        stats.ticksSent++;
+        stats.meanJitterMicros = stats.ticksSent == 1 ? jitter : stats.meanJitterMicros * 0.99f + jitter * 0.01f;
+        stats.maxJitterMicros = std::max(stats.maxJitterMicros, jitter);
+        squaredJitterSum += (double)jitter * jitter;
+        stats.rmsJitterMicros = (float)sqrt(squaredJitterSum / stats.ticksSent);
+    }
+}
+
+void MidiClock::raiseThreadPriority() {
+#ifdef __APPLE__
+    // Highest QoS class - scheduled ahead of the render and detection threads
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#else
+    // Real-time scheduling needs privileges; without them the thread keeps the default policy
+    sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        ofLogVerbose() << "MidiClock: Real-time priority not available";
+    }
+#endif
+}
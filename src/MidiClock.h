@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ofMain.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// MIDI beat clock (24 PPQN) and transport output, driven by TempoManager.
+// Tick n is due at epochMicros + n * microsPerTick on the ofGetElapsedTimeMicros clock.
+// Every tick is computed from that epoch instead of adding intervals, so rounding and
+// late wake-ups never accumulate into drift. Tempo changes re-anchor the epoch (the
+// TempoManager keeps the beat position continuous) and keep the tick count.
+// The thread runs at raised priority, sleeps until spinMicros before a tick and spins
+// for the rest. All clock and transport bytes go out under one lock, in order.
+class MidiClock {
+public:
+    static constexpr int PPQN = 24;
+    static constexpr int TICKS_PER_SONG_POSITION = 6;   // Song Position Pointer counts 16th notes
+
+    typedef std::function<void(vector<unsigned char>&)> Sender;
+
+    struct Stats {
+        uint64_t ticksSent;
+        uint64_t ticksSkipped;         // Dropped after falling more than a beat behind
+        float meanJitterMicros;        // Send time minus due time, EMA
+        float rmsJitterMicros;         // Since the last reset
+        float maxJitterMicros;
+    };
+
+    MidiClock();
+    ~MidiClock();
+
+    // The sender runs on the clock thread and on the caller of the transport methods
+    void setup(Sender sender);
+    void close();
+
+    // Start (0xFA), first tick at epochMicros
+    void start(double epochMicros, double microsPerBeat);
+    // Song Position Pointer then Continue (0xFB); epochMicros is the time of song position 0
+    void resume(double epochMicros, double microsPerBeat, int songPosition);
+    // Stop (0xFC)
+    void stop();
+    void setTempo(double epochMicros, double microsPerBeat);
+
+    bool isRunning() const;
+    Stats getStats() const;
+    void resetStats();
+
+    int spinMicros;
+
+private:
+    void threadedFunction();
+    void send(unsigned char status);
+    static void raiseThreadPriority();
+
+    Sender sender;
+    std::thread thread;
+    bool alive;
+    bool running;
+    double epochMicros;
+    double microsPerTick;
+    uint64_t nextTick;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+
+    Stats stats;
+    double squaredJitterSum;
+};
@@ -0,0 +1,262 @@
+#include "MidiFileRecorder.h"
+
+namespace {
+    const long TRACK_LENGTH_OFFSET = 18;   // MThd chunk (14 bytes) + "MTrk"
+    const long TRACK_DATA_OFFSET = 22;
+    const uint32_t MAX_DELTA = 0x0FFFFFFF;
+    const size_t FLUSH_EVENTS = 4096;      // Wake the writer early under heavy traffic
+    const unsigned char END_OF_TRACK[4] = {0x00, 0xFF, 0x2F, 0x00};
+
+    uint32_t bpmToMicrosPerQuarter(float bpm) {
+        return (uint32_t)ofClamp(60000000.0f / std::max(bpm, 1.0f), 1.0f, 16777215.0f);
+    }
+
+    void putBigEndian(FILE* file, uint32_t value, int bytes) {
+        for (int i = bytes - 1; i >= 0; i--) {
+            fputc((value >> (i * 8)) & 0xFF, file);
+        }
+    }
+}
+
+MidiFileRecorder::MidiFileRecorder() {
+    flushIntervalMs = 250;
+    file = nullptr;
+    recording = false;
+    trackBytes = 0;
+    startMicros = 0;
+    stopMicros = 0;
+    segmentStartMicros = 0;
+    segmentStartTick = 0.0;
+    microsPerQuarter = 500000;
+    lastTick = 0;
+    eventCount = 0;
+    bytesWritten = 0;
+}
+
+MidiFileRecorder::~MidiFileRecorder() {
+    stop();
+}
+
+bool MidiFileRecorder::start(const string& filePath, float bpm) {
+    if (recording) stop();
+
+    file = fopen(filePath.c_str(), "wb");
+    if (!file) {
+        ofLogError() << "MidiFileRecorder: Could not open " << filePath << " for writing";
+        return false;
+    }
+    path = filePath;
+
+    // Header: format 0, one track, ticks per quarter note
+    fwrite("MThd", 1, 4, file);
+    putBigEndian(file, 6, 4);
+    putBigEndian(file, 0, 2);
+    putBigEndian(file, 1, 2);
+    putBigEndian(file, TICKS_PER_QUARTER, 2);
+    fwrite("MTrk", 1, 4, file);
+    putBigEndian(file, 0, 4);
+
+    startMicros = ofGetElapsedTimeMicros();
+    stopMicros = startMicros;
+    segmentStartMicros = startMicros;
+    segmentStartTick = 0.0;
+    lastTick = 0;
+    trackBytes = 0;
+    eventCount = 0;
+    trackBuffer.clear();
+    pending.clear();
+
+    // Tempo at tick 0, then a complete (empty) track on disk straight away
+    microsPerQuarter = bpmToMicrosPerQuarter(bpm);
+    writeDelta(0);
+    writeTempo(microsPerQuarter);
+    if (!finishTrack()) {
+        fclose(file);
+        file = nullptr;
+        return false;
+    }
+
+    recording = true;
+    thread = std::thread(&MidiFileRecorder::threadedFunction, this);
+    ofLogNotice() << "MidiFileRecorder: Recording to " << path;
+    return true;
+}
+
+void MidiFileRecorder::stop() {
+    if (!recording) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        recording = false;
+    }
+    condition.notify_all();
+    thread.join();
+
+    stopMicros = ofGetElapsedTimeMicros();
+    fclose(file);
+    file = nullptr;
+    ofLogNotice() << "MidiFileRecorder: Stopped, " << eventCount << " events, " << bytesWritten << " bytes in " << path;
+}
+
+void MidiFileRecorder::recordChannelEvent(unsigned char status, unsigned char data1, unsigned char data2) {
+    if (!recording) return;
+
+    Event event;
+    event.timeMicros = ofGetElapsedTimeMicros();
+    event.microsPerQuarter = 0;
+    event.bytes[0] = status;
+    event.bytes[1] = data1 & 0x7F;
+    event.bytes[2] = data2 & 0x7F;
+    // Program change and channel pressure carry one data byte
+    int type = status & 0xF0;
+    event.length = (type == 0xC0 || type == 0xD0) ? 2 : 3;
+    queue(event);
+}
+
+void MidiFileRecorder::recordTempo(float bpm) {
+    if (!recording) return;
+
+    Event event = {};
+    event.timeMicros = ofGetElapsedTimeMicros();
+    event.microsPerQuarter = bpmToMicrosPerQuarter(bpm);
+    event.length = 0;
+    queue(event);
+}
+
+void MidiFileRecorder::recordSysEx(const vector<unsigned char>& message) {
+    if (!recording) return;
+    if (message.size() < 2 || message.front() != 0xF0) return;
+
+    Event event = {};
+    event.timeMicros = ofGetElapsedTimeMicros();
+    event.length = 0;
+    event.sysex.assign(message.begin() + 1, message.end());
+    queue(event);
+}
+
+float MidiFileRecorder::getDurationSeconds() const {
+    uint64_t end = recording ? ofGetElapsedTimeMicros() : stopMicros;
+    return (end - startMicros) / 1000000.0f;
+}
+
+void MidiFileRecorder::queue(const Event& event) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!recording) return;
+        pending.push_back(event);
+        wake = pending.size() >= FLUSH_EVENTS;
+    }
+    if (wake) condition.notify_one();
+}
+
+void MidiFileRecorder::threadedFunction() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        condition.wait_for(lock, std::chrono::milliseconds(flushIntervalMs), [this] {
+            return !recording || pending.size() >= FLUSH_EVENTS;
+        });
+        bool finished = !recording;
+
+        // Swap so callers keep queueing while this batch goes to disk
+        writing.swap(pending);
+        lock.unlock();
+        if (!writing.empty()) {
+            writeEvents(writing);
+            finishTrack();
+            writing.clear();
+        }
+        lock.lock();
+
+        if (finished) break;
+    }
+}
+
+void MidiFileRecorder::writeEvents(const vector<Event>& events) {
+    trackBuffer.clear();
+    for (const Event& event : events) {
+        // Ticks are measured from the start of the current tempo segment so rounding
+        // never accumulates. Events from different threads can arrive slightly out of
+        // order; they are written at the latest tick so far rather than going backwards.
+        uint64_t time = std::max(event.timeMicros, segmentStartMicros);
+        double tick = segmentStartTick + (double)(time - segmentStartMicros) * TICKS_PER_QUARTER / microsPerQuarter;
+        uint64_t eventTick = std::max((uint64_t)llround(tick), lastTick);
+
+        writeDelta(eventTick);
+        if (!event.sysex.empty()) {
+            writeSysEx(event.sysex);
+            eventCount++;
+        } else if (event.length == 0) {
+            writeTempo(event.microsPerQuarter);
+            segmentStartMicros = time;
+            segmentStartTick = (double)eventTick;
+            microsPerQuarter = event.microsPerQuarter;
+        } else {
+            trackBuffer.insert(trackBuffer.end(), event.bytes, event.bytes + event.length);
+            eventCount++;
+        }
+    }
+}
+
+void MidiFileRecorder::writeDelta(uint64_t tick) {
+    uint64_t delta = tick - lastTick;
+    // Split gaps too long for one delta (about 38 hours at 120 BPM) with empty text events
+    while (delta > MAX_DELTA) {
+        putVariableLength(MAX_DELTA);
+        putByte(0xFF);
+        putByte(0x01);
+        putByte(0x00);
+        delta -= MAX_DELTA;
+    }
+    putVariableLength((uint32_t)delta);
+    lastTick = tick;
+}
+
+void MidiFileRecorder::writeTempo(uint32_t tempo) {
+    putByte(0xFF);
+    putByte(0x51);
+    putByte(0x03);
+    putByte((tempo >> 16) & 0xFF);
+    putByte((tempo >> 8) & 0xFF);
+    putByte(tempo & 0xFF);
+}
+
+void MidiFileRecorder::writeSysEx(const vector<unsigned char>& data) {
+    // SMF form: F0, the length of the rest, then the rest including the closing F7
+    putByte(0xF0);
+    putVariableLength((uint32_t)data.size());
+    trackBuffer.insert(trackBuffer.end(), data.begin(), data.end());
+}
+
+bool MidiFileRecorder::finishTrack() {
+    // Overwrite the previous End of Track with the new events, close the track again
+    // and patch its length, leaving a valid file on disk
+    fseek(file, TRACK_DATA_OFFSET + (long)trackBytes, SEEK_SET);
+    fwrite(trackBuffer.data(), 1, trackBuffer.size(), file);
+    fwrite(END_OF_TRACK, 1, sizeof(END_OF_TRACK), file);
+    trackBytes += trackBuffer.size();
+    trackBuffer.clear();
+
+    fseek(file, TRACK_LENGTH_OFFSET, SEEK_SET);
+    putBigEndian(file, (uint32_t)(trackBytes + sizeof(END_OF_TRACK)), 4);
+    bool ok = fflush(file) == 0 && !ferror(file);
+    if (!ok) {
+        ofLogError() << "MidiFileRecorder: Write failed for " << path;
+    }
+
+    bytesWritten = TRACK_DATA_OFFSET + trackBytes + sizeof(END_OF_TRACK);
+    return ok;
+}
+
+void MidiFileRecorder::putVariableLength(uint32_t value) {
+    unsigned char bytes[4];
+    int count = 0;
+    do {
+        bytes[count++] = value & 0x7F;
+        value >>= 7;
+    } while (value > 0 && count < 4);
+    while (count > 1) {
+        putByte(bytes[--count] | 0x80);
+    }
+    putByte(bytes[0]);
+}
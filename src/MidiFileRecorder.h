@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Records outgoing MIDI to a Standard MIDI File (type 0, one track) as it is played.
+// Callers on any thread queue events stamped with ofGetElapsedTimeMicros; a writer
+// thread drains the queue every flushIntervalMs, so memory stays bounded however long
+// the session runs. Delta times come from those timestamps through the tempo map
+// (tempo changes are recorded as Set Tempo meta events). SysEx such as MTS tuning is
+// recorded too, so a retuned performance plays back retuned.
+//
+// After every flush the track is closed with End of Track and its length in the header
+// is patched, so the file on disk is a complete SMF at all times; a crash loses at most
+// the last flush interval.
+class MidiFileRecorder {
+public:
+    static constexpr int TICKS_PER_QUARTER = 960;
+
+    MidiFileRecorder();
+    ~MidiFileRecorder();
+
+    bool start(const string& path, float bpm);
+    void stop();
+    bool isRecording() const { return recording; }
+
+    // Thread-safe, cheap no-ops while not recording
+    void recordChannelEvent(unsigned char status, unsigned char data1, unsigned char data2);
+    void recordTempo(float bpm);
+    void recordSysEx(const vector<unsigned char>& message);   // Complete message, F0 ... F7
+
+    // Readouts
+    const string& getPath() const { return path; }
+    uint64_t getEventCount() const { return eventCount; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    float getDurationSeconds() const;
+
+    int flushIntervalMs;
+
+private:
+    struct Event {
+        uint64_t timeMicros;
+        uint32_t microsPerQuarter;     // Tempo events only
+        unsigned char bytes[3];
+        unsigned char length;          // 0 for a tempo or SysEx event
+        vector<unsigned char> sysex;   // SysEx events only, without the leading F0
+    };
+
+    void queue(const Event& event);
+    void threadedFunction();
+    void writeEvents(const vector<Event>& events);
+    void writeDelta(uint64_t tick);
+    void writeTempo(uint32_t microsPerQuarter);
+    void writeSysEx(const vector<unsigned char>& data);
+    bool finishTrack();
+
+    void putVariableLength(uint32_t value);
+    void putByte(unsigned char byte) { trackBuffer.push_back(byte); }
+
+    string path;
+    FILE* file;
+    std::thread thread;
+    std::atomic<bool> recording;
+    std::mutex mutex;
+    std::condition_variable condition;
+    vector<Event> pending;             // Filled by callers
+    vector<Event> writing;             // Drained by the writer thread
+
+    // Writer thread state
+    vector<unsigned char> trackBuffer;
+    uint64_t trackBytes;               // Event bytes in the file, End of Track excluded
+    uint64_t startMicros;
+    uint64_t segmentStartMicros;       // Current tempo segment
+    double segmentStartTick;
+    uint32_t microsPerQuarter;
+    uint64_t lastTick;
+
+    std::atomic<uint64_t> eventCount;
+    std::atomic<uint64_t> bytesWritten;
+    uint64_t stopMicros;
+};
@@ -0,0 +1,328 @@
+#include "MotionGate.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MOTIONGATE_USE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MOTIONGATE_USE_NEON 1
+#endif
+
+MotionGate::MotionGate() {
+    currentGray.resize(GRID_SIZE * GRID_SIZE, 0);
+    referenceGray.resize(GRID_SIZE * GRID_SIZE, 0);
+    blockSAD.resize(BLOCKS_PER_ROW * BLOCKS_PER_ROW, 0);
+    watchMask.resize(BLOCKS_PER_ROW * BLOCKS_PER_ROW, 1);
+    sampleWidth = 0;
+    sampleHeight = 0;
+    sampleChannels = 0;
+    maskMargin = -1.0f;
+
+    setDefaults();
+}
+
+void MotionGate::setDefaults() {
+    enabled = false;        // Opt-in: configs without a motionGate section keep running the detector every stride
+    pixelThreshold = 12.0f;
+    minMovingBlocks = 2;
+    lineMargin = 48.0f;
+    holdFrames = 30;        // ~0.5 second at 60fps
+    maxSkipFrames = 120;    // ~2 seconds at 60fps
+
+    reset();
+    resetStats();
+}
+
+void MotionGate::reset() {
+    hasReference = false;
+    framesSinceMotion = 0;
+    framesSinceRun = 0;
+    idle = false;
+    movingBlocks = 0;
+    watchedBlocks = 0;
+}
+
+void MotionGate::resetStats() {
+    strideFrames = 0;
+    skippedFrames = 0;
+    forcedRuns = 0;
+    totalGateMs = 0.0;
+    gateEvaluations = 0;
+}
+
+bool MotionGate::shouldRunDetector(const ofPixels& pixels, bool strideDue) {
+    if (!enabled) {
+        return strideDue;
+    }
+
+    bool wasIdle = idle;
+    bool motion = evaluate(pixels);
+
+    if (motion) {
+        framesSinceMotion = 0;
+    } else {
+        framesSinceMotion++;
+    }
+    idle = framesSinceMotion > holdFrames;
+    framesSinceRun++;
+
+    if (strideDue) {
+        strideFrames++;
+    }
+
+    bool run = false;
+    if (motion && wasIdle) {
+        // Motion onset - don't wait for the stride
+        run = true;
+        if (!strideDue) {
+            forcedRuns++;
+        }
+    } else if (!strideDue) {
+        run = false;
+    } else if (!idle) {
+        run = true;
+    } else if (framesSinceRun >= maxSkipFrames) {
+        // Periodic refresh so slow changes and parked objects stay in sync
+        run = true;
+    } else {
+        skippedFrames++;
+    }
+
+    return run;
+}
+
+void MotionGate::markDetectorRan() {
+    referenceGray = currentGray;
+    hasReference = true;
+    framesSinceRun = 0;
+}
+
+void MotionGate::setWatchedSegments(const vector<pair<ofPoint, ofPoint>>& segments) {
+    bool changed = segments.size() != watchedSegments.size() || lineMargin != maskMargin;
+    for (size_t i = 0; !changed && i < segments.size(); i++) {
+        changed = segments[i].first.x != watchedSegments[i].first.x ||
+                  segments[i].first.y != watchedSegments[i].first.y ||
+                  segments[i].second.x != watchedSegments[i].second.x ||
+                  segments[i].second.y != watchedSegments[i].second.y;
+    }
+
+    if (changed) {
+        watchedSegments = segments;
+        rebuildWatchMask();
+    }
+}
+
+float MotionGate::getSkipFraction() const {
+    if (strideFrames == 0) return 0.0f;
+    return (float)skippedFrames / (float)strideFrames;
+}
+
+float MotionGate::getAverageGateMs() const {
+    if (gateEvaluations == 0) return 0.0f;
+    return (float)(totalGateMs / gateEvaluations);
+}
+
+float MotionGate::getEstimatedSavedMs(float inferenceMs) const {
+    // Detector time avoided minus what the gate itself cost
+    return std::max(0.0f, (float)(skippedFrames * inferenceMs - (float)totalGateMs));
+}
+
+bool MotionGate::hasMotionInRect(const ofRectangle& displayRect) const {
+    if (!hasReference) {
+        return true;
+    }
+
+    const float blockDisplaySize = 640.0f / BLOCKS_PER_ROW;
+    int bx0 = ofClamp((int)(displayRect.x / blockDisplaySize), 0, BLOCKS_PER_ROW - 1);
+    int by0 = ofClamp((int)(displayRect.y / blockDisplaySize), 0, BLOCKS_PER_ROW - 1);
+    int bx1 = ofClamp((int)((displayRect.x + displayRect.width) / blockDisplaySize), 0, BLOCKS_PER_ROW - 1);
+    int by1 = ofClamp((int)((displayRect.y + displayRect.height) / blockDisplaySize), 0, BLOCKS_PER_ROW - 1);
+    uint32_t blockThreshold = (uint32_t)(pixelThreshold * BLOCK_SIZE * BLOCK_SIZE);
+
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            if (blockSAD[by * BLOCKS_PER_ROW + bx] > blockThreshold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool MotionGate::evaluate(const ofPixels& pixels) {
+    uint64_t startMicros = ofGetElapsedTimeMicros();
+
+    downscaleToGray(pixels);
+
+    bool motion = true;
+    if (hasReference) {
+        computeBlockSAD();
+
+        uint32_t blockThreshold = (uint32_t)(pixelThreshold * BLOCK_SIZE * BLOCK_SIZE);
+        movingBlocks = 0;
+        watchedBlocks = 0;
+        for (size_t i = 0; i < blockSAD.size(); i++) {
+            if (!watchMask[i]) continue;
+            watchedBlocks++;
+            if (blockSAD[i] > blockThreshold) {
+                movingBlocks++;
+            }
+        }
+        motion = movingBlocks >= minMovingBlocks;
+    }
+
+    totalGateMs += (ofGetElapsedTimeMicros() - startMicros) / 1000.0;
+    gateEvaluations++;
+
+    return motion;
+}
+
+void MotionGate::downscaleToGray(const ofPixels& pixels) {
+    int width = pixels.getWidth();
+    int height = pixels.getHeight();
+    int channels = pixels.getNumChannels();
+
+    // Rebuild sampling tables when the source changes (camera switch, video file, IP camera)
+    if (width != sampleWidth || height != sampleHeight || channels != sampleChannels) {
+        sampleWidth = width;
+        sampleHeight = height;
+        sampleChannels = channels;
+        sampleColumns.resize(GRID_SIZE * 2);
+        sampleRows.resize(GRID_SIZE * 2);
+
+        // Two taps per axis, half a grid cell apart, averaged as a 2x2 box to tame sensor noise
+        for (int i = 0; i < GRID_SIZE; i++) {
+            int x0 = std::min(width - 1, (int)((i + 0.25f) * width / GRID_SIZE));
+            int x1 = std::min(width - 1, (int)((i + 0.75f) * width / GRID_SIZE));
+            int y0 = std::min(height - 1, (int)((i + 0.25f) * height / GRID_SIZE));
+            int y1 = std::min(height - 1, (int)((i + 0.75f) * height / GRID_SIZE));
+            sampleColumns[i * 2] = x0 * channels;
+            sampleColumns[i * 2 + 1] = x1 * channels;
+            sampleRows[i * 2] = y0;
+            sampleRows[i * 2 + 1] = y1;
+        }
+        hasReference = false;
+    }
+
+    const unsigned char* data = pixels.getData();
+    size_t stride = (size_t)width * channels;
+
+    for (int gy = 0; gy < GRID_SIZE; gy++) {
+        const unsigned char* row0 = data + sampleRows[gy * 2] * stride;
+        const unsigned char* row1 = data + sampleRows[gy * 2 + 1] * stride;
+        unsigned char* out = &currentGray[gy * GRID_SIZE];
+
+        if (channels >= 3) {
+            for (int gx = 0; gx < GRID_SIZE; gx++) {
+                int c0 = sampleColumns[gx * 2];
+                int c1 = sampleColumns[gx * 2 + 1];
+                // Integer BT.601 luma: (77R + 150G + 29B) >> 8
+                int sum = 77 * (row0[c0] + row0[c1] + row1[c0] + row1[c1]) +
+                          150 * (row0[c0 + 1] + row0[c1 + 1] + row1[c0 + 1] + row1[c1 + 1]) +
+                          29 * (row0[c0 + 2] + row0[c1 + 2] + row1[c0 + 2] + row1[c1 + 2]);
+                out[gx] = (unsigned char)(sum >> 10);
+            }
+        } else {
+            for (int gx = 0; gx < GRID_SIZE; gx++) {
+                int c0 = sampleColumns[gx * 2];
+                int c1 = sampleColumns[gx * 2 + 1];
+                out[gx] = (unsigned char)((row0[c0] + row0[c1] + row1[c0] + row1[c1]) >> 2);
+            }
+        }
+    }
+}
+
+void MotionGate::computeBlockSAD() {
+    std::fill(blockSAD.begin(), blockSAD.end(), 0);
+
+    // Each 16-byte chunk of a grid row spans exactly two horizontal 8-pixel blocks
+    for (int y = 0; y < GRID_SIZE; y++) {
+        const unsigned char* a = &currentGray[y * GRID_SIZE];
+        const unsigned char* b = &referenceGray[y * GRID_SIZE];
+        uint32_t* rowSAD = &blockSAD[(y / BLOCK_SIZE) * BLOCKS_PER_ROW];
+
+#if defined(MOTIONGATE_USE_SSE2)
+        for (int x = 0; x < GRID_SIZE; x += 16) {
+            __m128i va = _mm_loadu_si128((const __m128i*)(a + x));
+            __m128i vb = _mm_loadu_si128((const __m128i*)(b + x));
+            __m128i sad = _mm_sad_epu8(va, vb);   // lanes: bytes 0-7 and 8-15
+            rowSAD[x / BLOCK_SIZE] += (uint32_t)_mm_cvtsi128_si32(sad);
+            rowSAD[x / BLOCK_SIZE + 1] += (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(sad, 8));
+        }
+#elif defined(MOTIONGATE_USE_NEON)
+        for (int x = 0; x < GRID_SIZE; x += 16) {
+            uint8x16_t diff = vabdq_u8(vld1q_u8(a + x), vld1q_u8(b + x));
+            uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(diff)));
+            rowSAD[x / BLOCK_SIZE] += (uint32_t)vgetq_lane_u64(sums, 0);
+            rowSAD[x / BLOCK_SIZE + 1] += (uint32_t)vgetq_lane_u64(sums, 1);
+        }
+#else
+        for (int x = 0; x < GRID_SIZE; x++) {
+            rowSAD[x / BLOCK_SIZE] += (uint32_t)std::abs((int)a[x] - (int)b[x]);
+        }
+#endif
+    }
+}
+
+void MotionGate::rebuildWatchMask() {
+    const float displaySize = 640.0f;
+    const float blockDisplaySize = displaySize / BLOCKS_PER_ROW;
+    maskMargin = lineMargin;
+    const float reach = lineMargin + blockDisplaySize * 0.7071f;  // margin plus half the block diagonal
+
+    for (int by = 0; by < BLOCKS_PER_ROW; by++) {
+        for (int bx = 0; bx < BLOCKS_PER_ROW; bx++) {
+            int index = by * BLOCKS_PER_ROW + bx;
+            if (watchedSegments.empty()) {
+                watchMask[index] = 1;
+                continue;
+            }
+
+            ofPoint center((bx + 0.5f) * blockDisplaySize, (by + 0.5f) * blockDisplaySize);
+            watchMask[index] = 0;
+
+            for (const auto& segment : watchedSegments) {
+                // Distance from block center to the segment
+                ofPoint ab = segment.second - segment.first;
+                ofPoint ap = center - segment.first;
+                float lengthSquared = ab.x * ab.x + ab.y * ab.y;
+                float t = lengthSquared > 0.0f ? ofClamp((ap.x * ab.x + ap.y * ab.y) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+                ofPoint closest = segment.first + ab * t;
+                if (center.distance(closest) <= reach) {
+                    watchMask[index] = 1;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void MotionGate::saveToJSON(ofxJSONElement& json) {
+    json["enabled"] = enabled;
+    json["pixelThreshold"] = pixelThreshold;
+    json["minMovingBlocks"] = minMovingBlocks;
+    json["lineMargin"] = lineMargin;
+    json["holdFrames"] = holdFrames;
+    json["maxSkipFrames"] = maxSkipFrames;
+}
+
+void MotionGate::loadFromJSON(const ofxJSONElement& json) {
+    if (json.isMember("enabled")) {
+        enabled = json["enabled"].asBool();
+    }
+    if (json.isMember("pixelThreshold")) {
+        pixelThreshold = json["pixelThreshold"].asFloat();
+    }
+    if (json.isMember("minMovingBlocks")) {
+        minMovingBlocks = json["minMovingBlocks"].asInt();
+    }
+    if (json.isMember("lineMargin")) {
+        lineMargin = json["lineMargin"].asFloat();
+    }
+    if (json.isMember("holdFrames")) {
+        holdFrames = json["holdFrames"].asInt();
+    }
+    if (json.isMember("maxSkipFrames")) {
+        maxSkipFrames = json["maxSkipFrames"].asInt();
+    }
+}
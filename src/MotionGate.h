@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxJSON.h"
+
+// Cheap motion gate in front of the CoreML detector.
+// Each frame is reduced to a small grayscale grid covering the 640x640 display space
+// and compared block-by-block (sum of absolute differences) against the frame the
+// detector last consumed. Only blocks near the drawn lines are watched, so an empty
+// road lets the detector idle while tracks are coasted by prediction.
+class MotionGate {
+public:
+    MotionGate();
+
+    // Decide whether the detector should run on this frame.
+    // strideDue is true when the fixed detectionFrameSkip stride would run it anyway.
+    bool shouldRunDetector(const ofPixels& pixels, bool strideDue);
+
+    // Call after the detector consumed the current frame - it becomes the new reference
+    void markDetectorRan();
+
+    // Line segments (display space) whose surroundings are watched for motion.
+    // With no segments the whole frame is watched.
+    void setWatchedSegments(const vector<pair<ofPoint, ofPoint>>& segments);
+
+    void reset();
+    void resetStats();
+
+    // True while no motion has been seen for longer than holdFrames
+    bool isIdle() const { return idle; }
+
+    // Motion anywhere inside a display-space rectangle (ignores the line mask).
+    // True when there is no reference frame yet.
+    bool hasMotionInRect(const ofRectangle& displayRect) const;
+
+    // Statistics
+    float getSkipFraction() const;
+    float getAverageGateMs() const;
+    float getEstimatedSavedMs(float inferenceMs) const;
+
+    // Configuration methods
+    void saveToJSON(ofxJSONElement& json);
+    void loadFromJSON(const ofxJSONElement& json);
+    void setDefaults();
+
+    // Settings
+    bool enabled;
+    float pixelThreshold;      // Mean absolute difference per pixel (0-255) for a block to count as moving
+    int minMovingBlocks;       // Moving blocks needed before the frame counts as motion
+    float lineMargin;          // Display pixels watched on each side of a line
+    int holdFrames;            // Keep the normal stride running this long after motion stops
+    int maxSkipFrames;         // Force a detector refresh after this many idle frames
+
+    // Last evaluation
+    int movingBlocks;
+    int watchedBlocks;
+
+    // Counters since last resetStats()
+    unsigned long strideFrames;     // Frames where the fixed stride would have run the detector
+    unsigned long skippedFrames;    // ...of which the gate skipped
+    unsigned long forcedRuns;       // Detector runs forced early by motion onset
+    double totalGateMs;
+    unsigned long gateEvaluations;
+
+private:
+    bool evaluate(const ofPixels& pixels);
+    void downscaleToGray(const ofPixels& pixels);
+    void computeBlockSAD();
+    void rebuildWatchMask();
+
+    static const int GRID_SIZE = 160;                          // 640 display px / 4
+    static const int BLOCK_SIZE = 8;                           // 32x32 display px per block
+    static const int BLOCKS_PER_ROW = GRID_SIZE / BLOCK_SIZE;
+
+    vector<unsigned char> currentGray;
+    vector<unsigned char> referenceGray;
+    bool hasReference;
+    vector<uint32_t> blockSAD;
+    vector<unsigned char> watchMask;
+    vector<pair<ofPoint, ofPoint>> watchedSegments;
+    float maskMargin;          // lineMargin the mask was built with
+
+    // Source sampling tables, rebuilt when the input size changes
+    vector<int> sampleColumns;
+    vector<int> sampleRows;
+    int sampleWidth;
+    int sampleHeight;
+    int sampleChannels;
+
+    int framesSinceMotion;
+    int framesSinceRun;
+    bool idle;
+};
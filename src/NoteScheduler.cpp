@@ -0,0 +1,134 @@
+#include "NoteScheduler.h"
+
+NoteScheduler::NoteScheduler() {
+    spinMicros = 2000;
+    nextSequence = 0;
+    running = false;
+    dispatchedCount = 0;
+    meanLatenessMicros = 0.0f;
+    maxLatenessMicros = 0.0f;
+}
+
+NoteScheduler::~NoteScheduler() {
+    stop();
+}
+
+void NoteScheduler::start(Dispatcher eventDispatcher) {
+    if (running) return;
+
+    dispatcher = eventDispatcher;
+    running = true;
+    thread = std::thread(&NoteScheduler::threadedFunction, this);
+    ofLogNotice() << "NoteScheduler: Started";
+}
+
+void NoteScheduler::stop() {
+    if (!running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    condition.notify_all();
+    thread.join();
+
+    // Release anything still sounding or about to sound; unsent note-ons are dropped
+    int flushed = 0;
+    while (!queue.empty()) {
+        if (queue.top().type == NOTE_OFF) {
+            dispatcher(queue.top());
+            flushed++;
+        }
+        queue.pop();
+    }
+    ofLogNotice() << "NoteScheduler: Stopped (" << flushed << " note-offs flushed)";
+}
+
+void NoteScheduler::schedule(uint64_t timeMicros, EventType type, int channel, int note, int value, uint32_t voice) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push({timeMicros, nextSequence++, type, channel, note, value, voice});
+    }
+    // Wake the thread in case this event is due before the one it is sleeping on
+    condition.notify_one();
+}
+
+void NoteScheduler::scheduleNote(uint64_t onMicros, int durationMs, int channel, int note, int velocity, int pitchBend,
+                                 uint32_t voice) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // An allocated channel may still hold the previous voice's bend
+        if (pitchBend != 0 || voice != 0) {
+            queue.push({onMicros, nextSequence++, PITCH_BEND, channel, note, pitchBend, voice});
+        }
+        queue.push({onMicros, nextSequence++, NOTE_ON, channel, note, velocity, voice});
+        queue.push({onMicros + (uint64_t)std::max(durationMs, 0) * 1000, nextSequence++, NOTE_OFF, channel, note, 0, voice});
+    }
+    condition.notify_one();
+}
+
+void NoteScheduler::threadedFunction() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (queue.empty()) {
+            condition.wait(lock);
+            continue;
+        }
+
+        uint64_t due = queue.top().timeMicros;
+        uint64_t now = ofGetElapsedTimeMicros();
+        if (due > now + spinMicros) {
+            // Coarse sleep; re-check afterwards since an earlier event may have been queued
+            condition.wait_for(lock, std::chrono::microseconds(due - now - spinMicros));
+            continue;
+        }
+        if (due > now) {
+            // Fine wait without the lock so the app thread can keep queueing
+            lock.unlock();
+            while (ofGetElapsedTimeMicros() < due) {
+                std::this_thread::yield();
+            }
+            lock.lock();
+            continue;
+        }
+
+        Event event = queue.top();
+        queue.pop();
+        lock.unlock();
+        uint64_t sent = ofGetElapsedTimeMicros();
+        dispatcher(event);
+        lock.lock();
+
+        float lateness = (float)(sent - event.timeMicros);
+        meanLatenessMicros = dispatchedCount == 0 ? lateness : meanLatenessMicros * 0.95f + lateness * 0.05f;
+        maxLatenessMicros = std::max(maxLatenessMicros, lateness);
+        dispatchedCount++;
+    }
+}
+
+int NoteScheduler::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int)queue.size();
+}
+
+uint64_t NoteScheduler::getDispatchedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dispatchedCount;
+}
+
+float NoteScheduler::getMeanLatenessMicros() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return meanLatenessMicros;
+}
+
+float NoteScheduler::getMaxLatenessMicros() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxLatenessMicros;
+}
+
+void NoteScheduler::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    dispatchedCount = 0;
+    meanLatenessMicros = 0.0f;
+    maxLatenessMicros = 0.0f;
+}
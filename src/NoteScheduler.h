@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofMain.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+// Timer thread that sends MIDI events at absolute times on the ofGetElapsedTimeMicros clock.
+// Tempo-synced line crossings are detected on an app frame, but their note-on and note-off
+// are queued for the quantized grid time and dispatched from here, so output timing does
+// not depend on the frame rate. The thread sleeps until spinMicros before the next event
+// and yields in a loop for the remainder, which keeps dispatch jitter well below 1 ms.
+class NoteScheduler {
+public:
+    enum EventType {
+        PITCH_BEND,
+        NOTE_ON,
+        NOTE_OFF
+    };
+
+    struct Event {
+        uint64_t timeMicros;
+        uint64_t sequence;     // Events due at the same time go out in the order they were queued
+        EventType type;
+        int channel;
+        int note;
+        int value;             // Velocity, or pitch bend -8192..8191
+        uint32_t voice;        // VoiceAllocator voice for MPE notes, 0 otherwise
+    };
+
+    typedef std::function<void(const Event&)> Dispatcher;
+
+    NoteScheduler();
+    ~NoteScheduler();
+
+    // The dispatcher runs on the scheduler thread
+    void start(Dispatcher dispatcher);
+    // Pending note-offs are sent before returning so no note is left hanging
+    void stop();
+    bool isRunning() const { return running; }
+
+    void schedule(uint64_t timeMicros, EventType type, int channel, int note, int value, uint32_t voice = 0);
+    // Pitch bend (when non-zero, or always for an allocated voice), note-on at onMicros
+    // and note-off durationMs later
+    void scheduleNote(uint64_t onMicros, int durationMs, int channel, int note, int velocity, int pitchBend = 0,
+                      uint32_t voice = 0);
+
+    // Readouts
+    int getPendingCount() const;
+    uint64_t getDispatchedCount() const;
+    float getMeanLatenessMicros() const;
+    float getMaxLatenessMicros() const;
+    void resetStats();
+
+    int spinMicros;
+
+private:
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return a.timeMicros != b.timeMicros ? a.timeMicros > b.timeMicros : a.sequence > b.sequence;
+        }
+    };
+
+    void threadedFunction();
+
+    std::priority_queue<Event, vector<Event>, Later> queue;
+    uint64_t nextSequence;
+    Dispatcher dispatcher;
+    std::thread thread;
+    std::atomic<bool> running;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+
+    // Dispatch time minus due time
+    uint64_t dispatchedCount;
+    float meanLatenessMicros;  // EMA
+    float maxLatenessMicros;
+};
@@ -0,0 +1,230 @@
+#include "ScalaIndex.h"
+#include "ScalaParser.h"
+#include <sys/stat.h>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+static const char INDEX_MAGIC[4] = {'S', 'C', 'I', 'X'};
+const char* ScalaIndex::CACHE_FILENAME = ".scala_index";
+
+template<typename T>
+static void putValue(vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool getValue(const ofBuffer& buffer, size_t& offset, T& value) {
+    if (offset + sizeof(T) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.getData() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+ScalaIndex::ScalaIndex() {
+    lastStats = {0, 0, 0, 0, 0.0f};
+}
+
+uint64_t ScalaIndex::checksum(const char* data, size_t size) {
+    // FNV-1a, 64 bit
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool ScalaIndex::isMicrotonalCents(double cents) {
+    double remainder = fmod(cents, 100.0);
+    if (remainder < 0.0) remainder += 100.0;
+    return remainder > 1.0 && remainder < 99.0;
+}
+
+void ScalaIndex::refresh(const string& directory, int threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    lastStats = {0, 0, 0, 0, 0.0f};
+
+    string dirPath = ofFilePath::addTrailingSlash(directory);
+    string cachePath = dirPath + CACHE_FILENAME;
+    loadCache(cachePath);
+
+    map<string, Entry> cached;
+    for (Entry& entry : entries) {
+        cached[entry.filename] = std::move(entry);
+    }
+    size_t cachedCount = cached.size();
+
+    // Current directory contents - size and mtime decide whether the cached entry still holds
+    vector<Entry> current;
+    ofDirectory dir(dirPath);
+    if (dir.exists()) {
+        dir.allowExt("scl");
+        dir.listDir();
+        for (size_t i = 0; i < dir.size(); i++) {
+            struct stat info;
+            if (stat(dir.getPath(i).c_str(), &info) != 0) continue;
+
+            Entry entry;
+            entry.filename = dir.getName(i);
+            entry.name = ofFilePath::removeExt(entry.filename);
+            entry.intervalCount = 0;
+            entry.flags = 0;
+            entry.checksum = 0;
+            entry.mtime = (int64_t)info.st_mtime;
+            entry.fileSize = (uint64_t)info.st_size;
+            current.push_back(entry);
+        }
+    }
+
+    vector<size_t> stale;
+    for (size_t i = 0; i < current.size(); i++) {
+        auto it = cached.find(current[i].filename);
+        if (it != cached.end() && it->second.mtime == current[i].mtime && it->second.fileSize == current[i].fileSize) {
+            current[i] = it->second;
+            lastStats.reused++;
+        } else {
+            stale.push_back(i);
+        }
+        cached.erase(current[i].filename);
+    }
+    lastStats.removed = (int)cached.size();
+
+    // Scan new and changed files on a worker pool
+    if (!stale.empty()) {
+        int workers = threadCount > 0 ? threadCount : (int)std::thread::hardware_concurrency();
+        workers = ofClamp(workers, 1, (int)stale.size());
+
+        std::atomic<size_t> next(0);
+        auto work = [&]() {
+            size_t i;
+            while ((i = next.fetch_add(1)) < stale.size()) {
+                Entry& entry = current[stale[i]];
+                scanFile(dirPath + entry.filename, entry);
+            }
+        };
+
+        vector<std::thread> pool;
+        for (int t = 1; t < workers; t++) {
+            pool.emplace_back(work);
+        }
+        work();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        lastStats.scanned = (int)stale.size();
+    }
+
+    entries = std::move(current);
+    lastStats.files = (int)entries.size();
+
+    if (lastStats.scanned > 0 || lastStats.removed > 0 || cachedCount != entries.size()) {
+        saveCache(cachePath);
+    }
+
+    lastStats.elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ofLogNotice() << "ScalaIndex: " << lastStats.files << " files (" << lastStats.reused << " cached, "
+                  << lastStats.scanned << " scanned, " << lastStats.removed << " removed) in "
+                  << lastStats.elapsedMs << " ms";
+}
+
+// Metadata only - the parsed pitches are discarded, ScaleManager parses again on first use
+void ScalaIndex::scanFile(const string& path, Entry& entry) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return;
+    string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    entry.checksum = checksum(content.data(), content.size());
+    entry.intervalCount = 0;
+    entry.flags = 0;
+
+    // One result per worker thread, so its interval storage is reused across files
+    thread_local ScalaParser::Result parsed;
+    if (!ScalaParser::parse(content, parsed)) {
+        return;
+    }
+
+    entry.intervalCount = (int)parsed.intervals.size();
+    entry.flags |= ENTRY_VALID;
+    for (const ScalaParser::Interval& interval : parsed.intervals) {
+        if (isMicrotonalCents(interval.cents)) {
+            entry.flags |= ENTRY_MICROTONAL;
+            break;
+        }
+    }
+}
+
+bool ScalaIndex::loadCache(const string& path) {
+    entries.clear();
+    if (!ofFile::doesFileExist(path, false)) {
+        return false;
+    }
+
+    ofBuffer buffer = ofBufferFromFile(path, true);
+    size_t offset = 4;
+    uint16_t version = 0;
+    uint32_t count = 0;
+    if (buffer.size() < 4 || memcmp(buffer.getData(), INDEX_MAGIC, 4) != 0 ||
+        !getValue(buffer, offset, version) || version != VERSION || !getValue(buffer, offset, count)) {
+        ofLogWarning() << "ScalaIndex: Ignoring unreadable index cache: " << path;
+        return false;
+    }
+
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Entry entry;
+        uint16_t length = 0;
+        uint16_t intervalCount = 0;
+        if (!getValue(buffer, offset, length) || offset + length > buffer.size()) break;
+        entry.filename.assign(buffer.getData() + offset, length);
+        offset += length;
+
+        if (!getValue(buffer, offset, intervalCount) || !getValue(buffer, offset, entry.flags) ||
+            !getValue(buffer, offset, entry.checksum) || !getValue(buffer, offset, entry.mtime) ||
+            !getValue(buffer, offset, entry.fileSize)) {
+            break;
+        }
+        entry.intervalCount = intervalCount;
+        entry.name = ofFilePath::removeExt(entry.filename);
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool ScalaIndex::saveCache(const string& path) const {
+    vector<char> buffer;
+    buffer.reserve(entries.size() * 48 + 16);
+    buffer.insert(buffer.end(), INDEX_MAGIC, INDEX_MAGIC + 4);
+    putValue<uint16_t>(buffer, VERSION);
+    putValue<uint32_t>(buffer, (uint32_t)entries.size());
+
+    for (const Entry& entry : entries) {
+        putValue<uint16_t>(buffer, (uint16_t)entry.filename.size());
+        buffer.insert(buffer.end(), entry.filename.begin(), entry.filename.end());
+        putValue<uint16_t>(buffer, (uint16_t)entry.intervalCount);
+        putValue<uint8_t>(buffer, entry.flags);
+        putValue<uint64_t>(buffer, entry.checksum);
+        putValue<int64_t>(buffer, entry.mtime);
+        putValue<uint64_t>(buffer, entry.fileSize);
+    }
+
+    // Write beside the cache and rename, so a crash never leaves a torn index
+    string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        ofLogWarning() << "ScalaIndex: Cannot write index cache: " << path;
+        return false;
+    }
+    out.write(buffer.data(), buffer.size());
+    out.close();
+
+    if (rename(tempPath.c_str(), path.c_str()) != 0) {
+        ofLogWarning() << "ScalaIndex: Cannot replace index cache: " << path;
+        return false;
+    }
+    return true;
+}
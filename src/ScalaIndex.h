@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Metadata index over a directory of Scala (.scl) files, cached on disk so large
+// libraries (the full Scala archive is ~5,000 files) start without parsing every file.
+// Only files whose size or mtime changed since the cached index are re-scanned, and
+// the scan runs on a pool of worker threads. Interval data is not stored - the
+// ScaleManager parses a file on first use.
+//
+// Cache layout (little-endian):
+//   "SCIX" | uint16 version | uint32 count
+//   count x { uint16 length | filename | uint16 intervalCount | uint8 flags |
+//             uint64 checksum (FNV-1a of the file) | int64 mtime | uint64 fileSize }
+class ScalaIndex {
+public:
+    static constexpr uint16_t VERSION = 2;
+    static const char* CACHE_FILENAME;
+
+    enum EntryFlags {
+        ENTRY_MICROTONAL = 1,
+        ENTRY_VALID = 2        // Header and interval count parsed
+    };
+
+    struct Entry {
+        string filename;       // Relative to the library directory
+        string name;           // Filename without extension - the scale name
+        int intervalCount;
+        uint8_t flags;
+        uint64_t checksum;
+        int64_t mtime;
+        uint64_t fileSize;
+
+        bool isMicrotonal() const { return flags & ENTRY_MICROTONAL; }
+        bool isValid() const { return flags & ENTRY_VALID; }
+    };
+
+    struct RefreshStats {
+        int files;
+        int reused;            // Unchanged since the cached index
+        int scanned;
+        int removed;
+        float elapsedMs;
+    };
+
+    ScalaIndex();
+
+    // Load the cached index (if any), revalidate against the directory and save it back
+    // when anything changed. threadCount 0 uses the hardware concurrency.
+    void refresh(const string& directory, int threadCount = 0);
+
+    const vector<Entry>& getEntries() const { return entries; }
+    const RefreshStats& getLastRefreshStats() const { return lastStats; }
+
+    static uint64_t checksum(const char* data, size_t size);
+    // A pitch more than a cent off the 12-TET grid makes the whole scale microtonal
+    static bool isMicrotonalCents(double cents);
+
+private:
+    bool loadCache(const string& path);
+    bool saveCache(const string& path) const;
+    static void scanFile(const string& path, Entry& entry);
+
+    vector<Entry> entries;     // Sorted by filename
+    RefreshStats lastStats;
+};
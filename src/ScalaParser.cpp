@@ -0,0 +1,176 @@
+#include "ScalaParser.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+void ScalaParser::Result::clear() {
+    description = std::string_view();
+    declaredCount = -1;
+    intervals.clear();
+    firstError = {0, 0, nullptr};
+    skippedLines = 0;
+}
+
+double ScalaParser::ratioToCents(uint64_t numerator, uint64_t denominator) {
+    // Separate logs keep full precision for terms beyond 2^53
+    return 1200.0 * (std::log2((double)numerator) - std::log2((double)denominator));
+}
+
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool parseDouble(const char* first, const char* last, double& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto parsed = std::from_chars(first, last, value);
+    return parsed.ec == std::errc() && parsed.ptr == last;
+#else
+    // Standard libraries without floating-point from_chars - strtod on a bounded copy
+    char buffer[64];
+    size_t length = last - first;
+    if (length == 0 || length >= sizeof(buffer)) return false;
+    memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    char* end = nullptr;
+    value = strtod(buffer, &end);
+    return end == buffer + length;
+#endif
+}
+
+bool ScalaParser::parsePitch(std::string_view token, Interval& interval, const char*& message) {
+    const char* first = token.data();
+    const char* last = first + token.size();
+
+    if (token.find('.') != std::string_view::npos) {
+        // Cents - from_chars does not take a leading '+'
+        if (*first == '+') first++;
+        if (!parseDouble(first, last, interval.cents) || !std::isfinite(interval.cents)) {
+            message = "invalid cents value";
+            return false;
+        }
+        interval.numerator = 0;
+        interval.denominator = 0;
+        return true;
+    }
+
+    // Ratio n/d, or a bare integer n meaning n/1
+    uint64_t numerator = 0;
+    uint64_t denominator = 1;
+    auto parsed = std::from_chars(first, last, numerator);
+    if (parsed.ec == std::errc::result_out_of_range) {
+        message = "ratio term too large";
+        return false;
+    }
+    if (parsed.ec != std::errc()) {
+        message = "expected cents or ratio";
+        return false;
+    }
+
+    if (parsed.ptr != last) {
+        if (*parsed.ptr != '/') {
+            message = "unexpected character in ratio";
+            return false;
+        }
+        auto parsedDenominator = std::from_chars(parsed.ptr + 1, last, denominator);
+        if (parsedDenominator.ec == std::errc::result_out_of_range) {
+            message = "ratio term too large";
+            return false;
+        }
+        if (parsedDenominator.ec != std::errc() || parsedDenominator.ptr != last) {
+            message = "invalid ratio denominator";
+            return false;
+        }
+    }
+
+    if (numerator == 0 || denominator == 0) {
+        message = "ratio must be positive";
+        return false;
+    }
+
+    interval.numerator = numerator;
+    interval.denominator = denominator;
+    interval.cents = ratioToCents(numerator, denominator);
+    return true;
+}
+
+bool ScalaParser::parse(std::string_view content, Result& result) {
+    result.clear();
+
+    bool haveDescription = false;
+    int lineNumber = 0;
+    size_t position = 0;
+
+    auto fail = [&](int column, const char* message) {
+        if (result.firstError.line == 0) {
+            result.firstError = {lineNumber > 0 ? lineNumber : 1, column, message};
+        }
+    };
+
+    while (position < content.size()) {
+        if (result.declaredCount >= 0 && (int)result.intervals.size() == result.declaredCount) {
+            break;
+        }
+
+        size_t end = content.find('\n', position);
+        if (end == std::string_view::npos) end = content.size();
+        std::string_view line = content.substr(position, end - position);
+        position = end + 1;
+        lineNumber++;
+
+        size_t start = 0;
+        while (start < line.size() && isBlank(line[start])) start++;
+        if (start < line.size() && line[start] == '!') continue;
+
+        if (!haveDescription) {
+            // Description may be empty; only a trailing CR is dropped
+            haveDescription = true;
+            size_t length = line.size();
+            if (length > 0 && line[length - 1] == '\r') length--;
+            result.description = line.substr(0, length);
+            continue;
+        }
+
+        if (start == line.size()) continue;
+
+        size_t tokenEnd = start;
+        while (tokenEnd < line.size() && !isBlank(line[tokenEnd])) tokenEnd++;
+        std::string_view token = line.substr(start, tokenEnd - start);
+
+        if (result.declaredCount < 0) {
+            int count = 0;
+            auto parsed = std::from_chars(token.data(), token.data() + token.size(), count);
+            if (parsed.ec != std::errc() || parsed.ptr != token.data() + token.size() || count < 0) {
+                fail((int)start + 1, "invalid pitch count");
+                return false;
+            }
+            result.declaredCount = count;
+            // Each pitch needs at least two bytes, so a corrupt count cannot force a huge allocation
+            result.intervals.reserve(std::min<size_t>(count, content.size() / 2 + 1));
+            continue;
+        }
+
+        Interval interval;
+        const char* message = nullptr;
+        if (parsePitch(token, interval, message)) {
+            result.intervals.push_back(interval);
+        } else {
+            fail((int)start + 1, message);
+            result.skippedLines++;
+        }
+    }
+
+    if (result.declaredCount < 0) {
+        fail(1, haveDescription ? "missing pitch count" : "empty file");
+        return false;
+    }
+    if ((int)result.intervals.size() < result.declaredCount) {
+        fail(1, "fewer pitches than declared");
+    }
+    if (result.intervals.empty()) {
+        fail(1, "no pitches");
+        return false;
+    }
+    return true;
+}
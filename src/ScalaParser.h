@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Scala (.scl) parser that works in place on the file buffer.
+// Tokens are string_views into the input, numbers go through from_chars, ratios are
+// kept as exact integers and converted to cents in double precision. Reusing one
+// Result across files makes parsing allocation-free once its vector has grown.
+// Independent of openFrameworks so it can be benchmarked and fuzzed standalone.
+//
+// Format (http://www.huygens-fokker.org/scala/scl_format.html):
+//   lines starting with '!' are comments
+//   first other line is the description (may be empty), second the pitch count,
+//   then one pitch per line: cents if it contains '.', otherwise n/d or n (= n/1).
+//   Text after the pitch value is ignored.
+class ScalaParser {
+public:
+    struct Interval {
+        double cents;
+        uint64_t numerator;        // Exact ratio, 0/0 for pitches given in cents
+        uint64_t denominator;
+
+        bool isRatio() const { return denominator != 0; }
+    };
+
+    struct Error {
+        int line;                  // 1-based, 0 when there is no error
+        int column;                // 1-based
+        const char* message;       // Static string
+    };
+
+    struct Result {
+        std::string_view description;
+        int declaredCount;
+        std::vector<Interval> intervals;
+        Error firstError;          // First problem found, fatal or not
+        int skippedLines;          // Malformed pitch lines that were skipped
+
+        void clear();
+    };
+
+    // Returns false when the file has no usable pitch data (missing or bad count, no
+    // valid pitches). Malformed pitch lines are skipped and reported in firstError.
+    // result.description points into content.
+    static bool parse(std::string_view content, Result& result);
+
+    static double ratioToCents(uint64_t numerator, uint64_t denominator);
+
+private:
+    static bool parsePitch(std::string_view token, Interval& interval, const char*& message);
+};
@@ -1,4 +1,6 @@
 #include "ScaleManager.h"
+#include "ScalaParser.h"
+#include "LineManager.h"
 #include <sstream>
 #include <fstream>
 #include <iomanip>
@@ -7,8 +9,24 @@
 
 ScaleManager::ScaleManager() {
     currentScaleName = "Major";
+    currentScaleHandle = INVALID_SCALE;
     microtonalityEnabled = true;
     scalaDirectory = ofToDataPath("scales/");
+    customScalesPath = ofToDataPath("custom_scales.json");
+    lineManager = nullptr;
+    tuningMode = TUNING_PITCH_BEND;
+    mtsFormat = MTS_BULK_DUMP;
+    
+    // Start from plain 12-TET, which is what the synth plays before any dump
+    tuning.handle = INVALID_SCALE;
+    tuning.rootNote = 0;
+    tuning.revision = 0;
+    for (int key = 0; key < 128; key++) {
+        tuning.keyPitch[key] = key;
+    }
+    tuning.mappedKeys = 0;
+    tuning.unmappedPitches = 0;
+    tuning.sendPending = false;
 }
 
 ScaleManager::~ScaleManager() {
@@ -25,13 +43,12 @@ void ScaleManager::setup() {
     // Initialize all built-in scales
     initializeBuiltinScales();
     
-    // Load any existing Scala files
-    vector<string> scalaFiles = getScalaFilesInDirectory(scalaDirectory);
-    for (const string& file : scalaFiles) {
-        loadScalaFile(scalaDirectory + file);
-    }
+    // Register the Scala library from its metadata index
+    loadScalaLibrary(scalaDirectory);
+    
+    loadCustomScales();
     
-    ofLogNotice() << "ScaleManager: Setup complete - " << scales.size() << " scales available";
+    ofLogNotice() << "ScaleManager: Setup complete - " << getScaleCount() << " scales available";
 }
 
 void ScaleManager::update() {
@@ -44,23 +61,57 @@ void ScaleManager::update() {
 
 vector<string> ScaleManager::getAvailableScaleNames() const {
     vector<string> names;
-    for (const auto& pair : scales) {
-        names.push_back(pair.first);
+    for (const Scale& scale : scales) {
+        if (scale.loaded) {
+            names.push_back(scale.name);
+        }
     }
+    sort(names.begin(), names.end());
     return names;
 }
 
+ScaleManager::ScaleHandle ScaleManager::getScaleHandle(const string& scaleName) const {
+    auto it = scaleHandles.find(scaleName);
+    if (it != scaleHandles.end() && scales[it->second].loaded) {
+        return it->second;
+    }
+    
+    // Older configs name Scala scales with their extension
+    if (scaleName.size() > 4 && scaleName.compare(scaleName.size() - 4, 4, ".scl") == 0) {
+        return getScaleHandle(scaleName.substr(0, scaleName.size() - 4));
+    }
+    return INVALID_SCALE;
+}
+
+const ScaleManager::Scale* ScaleManager::getScale(ScaleHandle handle) const {
+    if (handle < 0 || handle >= (int)scales.size() || !scales[handle].loaded) {
+        return nullptr;
+    }
+    
+    Scale& scale = scales[handle];
+    if (!scale.intervalsParsed) {
+        parseDeferredScale(scale);
+    }
+    return &scale;
+}
+
 const ScaleManager::Scale* ScaleManager::getScale(const string& scaleName) const {
-    auto it = scales.find(scaleName);
-    if (it != scales.end()) {
-        return &(it->second);
+    return getScale(getScaleHandle(scaleName));
+}
+
+size_t ScaleManager::getScaleCount() const {
+    size_t count = 0;
+    for (const Scale& scale : scales) {
+        if (scale.loaded) count++;
     }
-    return nullptr;
+    return count;
 }
 
 bool ScaleManager::setCurrentScale(const string& scaleName) {
-    if (scales.find(scaleName) != scales.end()) {
+    ScaleHandle handle = getScaleHandle(scaleName);
+    if (handle != INVALID_SCALE) {
         currentScaleName = scaleName;
+        currentScaleHandle = handle;
         ofLogNotice() << "ScaleManager: Current scale set to: " << scaleName;
         return true;
     }
@@ -99,382 +150,403 @@ vector<string> ScaleManager::getScaleNoteNames(const string& scaleName, int root
     return noteNames;
 }
 
-ScaleManager::MicrotonalNote ScaleManager::getMicrotonalNote(const string& scaleName, int scaleIndex, 
+ScaleManager::MicrotonalNote ScaleManager::getMicrotonalNote(ScaleHandle handle, int scaleIndex, 
                                                            int rootNote, int octave) const {
-    const Scale* scale = getScale(scaleName);
+    const Scale* scale = getScale(handle);
     if (!scale || scaleIndex < 0) {
         return {60, 0, 0.0f}; // Fallback to middle C
     }
     
+    // Degrees past the end of the scale play the root
+    if (scaleIndex >= scale->degreeCount) {
+        scaleIndex = 0;
+    }
+    
     MicrotonalNote result;
-    result.midiNote = scale->baseNoteMidi + rootNote + (octave * 12);
-    result.centsOffset = 0.0f;
-    result.pitchBend = 0;
+    if (octave >= 0 && octave < PITCH_TABLE_OCTAVES) {
+        result = scale->pitchTable[octave * scale->degreeCount + scaleIndex];
+    } else {
+        result = computeDegree(*scale, scaleIndex, octave);
+    }
     
-    if (scaleIndex == 0) {
-        // Root note - no offset
+    // MTS: the degree has a key of its own that the synth already plays at the exact pitch
+    if (tuningMode == TUNING_MTS && microtonalityEnabled && handle == tuning.handle && rootNote == tuning.rootNote &&
+        scale->revision == tuning.revision && octave >= 0 && octave < PITCH_TABLE_OCTAVES) {
+        const MicrotonalNote& tuned = tuning.notes[octave * scale->degreeCount + scaleIndex];
+        result.midiNote = tuned.midiNote;
+        result.pitchBend = tuned.pitchBend;
         return result;
     }
     
-    if (scaleIndex > 0 && scaleIndex <= scale->intervals.size()) {
-        const ScaleInterval& interval = scale->intervals[scaleIndex - 1];
-        result.centsOffset = interval.cents;
-        
-        // Calculate base MIDI note and pitch bend
-        int semitones = (int)(interval.cents / 100.0f);
-        float remainingCents = interval.cents - (semitones * 100.0f);
-        
-        result.midiNote += semitones;
-        
-        if (microtonalityEnabled && scale->isMicrotonal) {
-            result.pitchBend = centsToPitchBend(remainingCents);
-        }
+    result.midiNote += rootNote;
+    if (!microtonalityEnabled) {
+        result.pitchBend = 0;
     }
-    
     return result;
 }
 
-vector<int> ScaleManager::getScaleIntervals(const string& scaleName) const {
-    // Backward compatibility - return 12-tone equal temperament approximations
-    const Scale* scale = getScale(scaleName);
-    if (!scale) {
-        return {0, 2, 4, 5, 7, 9, 11}; // Major scale fallback
-    }
-    
-    vector<int> intervals = {0}; // Root
-    for (const ScaleInterval& interval : scale->intervals) {
-        if (interval.cents >= 1200.0f) break; // Don't exceed octave
-        int semitones = round(interval.cents / 100.0f);
-        intervals.push_back(semitones);
-    }
-    
-    return intervals;
+ScaleManager::MicrotonalNote ScaleManager::getMicrotonalNote(const string& scaleName, int scaleIndex, 
+                                                           int rootNote, int octave) const {
+    return getMicrotonalNote(getScaleHandle(scaleName), scaleIndex, rootNote, octave);
+}
+
+const vector<int>& ScaleManager::getScaleIntervals(ScaleHandle handle) const {
+    // Backward compatibility - 12-tone equal temperament approximations
+    static const vector<int> majorFallback = {0, 2, 4, 5, 7, 9, 11};
+    const Scale* scale = getScale(handle);
+    return scale ? scale->semitoneIntervals : majorFallback;
+}
+
+const vector<int>& ScaleManager::getScaleIntervals(const string& scaleName) const {
+    return getScaleIntervals(getScaleHandle(scaleName));
 }
 
 // =============================================================================
-// BUILT-IN SCALES
+// SCALE TABLE
 // =============================================================================
 
-void ScaleManager::initializeBuiltinScales() {
-    scales.clear();
-    
-    // Traditional Western scales (12-tone equal temperament)
-    createMajorScale();
-    createMinorScale();
-    createPentatonicScale();
-    createBluesScale();
-    createChromaticScale();
-    createDorian();
-    createPhrygian();
-    createLydian();
-    createMixolydian();
-    createAeolian();
-    createLocrian();
-    
-    // Microtonal scales
-    createJustIntonationScale();
-    createBohlenPierceScale();
-    create19ToneEqualScale();
-    create31ToneEqualScale();
-    
-    ofLogNotice() << "ScaleManager: Initialized " << scales.size() << " built-in scales";
+ScaleManager::ScaleHandle ScaleManager::addScale(Scale& scale, bool compile) {
+    if (compile && scale.intervalsParsed) {
+        compileScale(scale);
+    }
+    scale.loaded = true;
+    
+    // Same name reuses its slot so handles held elsewhere stay valid
+    auto it = scaleHandles.find(scale.name);
+    if (it != scaleHandles.end()) {
+        scales[it->second] = std::move(scale);
+        return it->second;
+    }
+    
+    ScaleHandle handle = (ScaleHandle)scales.size();
+    scaleHandles[scale.name] = handle;
+    scales.push_back(std::move(scale));
+    return handle;
 }
 
-void ScaleManager::createMajorScale() {
-    Scale scale;
-    scale.name = "Major";
-    scale.description = "Major scale (Ionian mode) - happy, bright character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
+void ScaleManager::removeScale(ScaleHandle handle) {
+    if (handle < 0 || handle >= (int)scales.size()) return;
     
-    // Major scale intervals in cents (12-tone equal temperament)
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {400.0f, 5.0f/4.0f, "major third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {900.0f, 27.0f/16.0f, "major sixth"},
-        {1100.0f, 15.0f/8.0f, "major seventh"}
-    };
-    
-    scales[scale.name] = scale;
+    Scale& scale = scales[handle];
+    scale.loaded = false;
+    scale.intervals.clear();
+    scale.pitchTable.clear();
+    scale.semitoneIntervals.clear();
+    scale.degreeCount = 1;
+    scale.revision++;
 }
 
-void ScaleManager::createMinorScale() {
-    Scale scale;
-    scale.name = "Minor";
-    scale.description = "Natural minor scale (Aeolian mode) - sad, introspective character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {800.0f, 8.0f/5.0f, "minor sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
+ScaleManager::MicrotonalNote ScaleManager::computeDegree(const Scale& scale, int degree, int octave) const {
+    MicrotonalNote note;
+    note.midiNote = scale.baseNoteMidi + (octave * 12);
+    note.centsOffset = 0.0f;
+    note.pitchBend = 0;
+    
+    if (degree > 0 && degree <= (int)scale.intervals.size()) {
+        const ScaleInterval& interval = scale.intervals[degree - 1];
+        note.centsOffset = interval.cents;
+        
+        // Calculate base MIDI note and pitch bend
+        int semitones = (int)(interval.cents / 100.0f);
+        float remainingCents = interval.cents - (semitones * 100.0f);
+        
+        note.midiNote += semitones;
+        
+        if (scale.isMicrotonal) {
+            note.pitchBend = centsToPitchBend(remainingCents);
+        }
+    }
     
-    scales[scale.name] = scale;
+    return note;
 }
 
-void ScaleManager::createPentatonicScale() {
-    Scale scale;
-    scale.name = "Pentatonic";
-    scale.description = "Major pentatonic scale - universal, folk character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {400.0f, 5.0f/4.0f, "major third"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {900.0f, 27.0f/16.0f, "major sixth"}
-    };
-    
-    scales[scale.name] = scale;
+// Indexed Scala entry used for the first time - read and compile it now
+void ScaleManager::parseDeferredScale(Scale& scale) const {
+    scale.intervalsParsed = true;
+    
+    ofBuffer buffer = ofBufferFromFile(scale.filePath);
+    scale.intervals = parseScalaContent(buffer.getText(), scale.filePath);
+    if (scale.intervals.empty()) {
+        ofLogWarning() << "ScaleManager: Invalid Scala file format: " << scale.filePath;
+    }
+    compileScale(scale);
 }
 
-void ScaleManager::createBluesScale() {
-    Scale scale;
-    scale.name = "Blues";
-    scale.description = "Blues scale - expressive, soulful character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {600.0f, 7.0f/5.0f, "tritone"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
+// Flatten every degree of every octave into one table so note lookup is a single read
+void ScaleManager::compileScale(Scale& scale) const {
+    scale.degreeCount = (int)scale.intervals.size() + 1;
+    scale.revision++;
+    
+    scale.pitchTable.clear();
+    scale.pitchTable.reserve(PITCH_TABLE_OCTAVES * scale.degreeCount);
+    for (int octave = 0; octave < PITCH_TABLE_OCTAVES; octave++) {
+        for (int degree = 0; degree < scale.degreeCount; degree++) {
+            scale.pitchTable.push_back(computeDegree(scale, degree, octave));
+        }
+    }
     
-    scales[scale.name] = scale;
+    scale.semitoneIntervals.assign(1, 0); // Root
+    for (const ScaleInterval& interval : scale.intervals) {
+        if (interval.cents >= 1200.0f) break; // Don't exceed octave
+        scale.semitoneIntervals.push_back(round(interval.cents / 100.0f));
+    }
 }
 
-void ScaleManager::createChromaticScale() {
-    Scale scale;
-    scale.name = "Chromatic";
-    scale.description = "All 12 semitones - complete chromatic spectrum";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {100.0f, pow(2.0f, 1.0f/12.0f), "minor second"},
-        {200.0f, pow(2.0f, 2.0f/12.0f), "major second"},
-        {300.0f, pow(2.0f, 3.0f/12.0f), "minor third"},
-        {400.0f, pow(2.0f, 4.0f/12.0f), "major third"},
-        {500.0f, pow(2.0f, 5.0f/12.0f), "perfect fourth"},
-        {600.0f, pow(2.0f, 6.0f/12.0f), "tritone"},
-        {700.0f, pow(2.0f, 7.0f/12.0f), "perfect fifth"},
-        {800.0f, pow(2.0f, 8.0f/12.0f), "minor sixth"},
-        {900.0f, pow(2.0f, 9.0f/12.0f), "major sixth"},
-        {1000.0f, pow(2.0f, 10.0f/12.0f), "minor seventh"},
-        {1100.0f, pow(2.0f, 11.0f/12.0f), "major seventh"}
-    };
-    
-    scales[scale.name] = scale;
+// =============================================================================
+// MIDI TUNING STANDARD
+// =============================================================================
+
+void ScaleManager::setMTSFormat(MTSFormat format) {
+    if (format != mtsFormat) {
+        mtsFormat = format;
+        invalidateTuning();
+    }
 }
 
-void ScaleManager::createDorian() {
-    Scale scale;
-    scale.name = "Dorian";
-    scale.description = "Dorian mode - minor with raised 6th, jazzy character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {900.0f, 27.0f/16.0f, "major sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
-    
-    scales[scale.name] = scale;
+void ScaleManager::invalidateTuning() {
+    // Plain 12-TET needs no resend - a newly connected synth already plays it
+    if (tuning.handle != INVALID_SCALE) {
+        tuning.sendPending = true;
+    }
 }
 
-void ScaleManager::createPhrygian() {
-    Scale scale;
-    scale.name = "Phrygian";
-    scale.description = "Phrygian mode - minor with flat 2nd, Spanish/Middle Eastern character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
+bool ScaleManager::updateTuning(ScaleHandle handle, int rootNote) {
+    const Scale* scale = getScale(handle);
+    if (!scale) {
+        handle = INVALID_SCALE;
+        rootNote = 0;
+    }
+    unsigned int revision = scale ? scale->revision : 0;
     
-    scale.intervals = {
-        {100.0f, 16.0f/15.0f, "minor second"},
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {800.0f, 8.0f/5.0f, "minor sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
+    if (handle == tuning.handle && rootNote == tuning.rootNote && revision == tuning.revision) {
+        bool pending = tuning.sendPending;
+        tuning.sendPending = false;
+        return pending;
+    }
     
-    scales[scale.name] = scale;
-}
-
-void ScaleManager::createLydian() {
-    Scale scale;
-    scale.name = "Lydian";
-    scale.description = "Lydian mode - major with raised 4th, dreamy character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
+    bool wasRetuned = tuning.handle != INVALID_SCALE;
+    tuning.handle = handle;
+    tuning.rootNote = rootNote;
+    tuning.revision = revision;
+    tuning.notes.clear();
+    tuning.mappedKeys = 0;
+    tuning.unmappedPitches = 0;
+    tuning.sendPending = false;
+    for (int key = 0; key < 128; key++) {
+        tuning.keyPitch[key] = key;
+    }
     
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {400.0f, 5.0f/4.0f, "major third"},
-        {600.0f, 45.0f/32.0f, "augmented fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {900.0f, 27.0f/16.0f, "major sixth"},
-        {1100.0f, 15.0f/8.0f, "major seventh"}
-    };
+    if (!scale) {
+        // Back to 12-TET - only worth sending if the synth was retuned before
+        return wasRetuned;
+    }
     
-    scales[scale.name] = scale;
-}
-
-void ScaleManager::createMixolydian() {
-    Scale scale;
-    scale.name = "Mixolydian";
-    scale.description = "Mixolydian mode - major with flat 7th, bluesy character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
+    // Exact pitch of every table entry, in semitones
+    size_t count = scale->pitchTable.size();
+    vector<double> pitches(count);
+    vector<int> order(count);
+    for (int octave = 0; octave < PITCH_TABLE_OCTAVES; octave++) {
+        for (int degree = 0; degree < scale->degreeCount; degree++) {
+            int index = octave * scale->degreeCount + degree;
+            double cents = degree > 0 ? scale->intervals[degree - 1].cents : 0.0;
+            pitches[index] = scale->baseNoteMidi + rootNote + octave * 12 + cents / 100.0;
+            order[index] = index;
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return fabs(pitches[a] - 63.5) < fabs(pitches[b] - 63.5);
+    });
+    
+    tuning.notes.assign(count, MicrotonalNote());
+    vector<int> keys(count, -1);
+    bool keyTaken[128] = {false};
+    for (int index : order) {
+        double pitch = pitches[index];
+        if (pitch < 0.0 || pitch >= 128.0) continue;
+        
+        // Equal pitches (an octave degree and the next root) share a key
+        int nearest = (int)round(pitch);
+        if (nearest < 128 && keyTaken[nearest] && fabs(tuning.keyPitch[nearest] - pitch) < 1e-6) {
+            keys[index] = nearest;
+            continue;
+        }
+        
+        for (int distance = 0; distance < 128 && keys[index] < 0; distance++) {
+            for (int key : {nearest - distance, nearest + distance}) {
+                if (key >= 0 && key < 128 && !keyTaken[key]) {
+                    keys[index] = key;
+                    break;
+                }
+            }
+        }
+        if (keys[index] >= 0) {
+            keyTaken[keys[index]] = true;
+            tuning.keyPitch[keys[index]] = pitch;
+            tuning.mappedKeys++;
+        }
+    }
     
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {400.0f, 5.0f/4.0f, "major third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {900.0f, 27.0f/16.0f, "major sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
+    for (size_t index = 0; index < count; index++) {
+        MicrotonalNote& note = tuning.notes[index];
+        note.centsOffset = scale->pitchTable[index].centsOffset;
+        if (keys[index] >= 0) {
+            note.midiNote = keys[index];
+            note.pitchBend = 0;
+            continue;
+        }
+        
+        // No key left - bend from the key currently tuned closest to the pitch
+        if (pitches[index] >= 0.0 && pitches[index] < 128.0) {
+            tuning.unmappedPitches++;
+        }
+        int closest = ofClamp((int)round(pitches[index]), 0, 127);
+        for (int key = 0; key < 128; key++) {
+            if (fabs(tuning.keyPitch[key] - pitches[index]) < fabs(tuning.keyPitch[closest] - pitches[index])) {
+                closest = key;
+            }
+        }
+        note.midiNote = closest;
+        note.pitchBend = centsToPitchBend((float)((pitches[index] - tuning.keyPitch[closest]) * 100.0));
+    }
     
-    scales[scale.name] = scale;
+    ofLogNotice() << "ScaleManager: MTS tuning for " << scale->name << " root " << rootNote << " - "
+                  << tuning.mappedKeys << " keys retuned, " << tuning.unmappedPitches << " pitches without a key";
+    return true;
 }
 
-void ScaleManager::createAeolian() {
-    Scale scale;
-    scale.name = "Aeolian";
-    scale.description = "Aeolian mode (Natural Minor) - melancholic character";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {200.0f, 9.0f/8.0f, "major second"},
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {700.0f, 3.0f/2.0f, "perfect fifth"},
-        {800.0f, 8.0f/5.0f, "minor sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
-    
-    scales[scale.name] = scale;
+// Three bytes per key: semitone, then 14-bit fraction of a semitone above it
+static void appendMTSFrequency(vector<unsigned char>& message, double pitch) {
+    int semitone = (int)floor(pitch);
+    int fraction = (int)round((pitch - semitone) * 16384.0);
+    if (fraction >= 16384) {
+        semitone++;
+        fraction = 0;
+    }
+    if (semitone >= 127) {
+        // 7F 7F 7F means "no change", so the top of the range stops one step short
+        semitone = 127;
+        fraction = std::min(fraction, 16382);
+    }
+    semitone = std::max(semitone, 0);
+    message.push_back((unsigned char)semitone);
+    message.push_back((unsigned char)((fraction >> 7) & 0x7F));
+    message.push_back((unsigned char)(fraction & 0x7F));
 }
 
-void ScaleManager::createLocrian() {
-    Scale scale;
-    scale.name = "Locrian";
-    scale.description = "Locrian mode - diminished character, theoretical";
-    scale.isMicrotonal = false;
-    scale.source = "builtin";
-    
-    scale.intervals = {
-        {100.0f, 16.0f/15.0f, "minor second"},
-        {300.0f, 6.0f/5.0f, "minor third"},
-        {500.0f, 4.0f/3.0f, "perfect fourth"},
-        {600.0f, 64.0f/45.0f, "diminished fifth"},
-        {800.0f, 8.0f/5.0f, "minor sixth"},
-        {1000.0f, 16.0f/9.0f, "minor seventh"}
-    };
+vector<vector<unsigned char>> ScaleManager::getTuningMessages() const {
+    const unsigned char deviceId = 0x7F;   // All devices
+    const unsigned char program = 0;
+    vector<vector<unsigned char>> messages;
+    
+    if (mtsFormat == MTS_BULK_DUMP) {
+        // F0 7E <device> 08 01 <program> <name x16> <128 x freq> <checksum> F7
+        vector<unsigned char> message = {0xF0, 0x7E, deviceId, 0x08, 0x01, program};
+        const Scale* scale = getScale(tuning.handle);
+        string name = scale ? scale->name : "12-TET";
+        for (int i = 0; i < 16; i++) {
+            char c = i < (int)name.size() ? name[i] : ' ';
+            message.push_back((c >= 32 && c < 127) ? (unsigned char)c : '?');
+        }
+        for (int key = 0; key < 128; key++) {
+            appendMTSFrequency(message, tuning.keyPitch[key]);
+        }
+        
+        unsigned char checksum = 0;
+        for (size_t i = 1; i < message.size(); i++) {
+            checksum ^= message[i];
+        }
+        message.push_back(checksum & 0x7F);
+        message.push_back(0xF7);
+        messages.push_back(message);
+    } else {
+        // F0 7F <device> 08 02 <program> <count> [key freq] x count F7 - at most 127 keys per message
+        for (int first = 0; first < 128; first += 64) {
+            vector<unsigned char> message = {0xF0, 0x7F, deviceId, 0x08, 0x02, program, 64};
+            for (int key = first; key < first + 64; key++) {
+                message.push_back((unsigned char)key);
+                appendMTSFrequency(message, tuning.keyPitch[key]);
+            }
+            message.push_back(0xF7);
+            messages.push_back(message);
+        }
+    }
     
-    scales[scale.name] = scale;
+    return messages;
 }
 
 // =============================================================================
-// MICROTONAL SCALES
+// BUILT-IN SCALES
 // =============================================================================
 
-void ScaleManager::createJustIntonationScale() {
-    Scale scale;
-    scale.name = "Just Intonation";
-    scale.description = "Just intonation major scale - pure harmonic ratios";
-    scale.isMicrotonal = true;
-    scale.source = "builtin";
-    
-    // Just intonation intervals (pure ratios)
-    scale.intervals = {
-        {ratioToCents(9.0f/8.0f), 9.0f/8.0f, "major second (9:8)"},
-        {ratioToCents(5.0f/4.0f), 5.0f/4.0f, "major third (5:4)"},
-        {ratioToCents(4.0f/3.0f), 4.0f/3.0f, "perfect fourth (4:3)"},
-        {ratioToCents(3.0f/2.0f), 3.0f/2.0f, "perfect fifth (3:2)"},
-        {ratioToCents(5.0f/3.0f), 5.0f/3.0f, "major sixth (5:3)"},
-        {ratioToCents(15.0f/8.0f), 15.0f/8.0f, "major seventh (15:8)"}
-    };
-    
-    scales[scale.name] = scale;
-}
-
-void ScaleManager::createBohlenPierceScale() {
-    Scale scale;
-    scale.name = "Bohlen-Pierce";
-    scale.description = "13-tone equal temperament, 3:1 tritave";
-    scale.isMicrotonal = true;
-    scale.source = "builtin";
+void ScaleManager::initializeBuiltinScales() {
+    // Drop every scale but keep the slots, so existing handles resolve again once reloaded
+    for (ScaleHandle handle = 0; handle < (ScaleHandle)scales.size(); handle++) {
+        removeScale(handle);
+    }
     
-    // 13 equal divisions of tritave (3:1 ratio = 1901.955 cents)
-    float tritaveCents = 1901.955f;
-    scale.intervals.clear();
-    for (int i = 1; i < 13; i++) {
-        float cents = (i * tritaveCents) / 13.0f;
-        scale.intervals.push_back({cents, pow(3.0f, i/13.0f), "BP step " + ofToString(i)});
+    // Compile-time tables (BuiltinScales.h) - copied in, nothing to compute
+    for (const BuiltinScales::Definition& definition : BuiltinScales::SCALES) {
+        addBuiltinScale(definition);
     }
     
-    scales[scale.name] = scale;
+    ofLogNotice() << "ScaleManager: Initialized " << getScaleCount() << " built-in scales";
+    
+    // Re-resolve the current scale against the rebuilt table
+    currentScaleHandle = getScaleHandle(currentScaleName);
 }
 
-void ScaleManager::create19ToneEqualScale() {
+void ScaleManager::addBuiltinScale(const BuiltinScales::Definition& definition) {
     Scale scale;
-    scale.name = "19-Tone Equal";
-    scale.description = "19 equal divisions of the octave";
-    scale.isMicrotonal = true;
+    scale.name = definition.name;
+    scale.description = definition.description;
+    scale.isMicrotonal = definition.isMicrotonal;
     scale.source = "builtin";
     
-    // 19 equal divisions of octave (1200 cents)
-    for (int i = 1; i < 19; i++) {
-        float cents = (i * 1200.0f) / 19.0f;
-        scale.intervals.push_back({cents, pow(2.0f, i/19.0f), "19ED step " + ofToString(i)});
+    scale.intervals.reserve(definition.intervalCount);
+    for (int i = 0; i < definition.intervalCount; i++) {
+        const BuiltinScales::Interval& interval = definition.intervals[i];
+        scale.intervals.push_back({interval.cents, interval.ratio, interval.description});
     }
     
-    scales[scale.name] = scale;
-}
-
-void ScaleManager::create31ToneEqualScale() {
-    Scale scale;
-    scale.name = "31-Tone Equal";
-    scale.description = "31 equal divisions of the octave - quarter-comma meantone approximation";
-    scale.isMicrotonal = true;
-    scale.source = "builtin";
-    
-    // 31 equal divisions of octave (1200 cents)
-    for (int i = 1; i < 31; i++) {
-        float cents = (i * 1200.0f) / 31.0f;
-        scale.intervals.push_back({cents, pow(2.0f, i/31.0f), "31ED step " + ofToString(i)});
+    // Same layout compileScale() produces, from the precomputed degrees
+    scale.degreeCount = definition.intervalCount + 1;
+    scale.revision++;
+    scale.pitchTable.reserve(PITCH_TABLE_OCTAVES * scale.degreeCount);
+    for (int octave = 0; octave < PITCH_TABLE_OCTAVES; octave++) {
+        for (int degree = 0; degree < scale.degreeCount; degree++) {
+            const BuiltinScales::Degree& precomputed = definition.degrees[degree];
+            MicrotonalNote note;
+            note.midiNote = scale.baseNoteMidi + octave * 12 + precomputed.semitones;
+            note.pitchBend = precomputed.pitchBend;
+            note.centsOffset = degree > 0 ? definition.intervals[degree - 1].cents : 0.0f;
+            scale.pitchTable.push_back(note);
+        }
     }
+    scale.semitoneIntervals.assign(definition.semitoneIntervals, definition.semitoneIntervals + definition.semitoneCount);
     
-    scales[scale.name] = scale;
+    addScale(scale, false);
 }
 
 // =============================================================================
 // HELPER METHODS
 // =============================================================================
 
-float ScaleManager::centsToRatio(float cents) {
+// Hashes are saved as hex strings - JSON numbers lose precision beyond 53 bits
+string ScaleManager::hashToString(uint64_t hash) {
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+uint64_t ScaleManager::stringToHash(const string& text) {
+    return strtoull(text.c_str(), nullptr, 16);
+}
+
+float ScaleManager::centsToRatio(float cents) const {
     return pow(2.0f, cents / 1200.0f);
 }
 
-float ScaleManager::ratioToCents(float ratio) {
+float ScaleManager::ratioToCents(float ratio) const {
     return 1200.0f * log2(ratio);
 }
 
@@ -517,40 +589,31 @@ void ScaleManager::saveToJSON(ofxJSONElement& json) {
     json["currentScale"] = currentScaleName;
     json["microtonalityEnabled"] = microtonalityEnabled;
     json["scalaDirectory"] = scalaDirectory;
-    
-    // Save custom scales (don't save built-in scales)
-    ofxJSONElement customScalesJson;
-    for (const auto& pair : scales) {
-        if (pair.second.source == "custom" || pair.second.source == "scala") {
-            ofxJSONElement scaleJson;
-            scaleJson["name"] = pair.second.name;
-            scaleJson["description"] = pair.second.description;
-            scaleJson["isMicrotonal"] = pair.second.isMicrotonal;
-            scaleJson["source"] = pair.second.source;
-            scaleJson["filename"] = pair.second.filename;
-            
-            ofxJSONElement intervalsJson;
-            for (size_t i = 0; i < pair.second.intervals.size(); i++) {
-                const ScaleInterval& interval = pair.second.intervals[i];
-                ofxJSONElement intervalJson;
-                intervalJson["cents"] = interval.cents;
-                intervalJson["ratio"] = interval.ratio;
-                intervalJson["description"] = interval.description;
-                intervalsJson[(int)i] = intervalJson;
-            }
-            scaleJson["intervals"] = intervalsJson;
-            customScalesJson[pair.first] = scaleJson;
+    json["tuningMode"] = (int)tuningMode;
+    json["mtsFormat"] = (int)mtsFormat;
+    
+    // Scala scales in use (the current scale and the lines' master scale) are saved as
+    // references into the library - filename and content hash, never their intervals - so
+    // the config stays the same size however large the library is. Custom scales live in
+    // their own store.
+    set<string> scalesInUse = {currentScaleName};
+    if (lineManager) {
+        scalesInUse.insert(lineManager->getMasterScale());
+    }
+    ofxJSONElement scalaScalesJson(Json::arrayValue);
+    for (const string& scaleName : scalesInUse) {
+        ScaleHandle handle = getScaleHandle(scaleName);
+        if (handle != INVALID_SCALE && scales[handle].source == "scala") {
+            ofxJSONElement referenceJson;
+            referenceJson["filename"] = scales[handle].filename;
+            referenceJson["hash"] = hashToString(scales[handle].contentHash);
+            scalaScalesJson.append(referenceJson);
         }
     }
-    json["customScales"] = customScalesJson;
+    json["scalaScales"] = scalaScalesJson;
 }
 
 void ScaleManager::loadFromJSON(const ofxJSONElement& json) {
-    if (json.isMember("currentScale")) {
-        string scaleName = json["currentScale"].asString();
-        setCurrentScale(scaleName);
-    }
-    
     if (json.isMember("microtonalityEnabled")) {
         microtonalityEnabled = json["microtonalityEnabled"].asBool();
     }
@@ -559,57 +622,88 @@ void ScaleManager::loadFromJSON(const ofxJSONElement& json) {
         scalaDirectory = json["scalaDirectory"].asString();
     }
     
-    // Load custom scales
-    if (json.isMember("customScales")) {
-        const ofxJSONElement& customScalesJson = json["customScales"];
-        for (auto it = customScalesJson.begin(); it != customScalesJson.end(); ++it) {
-            const ofxJSONElement& scaleJson = *it;
+    if (json.isMember("tuningMode")) {
+        tuningMode = (TuningMode)ofClamp(json["tuningMode"].asInt(), 0, 1);
+    }
+    if (json.isMember("mtsFormat")) {
+        setMTSFormat((MTSFormat)ofClamp(json["mtsFormat"].asInt(), 0, 1));
+    }
+    
+    // Scala references resolve against the library registered in setup(). A reference whose
+    // file is gone or changed falls back to the content hash, so a renamed file still
+    // resolves; renamed scales are remembered for the current and master scale below.
+    map<string, string> renamedScales;
+    if (json.isMember("scalaScales")) {
+        unordered_map<uint64_t, string> indexNamesByHash;    // Built on the first miss only
+        const ofxJSONElement& scalaScalesJson = json["scalaScales"];
+        for (auto it = scalaScalesJson.begin(); it != scalaScalesJson.end(); ++it) {
+            const ofxJSONElement& referenceJson = *it;
+            string filename = referenceJson.isMember("filename") ? referenceJson["filename"].asString() : "";
+            uint64_t hash = referenceJson.isMember("hash") ? stringToHash(referenceJson["hash"].asString()) : 0;
             
-            Scale scale;
-            if (scaleJson.isMember("name")) {
-                scale.name = scaleJson["name"].asString();
-            }
-            if (scaleJson.isMember("description")) {
-                scale.description = scaleJson["description"].asString();
-            }
-            if (scaleJson.isMember("isMicrotonal")) {
-                scale.isMicrotonal = scaleJson["isMicrotonal"].asBool();
-            }
-            if (scaleJson.isMember("source")) {
-                scale.source = scaleJson["source"].asString();
-            }
-            if (scaleJson.isMember("filename")) {
-                scale.filename = scaleJson["filename"].asString();
+            // Scala scales are registered under their filename without the extension
+            const Scale* byFilename = nullptr;
+            ScaleHandle handle = getScaleHandle(ofFilePath::removeExt(filename));
+            if (handle != INVALID_SCALE && scales[handle].source == "scala" && scales[handle].filename == filename) {
+                byFilename = &scales[handle];
             }
             
-            if (scaleJson.isMember("intervals")) {
-                const ofxJSONElement& intervalsJson = scaleJson["intervals"];
-                for (auto intervalIt = intervalsJson.begin(); intervalIt != intervalsJson.end(); ++intervalIt) {
-                    const ofxJSONElement& intervalJson = *intervalIt;
-                    ScaleInterval interval;
-                    if (intervalJson.isMember("cents")) {
-                        interval.cents = intervalJson["cents"].asFloat();
-                    }
-                    if (intervalJson.isMember("ratio")) {
-                        interval.ratio = intervalJson["ratio"].asFloat();
+            const Scale* byHash = nullptr;
+            if (hash != 0 && (!byFilename || byFilename->contentHash != hash)) {
+                if (indexNamesByHash.empty()) {
+                    for (const ScalaIndex::Entry& entry : scalaIndex.getEntries()) {
+                        indexNamesByHash.emplace(entry.checksum, entry.name);
                     }
-                    if (intervalJson.isMember("description")) {
-                        interval.description = intervalJson["description"].asString();
-                    }
-                    scale.intervals.push_back(interval);
+                }
+                auto entry = indexNamesByHash.find(hash);
+                ScaleHandle hashHandle = entry != indexNamesByHash.end() ? getScaleHandle(entry->second) : INVALID_SCALE;
+                if (hashHandle != INVALID_SCALE && scales[hashHandle].source == "scala") {
+                    byHash = &scales[hashHandle];
                 }
             }
             
-            if (!scale.name.empty()) {
-                scales[scale.name] = scale;
+            if (byHash) {
+                ofLogNotice() << "ScaleManager: Scala scale " << filename << " found as " << byHash->filename;
+                renamedScales[ofFilePath::removeExt(filename)] = byHash->name;
+            } else if (!byFilename) {
+                ofLogWarning() << "ScaleManager: Scala scale " << filename << " is no longer in the library";
+            } else if (hash != 0 && byFilename->contentHash != hash) {
+                ofLogWarning() << "ScaleManager: Scala scale " << filename << " changed since the config was saved";
             }
         }
     }
+    
+    // Configs from before the reference format embed every scale
+    if (json.isMember("customScales")) {
+        int migrated = migrateEmbeddedScales(json["customScales"]);
+        if (migrated > 0) {
+            ofLogNotice() << "ScaleManager: Migrated " << migrated << " scales out of the config";
+        }
+    }
+    
+    // Last, so a migrated scale can be the current one
+    if (json.isMember("currentScale")) {
+        string scaleName = json["currentScale"].asString();
+        auto renamed = renamedScales.find(scaleName);
+        if (renamed != renamedScales.end()) {
+            scaleName = renamed->second;
+        }
+        setCurrentScale(scaleName);
+    }
+    // The lines section loads first, so the master scale can still carry the old name
+    if (lineManager) {
+        auto renamed = renamedScales.find(lineManager->getMasterScale());
+        if (renamed != renamedScales.end()) {
+            lineManager->setMasterScale(renamed->second);
+        }
+    }
 }
 
 void ScaleManager::setDefaults() {
     currentScaleName = "Major";
     microtonalityEnabled = true;
+    tuningMode = TUNING_PITCH_BEND;
+    mtsFormat = MTS_BULK_DUMP;
     scalaDirectory = ofToDataPath("scales/");
     initializeBuiltinScales();
 }
@@ -633,7 +727,7 @@ bool ScaleManager::loadScalaFile(const string& filepath) {
     string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
     file.close();
     
-    vector<ScaleInterval> intervals = parseScalaContent(content);
+    vector<ScaleInterval> intervals = parseScalaContent(content, filepath);
     if (intervals.empty()) {
         ofLogWarning() << "ScaleManager: Invalid Scala file format: " << filepath;
         return false;
@@ -641,8 +735,8 @@ bool ScaleManager::loadScalaFile(const string& filepath) {
     
     // Extract filename for scale name
     size_t lastSlash = filepath.find_last_of("/\\");
-    size_t lastDot = filepath.find_last_of(".");
     string filename = (lastSlash != string::npos) ? filepath.substr(lastSlash + 1) : filepath;
+    size_t lastDot = filename.find_last_of(".");
     string scaleName = (lastDot != string::npos) ? filename.substr(0, lastDot) : filename;
     
     // Create scale
@@ -650,11 +744,19 @@ bool ScaleManager::loadScalaFile(const string& filepath) {
     scale.name = scaleName;
     scale.filename = filename;
     scale.intervals = intervals;
-    scale.isMicrotonal = true; // Assume Scala files are microtonal
+    // Same rule as the library index, so a file is flagged alike however it was loaded
+    scale.isMicrotonal = false;
+    for (const ScaleInterval& interval : intervals) {
+        if (ScalaIndex::isMicrotonalCents(interval.cents)) {
+            scale.isMicrotonal = true;
+            break;
+        }
+    }
     scale.source = "scala";
     scale.description = "Imported from " + filename;
+    scale.contentHash = ScalaIndex::checksum(content.data(), content.size());
     
-    scales[scaleName] = scale;
+    addScale(scale);
     
     ofLogNotice() << "ScaleManager: Loaded Scala file: " << scaleName 
                  << " (" << intervals.size() << " intervals)";
@@ -687,81 +789,54 @@ vector<string> ScaleManager::getScalaFilesInDirectory(const string& directory) {
     return getFilesWithExtension(directory, ".scl");
 }
 
-vector<ScaleManager::ScaleInterval> ScaleManager::parseScalaContent(const string& content) {
-    vector<ScaleInterval> intervals;
-    stringstream ss(content);
-    string line;
-    
-    bool foundDescription = false;
-    bool foundCount = false;
-    int expectedIntervals = 0;
-    int currentInterval = 0;
-    
-    while (getline(ss, line)) {
-        // Remove leading/trailing whitespace
-        line.erase(0, line.find_first_not_of(" \t"));
-        line.erase(line.find_last_not_of(" \t") + 1);
-        
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '!') {
+void ScaleManager::loadScalaLibrary(const string& directory) {
+    scalaIndex.refresh(directory);
+    
+    string directoryPath = ofFilePath::addTrailingSlash(directory);
+    int registered = 0;
+    for (const ScalaIndex::Entry& entry : scalaIndex.getEntries()) {
+        if (!entry.isValid()) {
+            ofLogWarning() << "ScaleManager: Invalid Scala file format: " << directoryPath + entry.filename;
             continue;
         }
         
-        if (!foundDescription) {
-            // First non-comment line is description
-            foundDescription = true;
-            continue;
-        }
+        Scale scale;
+        scale.name = entry.name;
+        scale.filename = entry.filename;
+        scale.filePath = directoryPath + entry.filename;
+        scale.isMicrotonal = entry.isMicrotonal();
+        scale.source = "scala";
+        scale.description = "Imported from " + entry.filename;
+        scale.intervalsParsed = false;
+        scale.contentHash = entry.checksum;
         
-        if (!foundCount) {
-            // Second non-comment line is interval count
-            try {
-                expectedIntervals = stoi(line);
-                foundCount = true;
-                continue;
-            } catch (...) {
-                ofLogWarning() << "ScaleManager: Invalid interval count in Scala file: " << line;
-                return intervals;
-            }
-        }
-        
-        // Parse interval lines
-        if (currentInterval < expectedIntervals) {
-            ScaleInterval interval;
-            interval.description = "Interval " + ofToString(currentInterval + 1);
-            
-            // Check if it's a ratio (contains '/')
-            if (line.find('/') != string::npos) {
-                // Parse ratio
-                size_t slashPos = line.find('/');
-                try {
-                    float numerator = stof(line.substr(0, slashPos));
-                    float denominator = stof(line.substr(slashPos + 1));
-                    interval.ratio = numerator / denominator;
-                    interval.cents = ratioToCents(interval.ratio);
-                } catch (...) {
-                    ofLogWarning() << "ScaleManager: Invalid ratio format: " << line;
-                    continue;
-                }
-            } else {
-                // Parse cents value
-                try {
-                    interval.cents = stof(line);
-                    interval.ratio = centsToRatio(interval.cents);
-                } catch (...) {
-                    ofLogWarning() << "ScaleManager: Invalid cents format: " << line;
-                    continue;
-                }
-            }
-            
-            intervals.push_back(interval);
-            currentInterval++;
-        }
+        addScale(scale);
+        registered++;
     }
     
-    if ((int)intervals.size() != expectedIntervals) {
-        ofLogWarning() << "ScaleManager: Scala file interval count mismatch. Expected: " 
-                      << expectedIntervals << ", Found: " << intervals.size();
+    ofLogNotice() << "ScaleManager: Registered " << registered << " Scala scales from " << directoryPath;
+}
+
+vector<ScaleManager::ScaleInterval> ScaleManager::parseScalaContent(const string& content, const string& source) const {
+    vector<ScaleInterval> intervals;
+    
+    ScalaParser::Result parsed;
+    bool valid = ScalaParser::parse(content, parsed);
+    if (parsed.firstError.line > 0) {
+        ofLogWarning() << "ScaleManager: " << source << ":" << parsed.firstError.line << ":" << parsed.firstError.column
+                      << ": " << parsed.firstError.message
+                      << (parsed.skippedLines > 1 ? " (" + ofToString(parsed.skippedLines) + " lines skipped)" : "");
+    }
+    if (!valid) {
+        return intervals;
+    }
+    
+    intervals.reserve(parsed.intervals.size());
+    for (const ScalaParser::Interval& pitch : parsed.intervals) {
+        ScaleInterval interval;
+        interval.cents = (float)pitch.cents;
+        interval.ratio = pitch.isRatio() ? (float)((double)pitch.numerator / pitch.denominator) : centsToRatio(interval.cents);
+        intervals.push_back(interval);
     }
     
     return intervals;
@@ -810,11 +885,15 @@ string ScaleManager::generateScalaContent(const Scale& scale) {
 // UTILITY METHODS
 // =============================================================================
 
-bool ScaleManager::requiresPitchBend(const string& scaleName) const {
-    const Scale* scale = getScale(scaleName);
+bool ScaleManager::requiresPitchBend(ScaleHandle handle) const {
+    const Scale* scale = getScale(handle);
     return scale ? scale->isMicrotonal : false;
 }
 
+bool ScaleManager::requiresPitchBend(const string& scaleName) const {
+    return requiresPitchBend(getScaleHandle(scaleName));
+}
+
 int ScaleManager::getScaleSize(const string& scaleName) const {
     const Scale* scale = getScale(scaleName);
     return scale ? (scale->intervals.size() + 1) : 7; // +1 for root note
@@ -855,6 +934,15 @@ bool ScaleManager::isScaleEqual(const string& scaleName) const {
 }
 
 bool ScaleManager::createCustomScale(const string& name, const vector<float>& centsIntervals, const string& description) {
+    if (!addCustomScale(name, centsIntervals, description)) {
+        return false;
+    }
+    saveCustomScales();
+    ofLogNotice() << "ScaleManager: Created custom scale: " << name;
+    return true;
+}
+
+bool ScaleManager::addCustomScale(const string& name, const vector<float>& centsIntervals, const string& description) {
     if (name.empty() || centsIntervals.empty()) {
         return false;
     }
@@ -885,21 +973,138 @@ bool ScaleManager::createCustomScale(const string& name, const vector<float>& ce
         return false;
     }
     
-    scales[name] = scale;
-    ofLogNotice() << "ScaleManager: Created custom scale: " << name;
+    addScale(scale);
     return true;
 }
 
 bool ScaleManager::deleteCustomScale(const string& name) {
-    auto it = scales.find(name);
-    if (it != scales.end() && (it->second.source == "custom" || it->second.source == "scala")) {
-        scales.erase(it);
+    const Scale* scale = getScale(name);
+    if (scale && (scale->source == "custom" || scale->source == "scala")) {
+        bool custom = scale->source == "custom";
+        removeScale(getScaleHandle(name));
+        if (custom) {
+            saveCustomScales();
+        }
         ofLogNotice() << "ScaleManager: Deleted custom scale: " << name;
         return true;
     }
     return false;
 }
 
+// Compact store: name, description and cents only - ratios, descriptions and the
+// microtonal flag are derived again by addCustomScale()
+void ScaleManager::loadCustomScales() {
+    ofxJSONElement json;
+    if (!ofFile::doesFileExist(customScalesPath, false) || !json.open(customScalesPath)) {
+        return;
+    }
+    
+    int loaded = 0;
+    const ofxJSONElement& scalesJson = json["scales"];
+    for (auto it = scalesJson.begin(); it != scalesJson.end(); ++it) {
+        const ofxJSONElement& scaleJson = *it;
+        vector<float> cents;
+        for (auto centsIt = scaleJson["cents"].begin(); centsIt != scaleJson["cents"].end(); ++centsIt) {
+            cents.push_back((*centsIt).asFloat());
+        }
+        if (addCustomScale(scaleJson["name"].asString(), cents, scaleJson["description"].asString())) {
+            loaded++;
+        }
+    }
+    ofLogNotice() << "ScaleManager: Loaded " << loaded << " custom scales from " << customScalesPath;
+}
+
+void ScaleManager::saveCustomScales() {
+    ofxJSONElement json;
+    json["version"] = 1;
+    json["scales"] = ofxJSONElement(Json::arrayValue);
+    for (const Scale& scale : scales) {
+        if (scale.loaded && scale.source == "custom") {
+            ofxJSONElement scaleJson;
+            scaleJson["name"] = scale.name;
+            scaleJson["description"] = scale.description;
+            ofxJSONElement centsJson(Json::arrayValue);
+            for (const ScaleInterval& interval : scale.intervals) {
+                centsJson.append(interval.cents);
+            }
+            scaleJson["cents"] = centsJson;
+            json["scales"].append(scaleJson);
+        }
+    }
+    
+    if (!json.save(customScalesPath, false)) {
+        ofLogError() << "ScaleManager: Could not save custom scales to " << customScalesPath;
+    }
+}
+
+// Old configs embedded each custom and used Scala scale in full. Custom scales move to
+// the custom store; Scala scales already in the library are dropped (the library has
+// them), others are written back to the library as .scl files so they can be referenced.
+int ScaleManager::migrateEmbeddedScales(const ofxJSONElement& customScalesJson) {
+    int migrated = 0;
+    bool customChanged = false;
+    bool libraryChanged = false;
+    for (auto it = customScalesJson.begin(); it != customScalesJson.end(); ++it) {
+        const ofxJSONElement& scaleJson = *it;
+        string name = scaleJson["name"].asString();
+        string source = scaleJson["source"].asString();
+        if (name.empty()) continue;
+        
+        Scale scale;
+        scale.name = name;
+        scale.description = scaleJson["description"].asString();
+        scale.isMicrotonal = scaleJson["isMicrotonal"].asBool();
+        scale.source = source;
+        scale.filename = scaleJson["filename"].asString();
+        const ofxJSONElement& intervalsJson = scaleJson["intervals"];
+        for (auto intervalIt = intervalsJson.begin(); intervalIt != intervalsJson.end(); ++intervalIt) {
+            ScaleInterval interval;
+            interval.cents = (*intervalIt)["cents"].asFloat();
+            interval.ratio = (*intervalIt)["ratio"].asFloat();
+            interval.description = (*intervalIt)["description"].asString();
+            scale.intervals.push_back(interval);
+        }
+        
+        if (source == "custom") {
+            vector<float> cents;
+            for (const ScaleInterval& interval : scale.intervals) {
+                cents.push_back(interval.cents);
+            }
+            if (addCustomScale(name, cents, scale.description)) {
+                customChanged = true;
+                migrated++;
+            }
+        } else if (source == "scala") {
+            const Scale* existing = getScale(name);
+            if (existing && existing->source == "scala") {
+                migrated++;
+                continue;
+            }
+            if (scale.filename.empty() || scale.intervals.empty()) continue;
+            
+            string content = generateScalaContent(scale);
+            scale.filePath = ofFilePath::addTrailingSlash(scalaDirectory) + scale.filename;
+            scale.contentHash = ScalaIndex::checksum(content.data(), content.size());
+            if (!fileExists(scale.filePath)) {
+                std::ofstream file(scale.filePath);
+                file << content;
+                libraryChanged = true;
+            }
+            addScale(scale);
+            migrated++;
+        }
+    }
+    
+    if (customChanged) {
+        saveCustomScales();
+    }
+    // The index picks up the new files, so hash lookups and the next start find them
+    if (libraryChanged) {
+        scalaIndex.refresh(scalaDirectory);
+    }
+    return migrated;
+}
+
 bool ScaleManager::fileExists(const string& path) {
     std::ifstream f(path.c_str());
     return f.good();
@@ -924,9 +1129,9 @@ vector<string> ScaleManager::getFilesWithExtension(const string& directory, cons
 vector<string> ScaleManager::getBuiltinScales() const {
     vector<string> builtinScales;
     
-    for (const auto& pair : scales) {
-        if (pair.second.source == "builtin") {
-            builtinScales.push_back(pair.first);
+    for (const Scale& scale : scales) {
+        if (scale.loaded && scale.source == "builtin") {
+            builtinScales.push_back(scale.name);
         }
     }
     
@@ -938,9 +1143,9 @@ vector<string> ScaleManager::getBuiltinScales() const {
 vector<string> ScaleManager::getScalaScales() const {
     vector<string> scalaScales;
     
-    for (const auto& pair : scales) {
-        if (pair.second.source == "scala") {
-            scalaScales.push_back(pair.first);
+    for (const Scale& scale : scales) {
+        if (scale.loaded && scale.source == "scala") {
+            scalaScales.push_back(scale.name);
         }
     }
     
@@ -950,66 +1155,52 @@ vector<string> ScaleManager::getScalaScales() const {
 }
 
 vector<float> ScaleManager::getScaleNotes(const string& scaleName) const {
-    auto it = scales.find(scaleName);
-    if (it == scales.end()) {
+    const Scale* scale = getScale(scaleName);
+    if (!scale) {
         ofLogError() << "ScaleManager: Scale not found: " << scaleName;
         return vector<float>();
     }
     
     vector<float> notes;
-    for (const auto& interval : it->second.intervals) {
+    for (const auto& interval : scale->intervals) {
         notes.push_back(interval.cents);
     }
     
     return notes;
 }
 
+bool ScaleManager::isScaleMicrotonal(ScaleHandle handle) const {
+    const Scale* scale = getScale(handle);
+    return scale ? scale->isMicrotonal : false;
+}
+
 bool ScaleManager::isScaleMicrotonal(const string& scaleName) const {
-    auto it = scales.find(scaleName);
-    if (it == scales.end()) {
-        return false;
-    }
-    
-    return it->second.isMicrotonal;
+    return isScaleMicrotonal(getScaleHandle(scaleName));
 }
 
 void ScaleManager::refreshScalaFiles() {
-    // Remove existing scala scales
-    auto it = scales.begin();
-    while (it != scales.end()) {
-        if (it->second.source == "scala") {
-            it = scales.erase(it);
-        } else {
-            ++it;
+    // Remove existing scala scales - reloaded files get their old handles back
+    for (ScaleHandle handle = 0; handle < (ScaleHandle)scales.size(); handle++) {
+        if (scales[handle].loaded && scales[handle].source == "scala") {
+            removeScale(handle);
         }
     }
     
-    // Reload scala files from directory
+    // Reload scala files from directory - only new or changed files are rescanned
     string scalaDir = ofToDataPath("scales/");
-    ofDirectory dir(scalaDir);
-    
-    if (dir.exists()) {
-        dir.listDir();
-        for (int i = 0; i < dir.size(); i++) {
-            string filename = dir.getName(i);
-            if (filename.find(".scl") != string::npos) {
-                string fullPath = dir.getPath(i);
-                loadScalaFile(fullPath);
-            }
-        }
-    }
+    loadScalaLibrary(scalaDir);
     
     ofLogNotice() << "ScaleManager: Refreshed Scala files from " << scalaDir;
 }
 
 bool ScaleManager::exportScalaFile(const string& scaleName, const string& filename) {
-    auto it = scales.find(scaleName);
-    if (it == scales.end()) {
+    const Scale* found = getScale(scaleName);
+    if (!found) {
         ofLogError() << "ScaleManager: Cannot export - scale not found: " << scaleName;
         return false;
     }
     
-    const Scale& scale = it->second;
+    const Scale& scale = *found;
     string fullPath = ofToDataPath("scales/" + filename);
     
     ofFile file(fullPath, ofFile::WriteOnly);
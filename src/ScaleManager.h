@@ -2,9 +2,34 @@
 
 #include "ofMain.h"
 #include "ofxJSON.h"
+#include "ScalaIndex.h"
+#include "BuiltinScales.h"
 
 class ScaleManager {
 public:
+    // Compact scale identifier - index into the scale table. A handle stays valid for the
+    // app lifetime; reloading a scale with the same name keeps its handle.
+    typedef int ScaleHandle;
+    static const ScaleHandle INVALID_SCALE = -1;
+    
+    // MIDI pitch bend data for microtonal support
+    struct MicrotonalNote {
+        int midiNote;          // Base MIDI note
+        int pitchBend;         // Pitch bend value (-8192 to +8191)
+        float centsOffset;     // Exact cents offset from base note
+    };
+    
+    // How microtonal pitches reach the synth
+    enum TuningMode {
+        TUNING_PITCH_BEND,     // Nearest key plus a channel pitch bend before every note
+        TUNING_MTS             // Keys retuned once with MIDI Tuning Standard SysEx, plain notes after
+    };
+    
+    enum MTSFormat {
+        MTS_BULK_DUMP,         // Non-real-time bulk tuning dump, all 128 keys
+        MTS_SINGLE_NOTE        // Real-time single note tuning change, applies to sounding notes
+    };
+    
     // Scale data structures
     struct ScaleInterval {
         float cents;           // Interval in cents (1200 cents = 1 octave)
@@ -20,18 +45,24 @@ public:
         bool isMicrotonal;                 // True if requires pitch bend
         int baseNoteMidi;                  // Base MIDI note (usually 60 = middle C)
         string source;                     // "builtin", "scala", "custom"
+        bool loaded;                       // False once deleted - the slot keeps its handle
+        bool intervalsParsed;              // False for indexed Scala files until first use
+        string filePath;                   // Scala file to parse on first use
+        uint64_t contentHash;              // ScalaIndex::checksum of the .scl file, 0 for other sources
+        
+        // Compiled by compileScale() whenever the scale is added
+        vector<MicrotonalNote> pitchTable; // [octave * degreeCount + degree], root not applied
+        vector<int> semitoneIntervals;     // 12-TET approximation within one octave, root first
+        int degreeCount;                   // Intervals + root
+        unsigned int revision;             // Bumped on every compile, invalidates derived tunings
         
         // Constructor
         Scale() : name(""), filename(""), description(""), isMicrotonal(false), 
-                 baseNoteMidi(60), source("builtin") {}
+                 baseNoteMidi(60), source("builtin"), loaded(true), intervalsParsed(true), contentHash(0), degreeCount(1), revision(0) {}
     };
     
-    // MIDI pitch bend data for microtonal support
-    struct MicrotonalNote {
-        int midiNote;          // Base MIDI note
-        int pitchBend;         // Pitch bend value (-8192 to +8191)
-        float centsOffset;     // Exact cents offset from base note
-    };
+    // Octaves covered by the compiled pitch tables (0-10 spans the MIDI range)
+    static const int PITCH_TABLE_OCTAVES = 11;
 
 public:
     ScaleManager();
@@ -42,20 +73,30 @@ public:
     
     // Scale management
     vector<string> getAvailableScaleNames() const;
+    ScaleHandle getScaleHandle(const string& scaleName) const;
+    const Scale* getScale(ScaleHandle handle) const;
     const Scale* getScale(const string& scaleName) const;
     bool setCurrentScale(const string& scaleName);
     string getCurrentScaleName() const { return currentScaleName; }
+    ScaleHandle getCurrentScaleHandle() const { return currentScaleHandle; }
+    size_t getScaleCount() const;
     
-    // Note calculation methods
+    // Note calculation methods - handle versions are table reads, name versions resolve the handle first
     vector<string> getScaleNoteNames(const string& scaleName, int rootNote = 0) const;
+    MicrotonalNote getMicrotonalNote(ScaleHandle handle, int scaleIndex, int rootNote, int octave) const;
     MicrotonalNote getMicrotonalNote(const string& scaleName, int scaleIndex, int rootNote, int octave) const;
-    vector<int> getScaleIntervals(const string& scaleName) const; // For backward compatibility
+    const vector<int>& getScaleIntervals(ScaleHandle handle) const;
+    const vector<int>& getScaleIntervals(const string& scaleName) const; // For backward compatibility
     
     // Scala file support (.scl format)
     bool loadScalaFile(const string& filepath);
     bool saveScalaFile(const string& scaleName, const string& filepath);
     vector<string> getScalaFilesInDirectory(const string& directory);
     
+    // Register every .scl in a directory from the cached metadata index; intervals are parsed on first use
+    void loadScalaLibrary(const string& directory);
+    const ScalaIndex::RefreshStats& getScalaIndexStats() const { return scalaIndex.getLastRefreshStats(); }
+    
     // Built-in scale initialization
     void initializeBuiltinScales();
     
@@ -67,17 +108,33 @@ public:
     void saveToJSON(ofxJSONElement& json);
     void loadFromJSON(const ofxJSONElement& json);
     void setDefaults();
+    void setLineManager(class LineManager* lineMgr) { lineManager = lineMgr; }   // Master scale is saved as in use
     
     // MIDI pitch bend support
+    bool requiresPitchBend(ScaleHandle handle) const;
     bool requiresPitchBend(const string& scaleName) const;
     void enableMicrotonality(bool enable) { microtonalityEnabled = enable; }
     bool isMicrotonalityEnabled() const { return microtonalityEnabled; }
     void setMicrotonalityEnabled(bool enable) { microtonalityEnabled = enable; }
     
+    // MIDI Tuning Standard support
+    void setTuningMode(TuningMode mode) { tuningMode = mode; }
+    TuningMode getTuningMode() const { return tuningMode; }
+    void setMTSFormat(MTSFormat format);
+    MTSFormat getMTSFormat() const { return mtsFormat; }
+    // Rebuild the key map for a scale and root (INVALID_SCALE = plain 12-TET).
+    // Returns true when the synth's tuning is out of date and getTuningMessages() must be sent.
+    bool updateTuning(ScaleHandle handle, int rootNote);
+    void invalidateTuning();                // Resend the current map, e.g. after a port connects
+    vector<vector<unsigned char>> getTuningMessages() const;
+    int getTunedKeyCount() const { return tuning.mappedKeys; }
+    int getUntunedPitchCount() const { return tuning.unmappedPitches; }
+    
     // UI support methods
     vector<string> getBuiltinScales() const;
     vector<string> getScalaScales() const;
     vector<float> getScaleNotes(const string& scaleName) const;
+    bool isScaleMicrotonal(ScaleHandle handle) const;
     bool isScaleMicrotonal(const string& scaleName) const;
     void refreshScalaFiles();
     bool exportScalaFile(const string& scaleName, const string& filename);
@@ -89,40 +146,62 @@ public:
     
 private:
     // Internal data
-    map<string, Scale> scales;              // All available scales
+    mutable vector<Scale> scales;           // All scales, indexed by handle (indexed Scala entries parse lazily in const lookups)
+    unordered_map<string, ScaleHandle> scaleHandles; // Name -> handle, UI/config boundary only
     string currentScaleName;                // Currently selected scale
+    ScaleHandle currentScaleHandle;
     bool microtonalityEnabled;              // Global microtonal support flag
     string scalaDirectory;                  // Directory for Scala files
-    
-    // Built-in scale definitions (12-tone equal temperament)
-    void createMajorScale();
-    void createMinorScale();
-    void createPentatonicScale();
-    void createBluesScale();
-    void createChromaticScale();
-    void createDorian();
-    void createPhrygian();
-    void createLydian();
-    void createMixolydian();
-    void createAeolian();
-    void createLocrian();
-    
-    // Microtonal scale examples
-    void createJustIntonationScale();
-    void createBohlenPierceScale();
-    void create19ToneEqualScale();
-    void create31ToneEqualScale();
+    string customScalesPath;                // Compact store for custom scales, kept out of config.json
+    ScalaIndex scalaIndex;                  // Metadata cache for the Scala library
+    class LineManager* lineManager;
+    
+    // MTS key map: every scale pitch in the MIDI range gets a key of its own, retuned to
+    // the exact pitch. Pitches closest to the middle of the keyboard pick first and take
+    // the nearest free key, so dense scales spread outwards and may run out at the edges;
+    // those pitches fall back to a pitch bend from the closest retuned key.
+    struct TuningTable {
+        ScaleHandle handle;
+        int rootNote;
+        unsigned int revision;
+        vector<MicrotonalNote> notes;       // Same layout as Scale::pitchTable, root applied
+        double keyPitch[128];               // Semitones each key plays (69 = A440)
+        int mappedKeys;
+        int unmappedPitches;
+        bool sendPending;
+    };
+    TuningTable tuning;
+    TuningMode tuningMode;
+    MTSFormat mtsFormat;
+    
+    // Built-in scales come from the compile-time tables
+    void addBuiltinScale(const BuiltinScales::Definition& definition);
+    
+    // Custom scale store - rewritten only when a custom scale is created or deleted
+    bool addCustomScale(const string& name, const vector<float>& centsIntervals, const string& description);
+    void loadCustomScales();
+    void saveCustomScales();
+    int migrateEmbeddedScales(const ofxJSONElement& customScalesJson);
+    
+    // Scale table
+    ScaleHandle addScale(Scale& scale, bool compile = true);  // compile = false for a precompiled pitch table
+    void removeScale(ScaleHandle handle);
+    void compileScale(Scale& scale) const;
+    MicrotonalNote computeDegree(const Scale& scale, int degree, int octave) const;
+    void parseDeferredScale(Scale& scale) const;
     
     // Helper methods
-    vector<ScaleInterval> parseScalaContent(const string& content);
+    vector<ScaleInterval> parseScalaContent(const string& content, const string& source) const;
     string generateScalaContent(const Scale& scale);
-    float centsToRatio(float cents);
-    float ratioToCents(float ratio);
+    float centsToRatio(float cents) const;
+    float ratioToCents(float ratio) const;
     int centsToPitchBend(float cents) const;
     string formatNoteName(int midiNote);
     bool validateScaleIntervals(const vector<ScaleInterval>& intervals);
     
     // File I/O helpers
     bool fileExists(const string& path);
+    static string hashToString(uint64_t hash);
+    static uint64_t stringToHash(const string& text);
     vector<string> getFilesWithExtension(const string& directory, const string& extension);
 };
\ No newline at end of file
@@ -1,40 +1,84 @@
 #include "TempoManager.h"
+#include "CommunicationManager.h"
 
 TempoManager::TempoManager() {
     setDefaults();
 }
 
 TempoManager::~TempoManager() {
-    // Cleanup if needed
+    midiClock.close();
 }
 
 void TempoManager::setup() {
-    startTime = ofGetElapsedTimef();
+    startTime = ofGetElapsedTimeMicros() / 1000000.0;
     isRunning = true;
     ofLogNotice() << "TempoManager: Setup complete - BPM: " << globalBPM << ", Subdivision: " << subdivisionBeats << ", Swing: " << swingRatio;
 }
 
+void TempoManager::setCommunicationManager(CommunicationManager* commMgr) {
+    communicationManager = commMgr;
+    midiClock.setup([this](vector<unsigned char>& message) {
+        communicationManager->sendMIDIClockMessage(message);
+    });
+    
+    if (isRunning) {
+        startMidiClock();
+    }
+}
+
 void TempoManager::start() {
     if (!isRunning) {
-        startTime = ofGetElapsedTimef();
+        startTime = ofGetElapsedTimeMicros() / 1000000.0;
         isRunning = true;
+        startMidiClock();
         ofLogNotice() << "TempoManager: Started";
     }
 }
 
 void TempoManager::stop() {
+    if (isRunning) {
+        stoppedBeat = getCurrentBeat(ofGetElapsedTimef());
+    }
     isRunning = false;
+    midiClock.stop();
     ofLogNotice() << "TempoManager: Stopped";
 }
 
+void TempoManager::resume() {
+    if (isRunning) return;
+    
+    // Song Position Pointer resolution is a 16th note, so resume on the 16th at or before the stop
+    int songPosition = (int)floor(stoppedBeat * 4.0f);
+    double nowSeconds = ofGetElapsedTimeMicros() / 1000000.0;
+    startTime = nowSeconds - (songPosition / 4.0) * getSecondsPerBeat();
+    isRunning = true;
+    midiClock.resume(startTime * 1000000.0, getSecondsPerBeat() * 1000000.0, songPosition);
+    ofLogNotice() << "TempoManager: Resumed at beat " << songPosition / 4.0f;
+}
+
 void TempoManager::reset() {
-    startTime = ofGetElapsedTimef();
+    startTime = ofGetElapsedTimeMicros() / 1000000.0;
+    if (isRunning) {
+        startMidiClock();
+    }
     ofLogNotice() << "TempoManager: Reset beat timing";
 }
 
 void TempoManager::setBPM(float bpm) {
+    // Keep the current beat position, so the grid and the clock do not jump
+    double nowSeconds = ofGetElapsedTimeMicros() / 1000000.0;
+    double currentBeat = (nowSeconds - startTime) / getSecondsPerBeat();
+    
     globalBPM = bpm;
     clampBPM();
+    
+    if (isRunning) {
+        startTime = nowSeconds - currentBeat * getSecondsPerBeat();
+        midiClock.setTempo(startTime * 1000000.0, getSecondsPerBeat() * 1000000.0);
+    }
+    if (communicationManager) {
+        communicationManager->recordMIDITempo(globalBPM);
+    }
     ofLogNotice() << "TempoManager: BPM set to " << globalBPM;
 }
 
@@ -95,19 +139,26 @@ float TempoManager::getSecondsPerBeat() const {
 }
 
 float TempoManager::applySwing(float beatPosition) {
-    if (swingRatio == 0.5f) return beatPosition;  // No swing
+    return (float)getSwungBeat(beatPosition);
+}
+
+double TempoManager::getNextSubdivisionTime(double currentTime) const {
+    if (!isRunning) return currentTime;
     
-    // Apply swing to eighth note subdivisions
-    float beatFraction = beatPosition - floor(beatPosition);
+    double secondsPerBeat = getSecondsPerBeat();
+    double currentBeat = (currentTime - startTime) / secondsPerBeat;
+    double subdivisionInterval = 4.0 / subdivisionBeats;
     
-    if (beatFraction < 0.5f) {
-        // First half of beat - lengthen
-        return floor(beatPosition) + (beatFraction * 2.0f * swingRatio);
-    } else {
-        // Second half of beat - compress
-        float secondHalf = (beatFraction - 0.5f) * 2.0f;
-        return floor(beatPosition) + swingRatio + (secondHalf * (1.0f - swingRatio));
+    // Swing only moves points within a beat and keeps their order, so step forward
+    // from the straight grid point until the swung one is not in the past
+    double index = floor(currentBeat / subdivisionInterval);
+    double swungBeat = getSwungBeat(index * subdivisionInterval);
+    while (swungBeat < currentBeat) {
+        index += 1.0;
+        swungBeat = getSwungBeat(index * subdivisionInterval);
     }
+    
+    return startTime + (swungBeat * secondsPerBeat);
 }
 
 bool TempoManager::isOnSwingBeat(float currentTime, float tolerance) {
@@ -128,8 +179,7 @@ void TempoManager::saveToJSON(ofxJSONElement& json) {
 
 void TempoManager::loadFromJSON(const ofxJSONElement& json) {
     if (json.isMember("globalBPM")) {
-        globalBPM = json["globalBPM"].asFloat();
-        clampBPM();
+        setBPM(json["globalBPM"].asFloat());
     }
     if (json.isMember("subdivisionBeats")) {
         subdivisionBeats = json["subdivisionBeats"].asFloat();
@@ -140,7 +190,11 @@ void TempoManager::loadFromJSON(const ofxJSONElement& json) {
         clampSwingRatio();
     }
     if (json.isMember("isRunning")) {
-        isRunning = json["isRunning"].asBool();
+        if (json["isRunning"].asBool()) {
+            start();
+        } else {
+            stop();
+        }
     }
     
     ofLogNotice() << "TempoManager: Configuration loaded - BPM: " << globalBPM << ", Subdivision: " << subdivisionBeats << ", Swing: " << swingRatio;
@@ -150,13 +204,31 @@ void TempoManager::setDefaults() {
     globalBPM = 120.0f;
     subdivisionBeats = 4.0f;  // Quarter notes
     swingRatio = 0.5f;        // Straight timing
-    startTime = 0.0f;
+    startTime = 0.0;
     isRunning = false;
+    stoppedBeat = 0.0f;
+    midiClock.stop();
     
     ofLogNotice() << "TempoManager: Set to default values";
 }
 
 // Helper methods
+double TempoManager::getSwungBeat(double beatPosition) const {
+    if (swingRatio == 0.5f) return beatPosition;  // No swing
+    
+    // Apply swing to eighth note subdivisions
+    double beatFraction = beatPosition - floor(beatPosition);
+    
+    if (beatFraction < 0.5) {
+        // First half of beat - lengthen
+        return floor(beatPosition) + (beatFraction * 2.0 * swingRatio);
+    } else {
+        // Second half of beat - compress
+        double secondHalf = (beatFraction - 0.5) * 2.0;
+        return floor(beatPosition) + swingRatio + (secondHalf * (1.0 - swingRatio));
+    }
+}
+
 float TempoManager::getElapsedBeats(float currentTime) {
     if (!isRunning) return 0.0f;
     return (currentTime - startTime) / getSecondsPerBeat();
@@ -193,6 +265,10 @@ void TempoManager::clampSubdivision() {
     subdivisionBeats = closest;
 }
 
+void TempoManager::startMidiClock() {
+    midiClock.start(startTime * 1000000.0, getSecondsPerBeat() * 1000000.0);
+}
+
 void TempoManager::clampSwingRatio() {
     swingRatio = ofClamp(swingRatio, 0.5f, 0.75f);
 }
\ No newline at end of file
@@ -2,14 +2,19 @@
 
 #include "ofMain.h"
 #include "ofxJSON.h"
+#include "MidiClock.h"
 
 class TempoManager {
 private:
     float globalBPM = 120.0f;                    // Master tempo (40-200 BPM)
     float subdivisionBeats = 4.0f;               // 4=quarter, 8=eighth, 16=sixteenth notes  
     float swingRatio = 0.5f;                     // 0.5=straight, 0.67=swing feel
-    float startTime = 0.0f;                      // Reference start time for beat calculations
+    double startTime = 0.0;                      // Reference start time for beat calculations
     bool isRunning = false;                      // Tempo system active state
+    float stoppedBeat = 0.0f;                    // Beat position at the last stop, for resume
+    
+    MidiClock midiClock;                         // 24 PPQN clock and transport output
+    class CommunicationManager* communicationManager = nullptr;
     
 public:
     TempoManager();
@@ -18,8 +23,13 @@ public:
     void setup();
     void start();
     void stop();
+    void resume();                               // Continue from the position of the last stop
     void reset();
     
+    // Clock and transport go out through the CommunicationManager's clock ports
+    void setCommunicationManager(class CommunicationManager* commMgr);
+    MidiClock& getMidiClock() { return midiClock; }
+    
     // Core tempo methods
     float getBPM() const { return globalBPM; }
     void setBPM(float bpm);
@@ -37,6 +47,10 @@ public:
     int getBeatIndexForTime(float currentTime);
     float getSecondsPerBeat() const;
     
+    // First subdivision boundary at or after currentTime, swing applied. Double precision
+    // so scheduled note times stay exact after long sessions.
+    double getNextSubdivisionTime(double currentTime) const;
+    
     // Swing timing support
     float applySwing(float beatPosition);
     bool isOnSwingBeat(float currentTime, float tolerance = 0.05f);
@@ -48,10 +62,12 @@ public:
     
 private:
     // Helper methods
+    double getSwungBeat(double beatPosition) const;
     float getElapsedBeats(float currentTime);
     float beatTimeToSeconds(float beatTime);
     float secondsToBeatTime(float seconds);
     void clampBPM();
     void clampSubdivision();
     void clampSwingRatio();
+    void startMidiClock();
 };
\ No newline at end of file
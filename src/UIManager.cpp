@@ -6,6 +6,7 @@
 #include "CommunicationManager.h"
 #include "ConfigManager.h"
 #include "ScaleManager.h"
+#include "TempoManager.h"
 
 UIManager::UIManager() {
     // EXACT COPY from working backup
@@ -24,6 +25,7 @@ UIManager::UIManager() {
     // Initialize missing GUI variables
     showDetections = true;
     showLines = true;
+    tracePathBuffer[0] = '\0';
     
     // Initialize manager pointers
     videoManager = nullptr;
@@ -32,6 +34,17 @@ UIManager::UIManager() {
     communicationManager = nullptr;
     commManager = nullptr;
     configManager = nullptr;
+    tempoManager = nullptr;
+    profiler = nullptr;
+    
+    timelineMs = 100.0f;
+    timelinePaused = false;
+    timelineEndMicros = 0;
+    selectedStage = FrameProfiler::STAGE_FRAME;
+    timelineCollectMicros = 0;
+    
+    tabConfigSections = 0;
+    itemWasActive = false;
 }
 
 UIManager::~UIManager() {
@@ -130,32 +143,58 @@ void UIManager::drawGUI() {
             
             // Main Controls Tab
             if (ImGui::BeginTabItem("Main Controls")) {
+                tabConfigSections = ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_VIDEO) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_LINES) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_COMMUNICATION);
                 drawMainControlsTab();
                 ImGui::EndTabItem();
             }
             
             // MIDI Settings Tab  
             if (ImGui::BeginTabItem("MIDI Settings")) {
+                tabConfigSections = ConfigManager::sectionBit(ConfigManager::SECTION_COMMUNICATION) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_LINES) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_TEMPO) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_SCALES);
                 drawMIDISettingsTab();
                 ImGui::EndTabItem();
             }
             
             // Detection Classes Tab
             if (ImGui::BeginTabItem("Detection Classes")) {
+                tabConfigSections = ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION);
                 drawDetectionClassesTab();
                 ImGui::EndTabItem();
             }
             
             // Scale Manager Tab
             if (ImGui::BeginTabItem("Scale Manager")) {
+                tabConfigSections = ConfigManager::sectionBit(ConfigManager::SECTION_SCALES) |
+                                    ConfigManager::sectionBit(ConfigManager::SECTION_LINES);
                 drawScaleManagerTab();
                 ImGui::EndTabItem();
             }
             
+            // Performance Tab - only the budget watchdog settings persist (with detection)
+            if (ImGui::BeginTabItem("Performance")) {
+                tabConfigSections = ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION);
+                drawPerformanceTab();
+                ImGui::EndTabItem();
+            }
+            
             // Pose Detection Tab
             
             ImGui::EndTabBar();
         }
+        
+        // A slider drag, click or text edit just finished - ConfigManager diffs the
+        // tab's sections after the debounce and writes only what actually changed
+        bool itemActive = ImGui::IsAnyItemActive();
+        if (itemWasActive && !itemActive && configManager) {
+            configManager->markDirty(tabConfigSections);
+        }
+        itemWasActive = itemActive;
     }
     ImGui::End();
     
@@ -179,13 +218,80 @@ void UIManager::drawMainControlsTab() {
             
             // Frame skip is read-only display for modular version
             // RESTORED: Interactive frame skip slider from working backup
-            if (ImGui::SliderInt("Frame Skip", &frameSkipValue, 1, 10, "%d")) {
+            FrameSkipController& cadence = detectionManager->frameSkipController;
+            if (cadence.enabled) {
+                ImGui::Text("Frame Skip: %d (adaptive)", detectionManager->getEffectiveFrameSkip());
+            } else if (ImGui::SliderInt("Frame Skip", &frameSkipValue, 1, 10, "%d")) {
                 // Apply changes to detection system immediately
                 if (detectionManager) {
                     detectionManager->setDetectionFrameSkip(frameSkipValue);
                 }
             }
+
+            // Adaptive cadence - frame skip follows measured inference cost and scene activity
+            ImGui::Checkbox("Adaptive Frame Skip", &cadence.enabled);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Adjust frame skip to stay inside the frame-time and latency budgets");
+            }
+            if (cadence.enabled) {
+                ImGui::SliderFloat("Frame Budget", &cadence.frameBudgetMs, 8.0f, 100.0f, "%.1f ms");
+                ImGui::SliderFloat("Latency Budget", &cadence.latencyBudgetMs, 30.0f, 500.0f, "%.0f ms");
+                ImGui::SliderInt("Max Frame Skip", &cadence.maxSkip, 1, 20, "%d");
+                ImGui::SliderInt("Busy Objects", &cadence.busyObjectCount, 1, 30, "%d");
+                ImGui::SliderInt("Hysteresis", &cadence.hysteresisFrames, 4, 240, "%d frames");
+                ImGui::Text("Target %d (budget range %d-%d), %.1f detections/s",
+                           cadence.getTargetSkip(), cadence.getMinSkipForFrameBudget(),
+                           cadence.getMaxSkipForLatency(), cadence.getDetectionHz());
+                ImGui::Text("Inference %.1f ms, base frame %.1f ms, activity %.0f%%",
+                           cadence.getInferenceMs(), cadence.getBaseFrameMs(), cadence.getActivityLevel() * 100.0f);
+                ImGui::Text("Predicted latency %.0f ms, %lu changes", cadence.getPredictedLatencyMs(),
+                           cadence.getChangeCount());
+                if (cadence.isBudgetConflict()) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Budgets conflict - frame budget wins");
+                }
+            }
             ImGui::Checkbox("Show Detections", &showDetections);
+
+            // Motion gate - skip the detector when nothing moves near the lines
+            MotionGate& gate = detectionManager->motionGate;
+            ImGui::Checkbox("Motion Gate", &gate.enabled);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Skip detection on static frames; tracks are predicted in between");
+            }
+            if (gate.enabled) {
+                ImGui::SliderFloat("Motion Threshold", &gate.pixelThreshold, 2.0f, 40.0f, "%.1f");
+                ImGui::SliderFloat("Line Margin", &gate.lineMargin, 16.0f, 200.0f, "%.0f px");
+                ImGui::Text("Gate: %s (%d/%d blocks moving)", gate.isIdle() ? "Idle" : "Active",
+                           gate.movingBlocks, gate.watchedBlocks);
+                ImGui::Text("Skipped: %.1f%% of %lu runs, %lu forced", gate.getSkipFraction() * 100.0f,
+                           gate.strideFrames, gate.forcedRuns);
+                ImGui::Text("CPU saved: ~%.1f s (detector %.1f ms, gate %.2f ms)",
+                           gate.getEstimatedSavedMs(detectionManager->getAverageInferenceMs()) / 1000.0f,
+                           detectionManager->getAverageInferenceMs(), gate.getAverageGateMs());
+            }
+
+            // Tiled inference - keeps small distant objects detectable on 4K cameras
+            ImGui::Checkbox("Tiled Inference", &detectionManager->tiledInference);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Run the model on overlapping tiles of sources at least %d px wide",
+                                  detectionManager->minTiledSourceWidth);
+            }
+            if (detectionManager->tiledInference) {
+                ImGui::RadioButton("2x2", &detectionManager->tileGrid, 2);
+                ImGui::SameLine();
+                ImGui::RadioButton("3x3", &detectionManager->tileGrid, 3);
+                ImGui::SliderFloat("Tile Overlap", &detectionManager->tileOverlap, 0.0f, 0.4f, "%.2f");
+                ImGui::Checkbox("Coarse Pass Selects Tiles", &detectionManager->tileCoarsePass);
+                ImGui::Text("Tiles: %d/%d last frame", detectionManager->tilesLastRun, detectionManager->tilesTotal);
+                for (int grid = 2; grid <= 3; grid++) {
+                    float ms = detectionManager->tiledRunMs[grid];
+                    if (ms > 0.0f) {
+                        ImGui::Text("%dx%d: %.1f ms/frame (%.1f fps)", grid, grid, ms, 1000.0f / ms);
+                    } else {
+                        ImGui::Text("%dx%d: not measured", grid, grid);
+                    }
+                }
+            }
         }
     }
     
@@ -358,6 +464,63 @@ void UIManager::drawMainControlsTab() {
         ImGui::Text("VideoManager: %s", videoManager ? "OK" : "NULL");
         ImGui::Text("DetectionManager: %s", detectionManager ? "OK" : "NULL");
         ImGui::Text("CommunicationManager: %s", commManager ? "OK" : "NULL");
+        
+        // Pipeline latency histograms (capture -> infer -> track -> emit)
+        if (detectionManager) {
+            ImGui::Separator();
+            ImGui::Text("Pipeline Latency (p50 / p95 / p99):");
+            drawLatencyHistogram("Capture -> Infer", detectionManager->captureToInferLatency);
+            drawLatencyHistogram("Inference", detectionManager->inferenceLatency);
+            drawLatencyHistogram("Track + Cross", detectionManager->trackingLatency);
+            drawLatencyHistogram("Capture -> Emit", detectionManager->captureToEmitLatency);
+            if (ImGui::Button("Reset Latency Stats")) {
+                detectionManager->resetLatencyStats();
+            }
+        }
+    }
+    
+    // Detection trace recording and replay
+    if (ImGui::CollapsingHeader("Detection Trace")) {
+        if (detectionManager) {
+            const DetectionTrace& trace = detectionManager->getTrace();
+            if (!trace.isRecording()) {
+                if (ImGui::Button("Start Recording")) {
+                    detectionManager->startTraceRecording();
+                }
+            } else {
+                if (ImGui::Button("Stop Recording")) {
+                    detectionManager->stopTraceRecording();
+                    strncpy(tracePathBuffer, trace.getRecordingPath().c_str(), sizeof(tracePathBuffer) - 1);
+                    tracePathBuffer[sizeof(tracePathBuffer) - 1] = '\0';
+                }
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "REC %lu frames, %.1f KB",
+                                   trace.getRecordedFrames(), trace.getRecordedBytes() / 1024.0f);
+            }
+            
+            ImGui::InputText("Trace File", tracePathBuffer, sizeof(tracePathBuffer));
+            if (ImGui::Button("Browse...")) {
+                ofFileDialogResult result = ofSystemLoadDialog("Select detection trace");
+                if (result.bSuccess) {
+                    strncpy(tracePathBuffer, result.getPath().c_str(), sizeof(tracePathBuffer) - 1);
+                    tracePathBuffer[sizeof(tracePathBuffer) - 1] = '\0';
+                }
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Replay") && tracePathBuffer[0] != '\0') {
+                detectionManager->replayTrace(tracePathBuffer);
+            }
+            
+            const auto& stats = detectionManager->getLastReplayStats();
+            if (stats.frames > 0) {
+                ImGui::Text("Frames: %lu (%lu detector), %lu detections", stats.frames, stats.detectorFrames, stats.detections);
+                ImGui::Text("Total: %.1f ms (%.0f frames/s)", stats.totalMs, stats.framesPerSecond);
+                ImGui::Text("Tracking: %.2f ms, Crossings: %.2f ms, Max frame: %.0f us",
+                           stats.trackingMs, stats.crossingMs, stats.maxFrameUs);
+                ImGui::Text("Crossing events: %lu", stats.crossings);
+                ImGui::TextWrapped("%s", stats.eventsPath.c_str());
+            }
+        }
     }
     
     // Configuration Section - EXACT COPY from working backup
@@ -386,6 +549,35 @@ void UIManager::drawMainControlsTab() {
         
         ImGui::Separator();
         
+        if (configManager) {
+            ImGui::Checkbox("Autosave", &configManager->autosaveEnabled);
+            ImGui::SameLine();
+            ImGui::SliderFloat("Interval (s)", &configManager->autosaveSeconds, 5.0f, 300.0f, "%.0f");
+            
+            ConfigManager::PersistStats persistStats = configManager->getPersistStats();
+            if (persistStats.writes > 0) {
+                ImGui::Text("Last saved %.0fs ago (%d writes, %.1f ms write, %.2f ms serialize)",
+                            ofGetElapsedTimef() - persistStats.lastSaveTime, persistStats.writes,
+                            persistStats.lastWriteMs, persistStats.lastSerializeMs);
+            } else {
+                ImGui::Text("Not saved yet this session");
+            }
+            if (persistStats.failures > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%d failed writes", persistStats.failures);
+            }
+            ImGui::Checkbox("Reload when config.json is edited", &configManager->hotReloadEnabled);
+            ConfigWatcher::Stats reloadStats = configManager->getReloadStats();
+            if (reloadStats.reloads > 0) {
+                ImGui::Text("Reloaded %d times, last %.0fs ago", reloadStats.reloads,
+                            ofGetElapsedTimef() - reloadStats.lastReloadTime);
+            }
+            if (reloadStats.rejected > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%d edits rejected, last: %s",
+                                   reloadStats.rejected, reloadStats.lastError.c_str());
+            }
+            ImGui::Text("Loaded in %.2f ms", configManager->getLoadMs());
+        }
+        
         // Config path display
         string configPath = ofToDataPath("config.json");
         ImGui::Text("Config Path:");
@@ -679,6 +871,29 @@ void UIManager::drawMIDISettingsTab() {
                     if (selectedLine->durationType == LineManager::MidiLine::DURATION_FIXED) {
                         ImGui::SliderInt("Duration (ms)", &selectedLine->fixedDuration, 50, 2000);
                     }
+                    
+                    // Tempo sync - crossings are quantized to the tempo grid by the note scheduler
+                    ImGui::Separator();
+                    ImGui::Text("Tempo Sync:");
+                    ImGui::Checkbox("Quantize to Tempo Grid", &selectedLine->enableTempoSync);
+                    if (selectedLine->enableTempoSync) {
+                        const char* quantizeModes[] = {"Hard Snap", "Gradual"};
+                        int quantizeMode = (int)selectedLine->quantizeMode;
+                        if (ImGui::Combo("Quantize Mode", &quantizeMode, quantizeModes, 2)) {
+                            selectedLine->quantizeMode = (LineManager::MidiLine::QuantizeMode)quantizeMode;
+                        }
+                        if (selectedLine->quantizeMode == LineManager::MidiLine::GRADUAL_TRANSITION) {
+                            ImGui::SliderFloat("Quantize Strength", &selectedLine->quantizeStrength, 0.0f, 1.0f, "%.2f");
+                        }
+                        
+                        if (commManager) {
+                            const NoteScheduler& scheduler = commManager->noteScheduler;
+                            ImGui::Text("Scheduler: %d pending, %llu sent", scheduler.getPendingCount(),
+                                        (unsigned long long)scheduler.getDispatchedCount());
+                            ImGui::Text("Timing error: %.0f us avg, %.0f us max", scheduler.getMeanLatenessMicros(),
+                                        scheduler.getMaxLatenessMicros());
+                        }
+                    }
                 }
             }
         }
@@ -690,6 +905,7 @@ void UIManager::drawMIDISettingsTab() {
             auto portNames = commManager->getMidiPortNames();
             auto portSelected = commManager->getMidiPortSelected();
             auto portConnected = commManager->getMidiPortConnected();
+            auto portClock = commManager->getMidiPortClock();
             
             if (!portNames.empty()) {
                 ImGui::Text("Select MIDI output ports:");
@@ -716,6 +932,13 @@ void UIManager::drawMIDISettingsTab() {
                     ImGui::SameLine();
                     ImGui::Text("%s", portNames[i].c_str());
                     
+                    // MIDI clock output to this port
+                    ImGui::SameLine();
+                    bool clockEnabled = portClock[i];
+                    if (ImGui::Checkbox("Clock", &clockEnabled)) {
+                        commManager->setMIDIPortClock(i, clockEnabled);
+                    }
+                    
                     // Connection status
                     ImGui::SameLine();
                     if (portSelected[i]) {
@@ -758,6 +981,88 @@ void UIManager::drawMIDISettingsTab() {
             }
         }
     }
+    
+    // MPE - per-note member channels so microtonal bends do not collide
+    if (ImGui::CollapsingHeader("MPE Voice Allocation")) {
+        if (commManager) {
+            bool mpeEnabled = commManager->isMPEEnabled();
+            if (ImGui::Checkbox("Enable MPE (lower zone)", &mpeEnabled)) {
+                commManager->setMPEEnabled(mpeEnabled);
+            }
+            
+            int firstChannel = commManager->mpeFirstChannel;
+            int lastChannel = commManager->mpeLastChannel;
+            bool rangeChanged = ImGui::SliderInt("First Member Channel", &firstChannel, 2, 16);
+            rangeChanged |= ImGui::SliderInt("Last Member Channel", &lastChannel, 2, 16);
+            if (rangeChanged) {
+                commManager->setMPEChannelRange(firstChannel, std::max(firstChannel, lastChannel));
+            }
+            
+            ImGui::Text("Voices: %d/%d active, %llu stolen", commManager->getMPEActiveVoices(),
+                        commManager->mpeLastChannel - commManager->mpeFirstChannel + 1,
+                        (unsigned long long)commManager->getMPEStealCount());
+            if (ImGui::Button("Send MPE Configuration")) {
+                commManager->sendMPEConfiguration();
+            }
+            ImGui::TextWrapped("Each crossing plays on its own member channel with its own pitch bend. Line MIDI channels are ignored while MPE is on.");
+        }
+    }
+    
+    // Record everything sent to the MIDI ports to a .mid file
+    if (ImGui::CollapsingHeader("MIDI Recording")) {
+        if (commManager) {
+            MidiFileRecorder& recorder = commManager->midiRecorder;
+            if (recorder.isRecording()) {
+                if (ImGui::Button("Stop Recording")) {
+                    commManager->stopMIDIRecording();
+                }
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "REC %.0fs", recorder.getDurationSeconds());
+            } else if (ImGui::Button("Start Recording")) {
+                commManager->startMIDIRecording();
+            }
+            
+            if (!recorder.getPath().empty()) {
+                ImGui::TextWrapped("File: %s", recorder.getPath().c_str());
+                ImGui::Text("Events: %llu, %.1f KB on disk", (unsigned long long)recorder.getEventCount(),
+                            recorder.getBytesWritten() / 1024.0f);
+            }
+        }
+    }
+    
+    // MIDI clock - 24 PPQN and transport to the ports marked "Clock" above
+    if (ImGui::CollapsingHeader("MIDI Clock")) {
+        if (tempoManager) {
+            float bpm = tempoManager->getBPM();
+            if (ImGui::SliderFloat("BPM", &bpm, 40.0f, 200.0f, "%.1f")) {
+                tempoManager->setBPM(bpm);
+            }
+            
+            if (ImGui::Button("Start")) {
+                tempoManager->stop();
+                tempoManager->start();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Stop")) {
+                tempoManager->stop();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Continue")) {
+                tempoManager->resume();
+            }
+            ImGui::SameLine();
+            ImGui::Text("%s", tempoManager->getIsRunning() ? "Running" : "Stopped");
+            
+            MidiClock::Stats clockStats = tempoManager->getMidiClock().getStats();
+            ImGui::Text("Ticks sent: %llu (%llu skipped)", (unsigned long long)clockStats.ticksSent,
+                        (unsigned long long)clockStats.ticksSkipped);
+            ImGui::Text("Jitter: %.0f us avg, %.0f us rms, %.0f us max", clockStats.meanJitterMicros,
+                        clockStats.rmsJitterMicros, clockStats.maxJitterMicros);
+            if (ImGui::Button("Reset Clock Stats")) {
+                tempoManager->getMidiClock().resetStats();
+            }
+        }
+    }
 }
 
 void UIManager::drawDetectionClassesTab() {
@@ -1374,6 +1679,9 @@ void UIManager::drawScaleManagerTab() {
             scaleManager->refreshScalaFiles();
             ofLogNotice() << "Scala files refreshed";
         }
+        const ScalaIndex::RefreshStats& indexStats = scaleManager->getScalaIndexStats();
+        ImGui::TextDisabled("Index: %d files, %d cached, %d scanned (%.0f ms)", indexStats.files,
+                            indexStats.reused, indexStats.scanned, indexStats.elapsedMs);
         
         ImGui::Unindent();
     }
@@ -1392,8 +1700,31 @@ void UIManager::drawScaleManagerTab() {
         
         if (microtonalEnabled) {
             ImGui::Spacing();
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Pitch Bend Range: ±200 cents (2 semitones)");
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Resolution: 14-bit MIDI pitch bend");
+            const char* tuningModes[] = {"Pitch Bend (per note)", "MIDI Tuning Standard"};
+            int tuningMode = (int)scaleManager->getTuningMode();
+            if (ImGui::Combo("Tuning Method", &tuningMode, tuningModes, 2)) {
+                scaleManager->setTuningMode((ScaleManager::TuningMode)tuningMode);
+                ofLogNotice() << "Tuning method: " << tuningModes[tuningMode];
+            }
+            
+            if (scaleManager->getTuningMode() == ScaleManager::TUNING_MTS) {
+                const char* mtsFormats[] = {"Bulk Dump", "Single Note (real-time)"};
+                int mtsFormat = (int)scaleManager->getMTSFormat();
+                if (ImGui::Combo("MTS Message", &mtsFormat, mtsFormats, 2)) {
+                    scaleManager->setMTSFormat((ScaleManager::MTSFormat)mtsFormat);
+                }
+                ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Keys retuned: %d", scaleManager->getTunedKeyCount());
+                if (scaleManager->getUntunedPitchCount() > 0) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.7f, 0.3f, 1.0f), "%d pitches without a free key (pitch bend fallback)",
+                                       scaleManager->getUntunedPitchCount());
+                }
+                if (ImGui::Button("Resend Tuning")) {
+                    scaleManager->invalidateTuning();
+                }
+            } else {
+                ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Pitch Bend Range: ±200 cents (2 semitones)");
+                ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Resolution: 14-bit MIDI pitch bend");
+            }
             
             // Pitch bend test controls
             ImGui::Spacing();
@@ -1496,6 +1827,7 @@ void UIManager::drawScaleManagerTab() {
             
             // Get scale intervals for analysis
             auto scaleNotes = scaleManager->getScaleNotes(currentScale);
+            ScaleManager::ScaleHandle scaleHandle = scaleManager->getScaleHandle(currentScale);
             
             ImGui::Text("Scale Analysis: %s", currentScale.c_str());
             ImGui::Separator();
@@ -1527,7 +1859,7 @@ void UIManager::drawScaleManagerTab() {
                 // Calculate MIDI note with microtonal adjustment
                 if (scaleManager->isMicrotonalityEnabled()) {
                     ScaleManager::MicrotonalNote microNote = 
-                        scaleManager->getMicrotonalNote(currentScale, i, rootNote, 4);
+                        scaleManager->getMicrotonalNote(scaleHandle, i, rootNote, 4);
                     if (microNote.pitchBend != 0) {
                         ImGui::Text("%d + %.0f¢", microNote.midiNote, microNote.centsOffset);
                     } else {
@@ -1569,6 +1901,178 @@ void UIManager::drawScaleManagerTab() {
     ImGui::TextColored(ImVec4(0.6f, 1.0f, 0.6f, 1.0f), "Selected");
 }
 
+void UIManager::drawPerformanceTab() {
+    if (!profiler) {
+        ImGui::Text("Profiler not connected");
+        return;
+    }
+    
+    bool enabled = profiler->isEnabled();
+    if (ImGui::Checkbox("Profile Stages", &enabled)) {
+        profiler->setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Pause Timeline", &timelinePaused)) {
+        timelineEndMicros = ofGetElapsedTimeMicros();
+    }
+    
+    // Frame times, newest on the right
+    vector<float> frameTimes;
+    profiler->getFrameTimes(frameTimes);
+    if (!frameTimes.empty()) {
+        float maxFrameMs = *std::max_element(frameTimes.begin(), frameTimes.end());
+        string overlay = "frame " + ofToString(frameTimes.back(), 1) + " ms, max " + ofToString(maxFrameMs, 1) + " ms";
+        ImGui::PlotLines("##frametimes", frameTimes.data(), (int)frameTimes.size(), 0, overlay.c_str(),
+                         0.0f, std::max(maxFrameMs, 1000.0f / 30.0f), ImVec2(-1, 50));
+    }
+    
+    if (detectionManager && ImGui::CollapsingHeader("Frame Budget Watchdog", ImGuiTreeNodeFlags_DefaultOpen)) {
+        FrameBudgetWatchdog& watchdog = detectionManager->budgetWatchdog;
+        ImGui::Checkbox("Degrade When Over Budget", &watchdog.enabled);
+        ImGui::SliderFloat("Budget (ms)", &watchdog.budgetMs, 5.0f, 100.0f, "%.1f");
+        
+        int level = watchdog.getLevel();
+        ImVec4 levelColor = level == FrameBudgetWatchdog::LEVEL_NONE ? ImVec4(0.6f, 1.0f, 0.6f, 1.0f) : ImVec4(1.0f, 0.7f, 0.3f, 1.0f);
+        ImGui::TextColored(levelColor, "Level %d: %s", level, FrameBudgetWatchdog::getLevelName(level));
+        ImGui::Text("Frame work: %.1f ms avg (restore below %.1f ms for %.0f s)", watchdog.getAverageWorkMs(),
+                    watchdog.budgetMs * watchdog.restoreRatio, watchdog.getRestoreHoldSeconds());
+        ImGui::Text("Transitions: %lu", watchdog.getTransitionCount());
+        if (watchdog.getMaxLevel() < FrameBudgetWatchdog::LEVEL_SMALL_MODEL) {
+            ImGui::TextDisabled("Small model step unavailable (yolov8n loaded or not bundled)");
+        }
+    }
+    
+    if (ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::SliderFloat("Window (ms)", &timelineMs, 20.0f, 1000.0f, "%.0f");
+        drawProfilerTimeline();
+    }
+    
+    if (ImGui::CollapsingHeader("Stages (p50 / p95 / p99)", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (int stage = 0; stage < FrameProfiler::STAGE_COUNT; stage++) {
+            const LatencyHistogram& histogram = profiler->getHistogram((FrameProfiler::Stage)stage);
+            if (histogram.getCount() == 0) continue;
+            
+            string line = ofToString(FrameProfiler::getStageName(stage)) + ": " +
+                          ofToString(histogram.getPercentileMicros(50.0f) / 1000.0f, 2) + " / " +
+                          ofToString(histogram.getPercentileMicros(95.0f) / 1000.0f, 2) + " / " +
+                          ofToString(histogram.getPercentileMicros(99.0f) / 1000.0f, 2) + " ms";
+            if (ImGui::Selectable(line.c_str(), selectedStage == stage)) {
+                selectedStage = stage;
+            }
+        }
+        
+        ImGui::Separator();
+        drawLatencyHistogram(FrameProfiler::getStageName(selectedStage),
+                             profiler->getHistogram((FrameProfiler::Stage)selectedStage));
+        if (ImGui::Button("Reset Stage Stats")) {
+            profiler->resetStats();
+        }
+    }
+    
+    if (ImGui::CollapsingHeader("Export")) {
+        ImGui::TextWrapped("Writes the last ~%d events per thread as Chrome trace JSON. Open in chrome://tracing or ui.perfetto.dev.",
+                           FrameProfiler::RING_SIZE);
+        if (ImGui::Button("Export Chrome Trace")) {
+            string traceDir = ofToDataPath("traces");
+            if (!ofDirectory::doesDirectoryExist(traceDir, false)) {
+                ofDirectory::createDirectory(traceDir, false, true);
+            }
+            string path = traceDir + "/profile_" + ofGetTimestampString("%Y%m%d-%H%M%S") + ".json";
+            lastProfileExport = profiler->exportChromeTrace(path) ? path : "Export failed";
+        }
+        if (!lastProfileExport.empty()) {
+            ImGui::TextWrapped("%s", lastProfileExport.c_str());
+        }
+    }
+}
+
+// One lane per thread, nested stages stacked by depth, frame starts as vertical lines
+void UIManager::drawProfilerTimeline() {
+    const float rowHeight = 14.0f;
+    uint64_t windowMicros = (uint64_t)(timelineMs * 1000.0f);
+    uint64_t endMicros = timelinePaused ? timelineEndMicros : ofGetElapsedTimeMicros();
+    uint64_t startMicros = endMicros > windowMicros ? endMicros - windowMicros : 0;
+    
+    // Collecting every ring is the heaviest part of the GUI; refresh it less often while degraded
+    bool throttled = detectionManager && detectionManager->budgetWatchdog.getLevel() >= FrameBudgetWatchdog::LEVEL_COSMETIC;
+    uint64_t nowMicros = ofGetElapsedTimeMicros();
+    if (!throttled || nowMicros - timelineCollectMicros >= 100000) {
+        profiler->collect(startMicros, timelineEvents);
+        timelineCollectMicros = nowMicros;
+    }
+    const vector<FrameProfiler::ThreadEvents>& threads = timelineEvents;
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    float width = ImGui::GetContentRegionAvail().x;
+    float scale = width / (float)windowMicros;
+    
+    for (const FrameProfiler::ThreadEvents& thread : threads) {
+        int depthCount = 1;
+        for (const FrameProfiler::Event& event : thread.events) {
+            depthCount = std::max(depthCount, event.depth + 1);
+        }
+        
+        ImGui::TextDisabled("%s", thread.name.c_str());
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float laneHeight = depthCount * rowHeight;
+        drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + laneHeight),
+                                ImGui::ColorConvertFloat4ToU32(ImVec4(0.12f, 0.12f, 0.14f, 1.0f)));
+        
+        const FrameProfiler::Event* hovered = nullptr;
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+        for (const FrameProfiler::Event& event : thread.events) {
+            if (event.startMicros > endMicros) continue;
+            float x0 = origin.x + std::max(0.0f, (float)((int64_t)event.startMicros - (int64_t)startMicros) * scale);
+            float x1 = origin.x + std::min(width, (float)((int64_t)(event.startMicros + event.durationMicros) - (int64_t)startMicros) * scale);
+            
+            if (event.stage == FrameProfiler::STAGE_FRAME) {
+                drawList->AddLine(ImVec2(x0, origin.y), ImVec2(x0, origin.y + laneHeight),
+                                  ImGui::ColorConvertFloat4ToU32(ImVec4(1.0f, 1.0f, 1.0f, 0.25f)));
+                continue;
+            }
+            
+            float y0 = origin.y + event.depth * rowHeight;
+            ofFloatColor stageColor = ofFloatColor::fromHsb(event.stage / (float)FrameProfiler::STAGE_COUNT, 0.55f, 0.8f);
+            ImU32 color = ImGui::ColorConvertFloat4ToU32(ImVec4(stageColor.r, stageColor.g, stageColor.b, 1.0f));
+            drawList->AddRectFilled(ImVec2(x0, y0 + 1), ImVec2(std::max(x1, x0 + 1.0f), y0 + rowHeight - 1), color);
+            
+            const char* name = FrameProfiler::getStageName(event.stage);
+            if (x1 - x0 > ImGui::CalcTextSize(name).x + 4) {
+                drawList->AddText(ImVec2(x0 + 2, y0), ImGui::ColorConvertFloat4ToU32(ImVec4(0, 0, 0, 1)), name);
+            }
+            if (mouse.x >= x0 && mouse.x <= std::max(x1, x0 + 1.0f) && mouse.y >= y0 && mouse.y < y0 + rowHeight) {
+                hovered = &event;
+            }
+        }
+        ImGui::Dummy(ImVec2(width, laneHeight));
+        
+        if (hovered && ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("%s: %.3f ms", FrameProfiler::getStageName(hovered->stage), hovered->durationMicros / 1000.0f);
+        }
+    }
+}
+
 void UIManager::handleWindowResize(int width, int height) {
     ofLogNotice() << "UIManager: Window resized to " << width << "x" << height;
-}
\ No newline at end of file
+}
+
+void UIManager::drawLatencyHistogram(const char* label, const LatencyHistogram& histogram) {
+    if (histogram.getCount() == 0) {
+        ImGui::Text("%s: no samples", label);
+        return;
+    }
+    
+    ImGui::Text("%s: %.2f / %.2f / %.2f ms (n=%llu)", label,
+               histogram.getPercentileMicros(50.0f) / 1000.0f,
+               histogram.getPercentileMicros(95.0f) / 1000.0f,
+               histogram.getPercentileMicros(99.0f) / 1000.0f,
+               (unsigned long long)histogram.getCount());
+    
+    vector<float> values;
+    float lowMicros, highMicros;
+    histogram.getPlotData(values, lowMicros, highMicros);
+    string overlay = ofToString(lowMicros / 1000.0f, 2) + " - " + ofToString(highMicros / 1000.0f, 2) + " ms";
+    ImGui::PushID(label);
+    ImGui::PlotHistogram("##latency", values.data(), (int)values.size(), 0, overlay.c_str(), 0.0f, FLT_MAX, ImVec2(0, 40));
+    ImGui::PopID();
+}
@@ -2,6 +2,8 @@
 
 #include "ofMain.h"
 #include "ofxImGui.h"
+#include "LatencyHistogram.h"
+#include "FrameProfiler.h"
 
 class UIManager {
 public:
@@ -22,6 +24,9 @@ public:
     void drawMIDISettingsTab();
     void drawDetectionClassesTab();
     void drawScaleManagerTab();
+    void drawPerformanceTab();
+    void drawProfilerTimeline();
+    void drawLatencyHistogram(const char* label, const LatencyHistogram& histogram);
     
     // EXACT same GUI variables as working backup
     ofxImGui::Gui gui;
@@ -35,6 +40,8 @@ public:
                      class CommunicationManager* commMgr,
                      class ConfigManager* confMgr,
                      class ScaleManager* scaleMgr);
+    void setTempoManager(class TempoManager* tempoMgr) { tempoManager = tempoMgr; }
+    void setProfiler(FrameProfiler* frameProfiler) { profiler = frameProfiler; }
     
     // GUI state variables - EXACT COPY from working backup
     float confidenceThreshold;
@@ -46,6 +53,7 @@ public:
     int maxTrajectoryPoints;
     bool showDetections;
     bool showLines;
+    char tracePathBuffer[512];  // Detection trace to replay
     
     void handleWindowResize(int width, int height);
     
@@ -58,4 +66,19 @@ private:
     class CommunicationManager* commManager;  // Alias used in cpp file
     class ConfigManager* configManager;
     class ScaleManager* scaleManager;
+    class TempoManager* tempoManager;
+    FrameProfiler* profiler;
+    
+    // Performance tab
+    float timelineMs;              // Width of the rolling timeline
+    bool timelinePaused;
+    uint64_t timelineEndMicros;    // Right edge while paused
+    int selectedStage;             // Stage whose histogram is plotted
+    vector<FrameProfiler::ThreadEvents> timelineEvents;
+    uint64_t timelineCollectMicros; // Throttled to 10 Hz while the budget watchdog is degrading
+    string lastProfileExport;
+    
+    // Config sections the open tab can change; marked dirty when a widget is released
+    uint32_t tabConfigSections;
+    bool itemWasActive;
 };
\ No newline at end of file
@@ -11,6 +11,8 @@ VideoManager::VideoManager() {
     // Initialize USB camera device variables
     currentCameraDeviceID = 0;  // Default to first camera
     currentCameraName = "Default Camera";
+    preferredCameraWidth = 0;
+    preferredCameraHeight = 0;
     
     // Initialize IP camera configuration - EXACT COPY from working backup
     ipCameraUrl = "http://localhost:8080/video";  // USB forwarded IP Webcam URL
@@ -21,6 +23,13 @@ VideoManager::VideoManager() {
     frameRequestInterval = 0.5f;  // 2fps for much better performance
     ipFrameSkip = 1;              // Process every frame requested
     ipFrameCounter = 0;
+    
+    headless = false;
+    frameNew = false;
+    frameCaptureMicros = 0;
+    frameNumber = 0;
+    droppedFrames = 0;
+    lastPlayerFrame = -1;
 }
 
 VideoManager::~VideoManager() {
@@ -33,6 +42,11 @@ VideoManager::~VideoManager() {
 }
 
 void VideoManager::setup() {
+    // Detection reads pixels; textures are only for drawing and need a GL context
+    camera.setUseTexture(!headless);
+    videoPlayer.setUseTexture(!headless);
+    currentIPFrame.setUseTexture(!headless);
+    
     // Enumerate available cameras first
     refreshCameraDevices();
     
@@ -57,8 +71,13 @@ void VideoManager::setup() {
     // Try different common resolutions for better compatibility
     bool cameraSetup = false;
     
+    // Mode that worked last run skips probing resolutions this camera does not have
+    if (preferredCameraWidth > 0 && camera.setup(preferredCameraWidth, preferredCameraHeight)) {
+        cameraSetup = true;
+        ofLogNotice() << "Camera (" << currentCameraName << ") restored " << preferredCameraWidth << "x" << preferredCameraHeight;
+    }
     // Try HD 1280x720 first for high quality detection
-    if (camera.setup(1280, 720)) {
+    else if (camera.setup(1280, 720)) {
         cameraSetup = true;
         ofLogNotice() << "Camera (" << currentCameraName << ") set to HD 1280x720";
     }
@@ -96,16 +115,25 @@ void VideoManager::setup() {
 }
 
 void VideoManager::update() {
+    frameNew = false;
+    
     // Update video sources based on current source - EXACT COPY from working backup
     switch (currentVideoSource) {
         case CAMERA:
             if (cameraConnected) {
                 camera.update();
+                if (camera.isFrameNew()) {
+                    stampNewFrame(ofGetElapsedTimeMicros());
+                }
             }
             break;
         case VIDEO_FILE:
             if (videoLoaded) {
                 videoPlayer.update();
+                if (videoPlayer.isFrameNew()) {
+                    countPlayerFrame();
+                    stampNewFrame(ofGetElapsedTimeMicros());
+                }
             }
             break;
         case IP_CAMERA:
@@ -113,15 +141,20 @@ void VideoManager::update() {
             if (ipCameraConnected && ofGetElapsedTimef() - lastFrameRequest > frameRequestInterval) {
                 ipFrameCounter++;
                 if (ipFrameCounter >= ipFrameSkip) {
+                    // The snapshot is taken when the request reaches the camera
+                    uint64_t requestMicros = ofGetElapsedTimeMicros();
+                    
                     // Load new frame via HTTP with proper handling
                     ofBuffer imageBuffer = ofLoadURL(ipCameraSnapshotUrl).data;
                     if (imageBuffer.size() > 0) {
                         ofImage newFrame;
+                        newFrame.setUseTexture(!headless);
                         if (newFrame.loadImage(imageBuffer)) {
                             // Resize to 320x240 for much better performance  
                             newFrame.resize(320, 240);
                             currentIPFrame = newFrame;
                             ipFrameReady = true;
+                            stampNewFrame(requestMicros);
                         }
                     }
                     ipFrameCounter = 0; // Reset counter
@@ -134,11 +167,55 @@ void VideoManager::update() {
     // Backward compatibility: also update based on useVideoFile flag - EXACT COPY
     if (useVideoFile && videoLoaded) {
         videoPlayer.update();
+        if (videoPlayer.isFrameNew()) {
+            countPlayerFrame();
+            stampNewFrame(ofGetElapsedTimeMicros());
+        }
     } else if (cameraConnected && currentVideoSource == CAMERA) {
         camera.update();
+        if (camera.isFrameNew()) {
+            stampNewFrame(ofGetElapsedTimeMicros());
+        }
     }
 }
 
+// Without a render clock, poll the source until a frame arrives (or the timeout passes)
+// so processing starts as soon as it does. Grabbers have no arrival callback, hence the
+// short sleeps rather than blocking on the source.
+bool VideoManager::waitForFrame(uint64_t timeoutMicros) {
+    uint64_t deadline = ofGetElapsedTimeMicros() + timeoutMicros;
+    while (true) {
+        update();
+        if (frameNew) {
+            return true;
+        }
+        if (ofGetElapsedTimeMicros() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(250));
+    }
+}
+
+void VideoManager::stampNewFrame(uint64_t captureMicros) {
+    // The backward-compat update can report the same frame again - keep the first stamp
+    if (frameNew) {
+        return;
+    }
+    frameNew = true;
+    frameCaptureMicros = captureMicros;
+    frameNumber++;
+}
+
+// The player decodes on its own clock; frame numbers that jump between updates were
+// never processed. Loops and backward seeks are not drops.
+void VideoManager::countPlayerFrame() {
+    int playerFrame = videoPlayer.getCurrentFrame();
+    if (lastPlayerFrame >= 0 && playerFrame > lastPlayerFrame + 1) {
+        droppedFrames += playerFrame - lastPlayerFrame - 1;
+    }
+    lastPlayerFrame = playerFrame;
+}
+
 void VideoManager::draw() {
     // Draw video source in left 640x640 area only - EXACT COPY from working backup
     ofSetColor(255, 255, 255);  // White color for video
@@ -370,6 +447,7 @@ void VideoManager::openVideoFileDialog() {
         
         if (videoPlayer.load(currentVideoPath)) {
             videoLoaded = true;
+            lastPlayerFrame = -1;
             useVideoFile = true;
             currentVideoSource = VIDEO_FILE;
             videoPlayer.setVolume(0.0f);  // Mute audio - CRITICAL FIX
@@ -456,6 +534,7 @@ void VideoManager::handleVideoKeyPress(int key) {
             if (currentVideoSource == VIDEO_FILE && videoLoaded) {
                 float currentPos = videoPlayer.getPosition();
                 videoPlayer.setPosition(std::max(0.0f, currentPos - 0.05f));
+                lastPlayerFrame = -1;
                 ofLogNotice() << "VideoManager: Seeked backward";
             }
             break;
@@ -464,6 +543,7 @@ void VideoManager::handleVideoKeyPress(int key) {
             if (currentVideoSource == VIDEO_FILE && videoLoaded) {
                 float currentPos = videoPlayer.getPosition();
                 videoPlayer.setPosition(std::min(1.0f, currentPos + 0.05f));
+                lastPlayerFrame = -1;
                 ofLogNotice() << "VideoManager: Seeked forward";
             }
             break;
@@ -553,6 +633,12 @@ void VideoManager::refreshCameraDevices() {
     }
 }
 
+void VideoManager::setPreferredCameraMode(int deviceID, int width, int height) {
+    currentCameraDeviceID = deviceID;
+    preferredCameraWidth = width;
+    preferredCameraHeight = height;
+}
+
 void VideoManager::setCameraDevice(int deviceID) {
     if (deviceID < 0 || deviceID >= availableCameras.size()) {
         ofLogError() << "VideoManager: Invalid camera device ID: " << deviceID;
@@ -44,6 +44,14 @@ public:
     // Detection support - get pixels for CoreML detection
     ofPixels getCurrentPixels();
     
+    // Capture timestamps - ofGetElapsedTimeMicros() (monotonic) when a new frame
+    // was first seen in update(). Carried through detection to OSC/MIDI output.
+    bool isFrameNew() const { return frameNew; }
+    bool waitForFrame(uint64_t timeoutMicros);   // Headless pacing; runs update()
+    uint64_t getFrameCaptureMicros() const { return frameCaptureMicros; }
+    unsigned long getFrameNumber() const { return frameNumber; }
+    unsigned long getDroppedFrames() const { return droppedFrames; }   // Video file only
+    
     // USB Camera device management
     vector<ofVideoDevice> getAvailableCameras();
     void setCameraDevice(int deviceID);
@@ -51,6 +59,13 @@ public:
     string getCurrentCameraName() const { return currentCameraName; }
     void refreshCameraDevices();
     
+    // Headless: frames stay in CPU pixels, no textures are created. Call before setup().
+    void setHeadless(bool enabled) { headless = enabled; }
+    
+    // Mode that worked last run (from camera.hint), tried before the fallbacks.
+    // Call before setup().
+    void setPreferredCameraMode(int deviceID, int width, int height);
+    
     // Video objects - EXACT same as working backup
     ofVideoGrabber camera;
     ofVideoPlayer videoPlayer;
@@ -74,10 +89,21 @@ public:
     int ipFrameSkip;
     int ipFrameCounter;
     
+    // Frame arrival tracking
+    bool headless;
+    bool frameNew;
+    uint64_t frameCaptureMicros;
+    unsigned long frameNumber;
+    unsigned long droppedFrames;   // Player frames decoded past between two updates
+    int lastPlayerFrame;           // -1 after a load or seek
+    void countPlayerFrame();
+    
     // USB Camera device variables
     vector<ofVideoDevice> availableCameras;
     int currentCameraDeviceID;
     string currentCameraName;
+    int preferredCameraWidth;      // 0 = none
+    int preferredCameraHeight;
     
     // Configuration methods
     void saveToJSON(ofxJSONElement& json);
@@ -93,4 +119,5 @@ private:
     void loadTestVideo();
     void initializeCamera();
     bool trySetupCamera();
+    void stampNewFrame(uint64_t captureMicros);
 };
\ No newline at end of file
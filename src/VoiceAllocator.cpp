@@ -0,0 +1,104 @@
+#include "VoiceAllocator.h"
+#include <algorithm>
+
+VoiceAllocator::VoiceAllocator() {
+    nextVoice = 1;
+    stealCount = 0;
+    configure(2, 16);
+}
+
+void VoiceAllocator::configure(int first, int last) {
+    first = std::min(std::max(first, 1), MAX_CHANNELS);
+    last = std::min(std::max(last, first), MAX_CHANNELS);
+    firstChannel = first;
+    channelCount = last - first + 1;
+    reset();
+}
+
+void VoiceAllocator::reset() {
+    freeList = {-1, -1};
+    busyList = {-1, -1};
+    for (int i = 0; i < channelCount; i++) {
+        slots[i].voice = 0;
+        slots[i].note = -1;
+        append(freeList, i);
+    }
+    activeCount = 0;
+}
+
+VoiceAllocator::Allocation VoiceAllocator::noteOn(int note) {
+    Allocation allocation = {0, 0, false, -1};
+
+    int slot = freeList.head;
+    if (slot >= 0) {
+        unlink(freeList, slot);
+        activeCount++;
+    } else {
+        // Every channel is sounding - take over the oldest note
+        slot = busyList.head;
+        unlink(busyList, slot);
+        allocation.stolen = true;
+        allocation.stolenNote = slots[slot].note;
+        stealCount++;
+    }
+
+    slots[slot].voice = nextVoice++;
+    if (nextVoice == 0) nextVoice = 1;
+    slots[slot].note = note;
+    append(busyList, slot);
+
+    allocation.channel = firstChannel + slot;
+    allocation.voice = slots[slot].voice;
+    return allocation;
+}
+
+bool VoiceAllocator::noteOff(int channel, uint32_t voice) {
+    int slot = slotForChannel(channel);
+    if (slot < 0 || voice == 0 || slots[slot].voice != voice) {
+        return false;
+    }
+
+    unlink(busyList, slot);
+    slots[slot].voice = 0;
+    slots[slot].note = -1;
+    append(freeList, slot);
+    activeCount--;
+    return true;
+}
+
+bool VoiceAllocator::isActive(int channel, uint32_t voice) const {
+    int slot = slotForChannel(channel);
+    return slot >= 0 && voice != 0 && slots[slot].voice == voice;
+}
+
+int VoiceAllocator::slotForChannel(int channel) const {
+    int slot = channel - firstChannel;
+    return (slot >= 0 && slot < channelCount) ? slot : -1;
+}
+
+void VoiceAllocator::append(List& list, int slot) {
+    slots[slot].prev = list.tail;
+    slots[slot].next = -1;
+    if (list.tail >= 0) {
+        slots[list.tail].next = slot;
+    } else {
+        list.head = slot;
+    }
+    list.tail = slot;
+}
+
+void VoiceAllocator::unlink(List& list, int slot) {
+    Slot& s = slots[slot];
+    if (s.prev >= 0) {
+        slots[s.prev].next = s.next;
+    } else {
+        list.head = s.next;
+    }
+    if (s.next >= 0) {
+        slots[s.next].prev = s.prev;
+    } else {
+        list.tail = s.prev;
+    }
+    s.prev = -1;
+    s.next = -1;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+// Per-note channel allocation for MPE-style output (lower zone: master channel 1,
+// member channels from firstChannel to lastChannel). Each sounding note gets a member
+// channel to itself, so its pitch bend cannot detune any other note.
+//
+// Channels sit on two intrusive lists - free (least recently released first, so release
+// tails get time to ring out) and busy (oldest note first). noteOn, noteOff and stealing
+// are all O(1). When every channel is busy the oldest voice is stolen; the caller must
+// send its note-off. Voice ids tell a stolen voice apart from the one that replaced it,
+// so a late note-off for a stolen note is ignored rather than cutting the new note.
+//
+// Not thread-safe; the caller serialises access.
+// Independent of openFrameworks so it can be stress-tested standalone (bench/).
+class VoiceAllocator {
+public:
+    static constexpr int MAX_CHANNELS = 16;
+
+    struct Allocation {
+        int channel;           // 1-based MIDI channel
+        uint32_t voice;        // Never 0
+        bool stolen;           // A sounding voice was taken over
+        int stolenNote;        // Its note, valid when stolen
+    };
+
+    VoiceAllocator();
+
+    // 1-based channels, clamped to 1-16. Releases every voice.
+    void configure(int firstChannel, int lastChannel);
+    void reset();
+
+    Allocation noteOn(int note);
+    // False when the voice is no longer on the channel (stolen or already released)
+    bool noteOff(int channel, uint32_t voice);
+    bool isActive(int channel, uint32_t voice) const;
+
+    int getFirstChannel() const { return firstChannel; }
+    int getLastChannel() const { return firstChannel + channelCount - 1; }
+    int getChannelCount() const { return channelCount; }
+    int getActiveCount() const { return activeCount; }
+    uint64_t getStealCount() const { return stealCount; }
+
+private:
+    struct Slot {
+        uint32_t voice;        // 0 when free
+        int note;
+        int prev;
+        int next;
+    };
+
+    struct List {
+        int head;
+        int tail;
+    };
+
+    void append(List& list, int slot);
+    void unlink(List& list, int slot);
+    int slotForChannel(int channel) const;
+
+    Slot slots[MAX_CHANNELS];
+    List freeList;
+    List busyList;
+    int firstChannel;
+    int channelCount;
+    int activeCount;
+    uint32_t nextVoice;
+    uint64_t stealCount;
+};
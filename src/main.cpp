@@ -1,8 +1,49 @@
 #include "ofMain.h"
+#include "ofAppNoWindow.h"
 #include "ofApp.h"
 
 //========================================================================
-int main( ){
+// Options:
+//   --headless            No window, GL context or GUI - for display-less machines
+//                         running as a service. Configure via config.json and OSC.
+//   --control-port N      UDP port for OSC control messages (default 9001 when headless,
+//                         otherwise off; 0 = off)
+//   --control-from ADDR   Only accept OSC control sent from ADDR (default 127.0.0.1, any = all)
+//   --metrics-port N      Serve Prometheus metrics on http://<bind>:N/metrics (default off)
+//   --metrics-bind ADDR   Address the metrics endpoint listens on (default 127.0.0.1)
+int main(int argc, char* argv[]){
+	bool headless = false;
+	int controlPort = -1;           // Not given: on when headless, off with the GUI
+	string controlFrom = "127.0.0.1";
+	int metricsPort = 0;
+	string metricsBind = "127.0.0.1";
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		if (arg == "--headless") {
+			headless = true;
+		} else if (arg == "--control-port" && i + 1 < argc) {
+			controlPort = ofToInt(argv[++i]);
+		} else if (arg == "--control-from" && i + 1 < argc) {
+			controlFrom = argv[++i];
+		} else if (arg == "--metrics-port" && i + 1 < argc) {
+			metricsPort = ofToInt(argv[++i]);
+		} else if (arg == "--metrics-bind" && i + 1 < argc) {
+			metricsBind = argv[++i];
+		}
+	}
+	if (controlPort < 0) {
+		controlPort = headless ? 9001 : 0;
+	}
+
+	if (headless) {
+		// Same app, no renderer: update() is paced by frame arrival, draw() does nothing
+		auto window = std::make_shared<ofAppNoWindow>();
+		ofSetupOpenGL(window, 1050, 640, OF_WINDOW);
+		ofRunApp(window, std::make_shared<ofApp>(true, controlPort, controlFrom, metricsPort, metricsBind));
+		ofRunMainLoop();
+		return 0;
+	}
+
 	ofGLWindowSettings settings;
 	settings.setSize(1050, 640);   // Fixed size: 640x640 video + 410px tabbed GUI
 	// Video area: 640x640 (left), Tabbed GUI: 410px (right) with Main Controls + MIDI Settings tabs
@@ -10,8 +51,8 @@ int main( ){
 	// Window resizing will be handled in the app itself
 
 	auto window = ofCreateWindow(settings);
-	
+
 	// Handle window resizing in the app's setup and windowResized functions
-	ofRunApp(window, std::make_shared<ofApp>());
+	ofRunApp(window, std::make_shared<ofApp>(false, controlPort, controlFrom, metricsPort, metricsBind));
 	ofRunMainLoop();
 }
@@ -1,22 +1,72 @@
 #include "ofApp.h"
+#include <csignal>
+
+namespace {
+    // Headless: how long update() waits for a frame before running the rest of the
+    // frame anyway, so tempo, MIDI clock and OSC keep ticking without video
+    const uint64_t HEADLESS_FRAME_WAIT_MICROS = 5000;
+    const float HEADLESS_STATUS_SECONDS = 30.0f;
+    
+    volatile std::sig_atomic_t quitSignal = 0;
+    void handleQuitSignal(int) {
+        quitSignal = 1;
+    }
+}
+
+//--------------------------------------------------------------
+ofApp::ofApp(bool headless, int controlPort, const string& controlFrom, int metricsPort, const string& metricsBindAddress)
+    : headless(headless), controlPort(controlPort), controlFrom(controlFrom), metricsPort(metricsPort),
+      metricsBindAddress(metricsBindAddress) {
+    lastStatusTime = 0.0f;
+    statusFrames = 0;
+    publishedMidiEvents = 0;
+    frameWorkMicros = 0;
+}
 
 //--------------------------------------------------------------
 void ofApp::setup(){
     // EXACT same setup logic as working backup, just organized into managers
-    ofSetFrameRate(60);  // Let app run at 60fps for responsiveness
-    ofSetBackgroundColor(0, 0, 0);  // Black background instead of green
+    if (headless) {
+        // No render clock - update() is paced by frame arrival instead
+        ofSetFrameRate(0);
+        // Service managers stop with SIGTERM; exit() still saves the config
+        std::signal(SIGINT, handleQuitSignal);
+        std::signal(SIGTERM, handleQuitSignal);
+        ofLogNotice() << "ofApp: Headless mode - rendering and GUI disabled";
+    } else {
+        ofSetFrameRate(60);  // Let app run at 60fps for responsiveness
+        ofSetBackgroundColor(0, 0, 0);  // Black background instead of green
+    }
     
     // Initialize window resize tracking - EXACT COPY from working backup
     originalWindowWidth = 0;
     originalWindowHeight = 0;
     
+    setupStartMicros = ofGetElapsedTimeMicros();
+    coldStartReported = false;
+    
+    // Managers that time their own stages get the profiler before their threads start
+    profiler.setThreadName("App");
+    detectionManager.setProfiler(&profiler);
+    detectionManager.setMetrics(&metrics);
+    communicationManager.setProfiler(&profiler);
+    
+    // Config first: it reads the camera mode that worked last run
+    configManager.setup();
+    CameraHint cameraHint;
+    if (configManager.getCameraHint(cameraHint)) {
+        videoManager.setPreferredCameraMode(cameraHint.deviceId, cameraHint.width, cameraHint.height);
+    }
+    
     // Initialize managers with EXACT same logic from working backup
+    videoManager.setHeadless(headless);
     videoManager.setup();
     lineManager.setup();
     detectionManager.setup();
-    uiManager.setup();
+    if (!headless) {
+        uiManager.setup();  // ImGui needs a GL context
+    }
     communicationManager.setup();
-    configManager.setup();
     
     // Connect managers together - CRITICAL for modular system
     detectionManager.setVideoManagers(&videoManager);
@@ -31,39 +81,134 @@ void ofApp::setup(){
     
     // Setup scale manager
     scaleManager.setup();
+    scaleManager.setLineManager(&lineManager);
     
     // Connect TempoManager to LineManager
     lineManager.setTempoManager(&tempoManager);
     
     uiManager.setManagers(&videoManager, &lineManager, &detectionManager, 
                          &communicationManager, &configManager, &scaleManager);
+    uiManager.setProfiler(&profiler);
     
     communicationManager.setManagers(&lineManager);
     communicationManager.setScaleManager(&scaleManager);
+    communicationManager.setTempoManager(&tempoManager);
+    tempoManager.setCommunicationManager(&communicationManager);
+    uiManager.setTempoManager(&tempoManager);
     
     configManager.setManagers(&uiManager, &lineManager, &videoManager, 
                              &detectionManager, &communicationManager, &tempoManager, &scaleManager);
     
     // Load configuration - EXACT same as working backup
     configManager.loadConfig();
+    
+    if (controlPort > 0) {
+        controlReceiver.setup(controlPort);
+        ofLogNotice() << "ofApp: OSC control on port " << controlPort << " from " << controlFrom;
+    }
+    
+    if (metricsPort > 0) {
+        metrics.addHistogram("sonify_frame_duration", "App frame time, update start to update start.",
+                             &profiler.getHistogram(FrameProfiler::STAGE_FRAME));
+        metrics.addHistogram("sonify_inference_duration", "Detector time per run.",
+                             &detectionManager.inferenceLatency);
+        metrics.addHistogram("sonify_capture_to_infer", "Frame capture to detector start.",
+                             &detectionManager.captureToInferLatency);
+        metrics.addHistogram("sonify_tracking_duration", "Tracking and crossing tests per detector run.",
+                             &detectionManager.trackingLatency);
+        metrics.addHistogram("sonify_capture_to_emit", "Frame capture to crossing sent.",
+                             &detectionManager.captureToEmitLatency);
+        metrics.start(metricsPort, metricsBindAddress);
+    }
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
-    // EXACT same update logic as working backup, just organized into managers
-    videoManager.update();
+    uint64_t updateStartMicros = ofGetElapsedTimeMicros();
+    uint64_t waitMicros = 0;
+    profiler.beginFrame();
+    FrameProfiler::Scope updateScope(&profiler, FrameProfiler::STAGE_UPDATE);
+    
+    // Judge the previous frame against the budget before this one does any work
+    detectionManager.updateBudgetWatchdog(frameWorkMicros / 1000.0f);
+    frameWorkMicros = 0;
+    
+    // Frame boundary - swap in config.json edits before anything reads settings
+    {
+        FrameProfiler::Scope configScope(&profiler, FrameProfiler::STAGE_CONFIG);
+        configManager.applyReload();
+    }
+    
+    if (headless) {
+        if (quitSignal) {
+            ofExit();
+            return;
+        }
+        uint64_t waitStartMicros = ofGetElapsedTimeMicros();
+        videoManager.waitForFrame(HEADLESS_FRAME_WAIT_MICROS);
+        waitMicros = ofGetElapsedTimeMicros() - waitStartMicros;
+    } else {
+        // EXACT same update logic as working backup, just organized into managers
+        FrameProfiler::Scope videoScope(&profiler, FrameProfiler::STAGE_VIDEO);
+        videoManager.update();
+    }
+    handleControlMessages();
     
     // Process detection only if video has new frame - EXACT same logic
     if (detectionManager.shouldProcess()) {
+        FrameProfiler::Scope detectionScope(&profiler, FrameProfiler::STAGE_DETECTION);
         detectionManager.update();
     }
     
-    lineManager.update();
-    communicationManager.update();
+    {
+        FrameProfiler::Scope linesScope(&profiler, FrameProfiler::STAGE_LINES);
+        lineManager.update();
+    }
+    {
+        FrameProfiler::Scope communicationScope(&profiler, FrameProfiler::STAGE_COMMUNICATION);
+        communicationManager.update();
+    }
+    {
+        FrameProfiler::Scope configScope(&profiler, FrameProfiler::STAGE_CONFIG);
+        configManager.update();
+    }
+    
+    publishMetrics();
+    
+    if (headless) {
+        // Nothing on screen - a periodic status line is the only sign of life
+        if (videoManager.isFrameNew()) {
+            statusFrames++;
+        }
+        float now = ofGetElapsedTimef();
+        if (now - lastStatusTime >= HEADLESS_STATUS_SECONDS) {
+            ofLogNotice() << "ofApp: " << statusFrames / (now - lastStatusTime) << " frames/s, "
+                          << detectionManager.getTrackedVehiclesCount() << " tracked, inference "
+                          << detectionManager.getAverageInferenceMs() << " ms, degradation level "
+                          << detectionManager.budgetWatchdog.getLevel();
+            lastStatusTime = now;
+            statusFrames = 0;
+        }
+    }
+    
+    if (!coldStartReported && detectionManager.inferenceLatency.getCount() > 0) {
+        coldStartReported = true;
+        ofLogNotice() << "ofApp: Cold start to first detection "
+                      << (ofGetElapsedTimeMicros() - setupStartMicros) / 1000.0f << " ms (config "
+                      << configManager.getLoadMs() << " ms)";
+    }
+    
+    frameWorkMicros += ofGetElapsedTimeMicros() - updateStartMicros - waitMicros;
 }
 
 //--------------------------------------------------------------
 void ofApp::draw(){
+    if (headless) {
+        return;
+    }
+    uint64_t drawStartMicros = ofGetElapsedTimeMicros();
+    FrameProfiler::Scope drawScope(&profiler, FrameProfiler::STAGE_DRAW);
+    
     // EXACT same draw logic as working backup, just organized into managers
     
     // Clear background - EXACT same
@@ -72,22 +217,132 @@ void ofApp::draw(){
     ofDrawRectangle(0, 0, 640, 640);
     
     // Draw video - EXACT same
-    videoManager.draw();
+    {
+        FrameProfiler::Scope videoScope(&profiler, FrameProfiler::STAGE_DRAW_VIDEO);
+        videoManager.draw();
+    }
     
     // Draw lines - EXACT same
-    lineManager.draw();
+    {
+        FrameProfiler::Scope linesScope(&profiler, FrameProfiler::STAGE_DRAW_LINES);
+        lineManager.draw();
+    }
     
     // Draw detections - EXACT same
-    detectionManager.draw();
+    {
+        FrameProfiler::Scope detectionScope(&profiler, FrameProfiler::STAGE_DRAW_DETECTIONS);
+        detectionManager.draw();
+    }
     
     // Draw GUI - EXACT same
-    uiManager.draw();
+    {
+        FrameProfiler::Scope guiScope(&profiler, FrameProfiler::STAGE_GUI);
+        uiManager.draw();
+    }
+    
+    frameWorkMicros += ofGetElapsedTimeMicros() - drawStartMicros;
+}
+
+//--------------------------------------------------------------
+// Relaxed stores only - the metrics thread reads these without locking
+void ofApp::publishMetrics() {
+    if (!metrics.isRunning()) {
+        return;
+    }
+    
+    metrics.framesTotal.fetch_add(1, std::memory_order_relaxed);
+    float targetRate = ofGetTargetFrameRate();
+    if (targetRate > 0 && ofGetLastFrameTime() > 1.5f / targetRate) {
+        metrics.lateFramesTotal.fetch_add(1, std::memory_order_relaxed);
+    }
+    metrics.fps.store(ofGetFrameRate(), std::memory_order_relaxed);
+    metrics.videoFramesTotal.store(videoManager.getFrameNumber(), std::memory_order_relaxed);
+    metrics.droppedVideoFramesTotal.store(videoManager.getDroppedFrames(), std::memory_order_relaxed);
+    metrics.trackedObjects.store(detectionManager.getTrackedVehiclesCount(), std::memory_order_relaxed);
+    metrics.degradationLevel.store(detectionManager.budgetWatchdog.getLevel(), std::memory_order_relaxed);
+    
+    // totalMidiEvents resets with the MIDI settings; the exported counter keeps counting
+    int midiEvents = communicationManager.totalMidiEvents;
+    metrics.midiEventsTotal.fetch_add(midiEvents >= publishedMidiEvents ? midiEvents - publishedMidiEvents : midiEvents,
+                                      std::memory_order_relaxed);
+    publishedMidiEvents = midiEvents;
+    metrics.midiSchedulerQueueDepth.store(communicationManager.noteScheduler.getPendingCount(), std::memory_order_relaxed);
+    metrics.activeMidiNotes.store((int)communicationManager.activeMidiNotes.size(), std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+// Addresses under /control/ change settings; changed sections are saved like GUI edits
+void ofApp::handleControlMessages() {
+    if (controlPort <= 0) {
+        return;
+    }
+    
+    while (controlReceiver.hasWaitingMessages()) {
+        ofxOscMessage message;
+        controlReceiver.getNextMessage(message);
+        if (controlFrom != "any" && message.getRemoteHost() != controlFrom) {
+            if (rejectedControlHosts.insert(message.getRemoteHost()).second) {
+                ofLogWarning() << "ofApp: Ignoring OSC control from " << message.getRemoteHost()
+                               << " (only " << controlFrom << " is accepted, see --control-from)";
+            }
+            continue;
+        }
+        const string& address = message.getAddress();
+        int argCount = message.getNumArgs();
+        
+        if (address == "/control/detection/enabled" && argCount > 0) {
+            detectionManager.enableDetection = message.getArgAsInt(0) != 0;
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION));
+        } else if (address == "/control/detection/confidence" && argCount > 0) {
+            detectionManager.setConfidenceThreshold(ofClamp(message.getArgAsFloat(0), 0.0f, 1.0f));
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION));
+        } else if (address == "/control/detection/preset" && argCount > 0) {
+            detectionManager.applyPreset(message.getArgAsString(0));
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION));
+        } else if (address == "/control/detection/classes") {
+            // Replaces the selection: one int class ID per argument
+            detectionManager.selectedClassIds.clear();
+            for (int i = 0; i < argCount; i++) {
+                detectionManager.addSelectedClass(message.getArgAsInt(i));
+            }
+            detectionManager.setCurrentPreset("Custom");
+            detectionManager.updateEnabledClassesFromSelection();
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_DETECTION));
+        } else if (address == "/control/tempo/bpm" && argCount > 0) {
+            tempoManager.setBPM(message.getArgAsFloat(0));
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_TEMPO));
+        } else if (address == "/control/scale" && argCount > 0) {
+            if (!scaleManager.setCurrentScale(message.getArgAsString(0))) {
+                ofLogWarning() << "ofApp: Unknown scale " << message.getArgAsString(0);
+            }
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_SCALES));
+        } else if (address == "/control/root" && argCount > 0) {
+            lineManager.setMasterRootNote(ofClamp(message.getArgAsInt(0), 0, 11));
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_LINES));
+        } else if (address == "/control/midi/enabled" && argCount > 0) {
+            communicationManager.midiEnabled = message.getArgAsInt(0) != 0;
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_COMMUNICATION));
+        } else if (address == "/control/osc/enabled" && argCount > 0) {
+            communicationManager.oscEnabled = message.getArgAsInt(0) != 0;
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_COMMUNICATION));
+        } else if (address == "/control/lines/clear") {
+            lineManager.clearAllLines();
+            configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_LINES));
+        } else if (address == "/control/config/save") {
+            configManager.saveConfig();
+        } else if (address == "/control/quit") {
+            ofExit();
+        } else {
+            ofLogWarning() << "ofApp: Unknown control message " << address;
+        }
+    }
 }
 
 //--------------------------------------------------------------
 void ofApp::exit(){
-    // EXACT same exit logic
-    configManager.saveConfig();
+    metrics.stop();
+    // EXACT same exit logic - waits for the config write to finish
+    configManager.saveOnExit();
 }
 
 //--------------------------------------------------------------
@@ -129,6 +384,7 @@ void ofApp::keyPressed(int key){
     // Line controls - EXACT same
     if (key == 'c' || key == 'C') {
         lineManager.clearAllLines();
+        configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_LINES));
         return;
     }
     
@@ -147,6 +403,7 @@ void ofApp::keyPressed(int key){
     // Line editing - EXACT same
     if (key == OF_KEY_DEL || key == OF_KEY_BACKSPACE) {
         lineManager.deleteSelectedLine();
+        configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_LINES));
         return;
     }
     
@@ -182,6 +439,8 @@ void ofApp::mousePressed(int x, int y, int button){
 //--------------------------------------------------------------
 void ofApp::mouseReleased(int x, int y, int button){
     lineManager.handleMouseReleased(x, y, button);
+    // Drawing or dragging a line ends here; an unchanged section is not rewritten
+    configManager.markDirty(ConfigManager::sectionBit(ConfigManager::SECTION_LINES));
 }
 
 //--------------------------------------------------------------
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ofMain.h"
+#include "ofxOsc.h"
 
 // Include all managers - EXACT same functionality, just modularized
 #include "VideoManager.h"
@@ -11,9 +12,17 @@
 #include "ConfigManager.h"
 #include "TempoManager.h"
 #include "ScaleManager.h"
+#include "FrameProfiler.h"
+#include "MetricsServer.h"
 
 class ofApp : public ofBaseApp{
 public:
+    // headless: no window or GUI (see main.cpp); controlPort 0 disables OSC control and
+    // controlFrom is the only sender it accepts ("any" for all), metricsPort 0 disables
+    // the /metrics endpoint
+    ofApp(bool headless = false, int controlPort = 0, const string& controlFrom = "127.0.0.1",
+          int metricsPort = 0, const string& metricsBindAddress = "127.0.0.1");
+    
     // EXACT same interface as working backup
     void setup() override;
     void update() override;
@@ -45,7 +54,34 @@ private:
     TempoManager tempoManager;
     ScaleManager scaleManager;
     
+    // Stage timings for the Performance tab and trace export
+    FrameProfiler profiler;
+    uint64_t frameWorkMicros;       // Update + draw, without vsync or frame waits - for the budget watchdog
+    
     // Window resize management - EXACT COPY from working backup
     int originalWindowWidth;
     int originalWindowHeight;
+    
+    // Startup timing
+    uint64_t setupStartMicros;
+    bool coldStartReported;
+    
+    // Headless service mode
+    bool headless;
+    float lastStatusTime;
+    uint64_t statusFrames;          // Frames processed since the last status line
+    
+    // OSC control input - the only way to change settings besides config.json when headless
+    void handleControlMessages();
+    int controlPort;
+    ofxOscReceiver controlReceiver;
+    string controlFrom;             // ofxOsc listens on every interface, so senders are checked instead
+    set<string> rejectedControlHosts;   // Logged once each
+    
+    // Prometheus scrape endpoint; gauges are published once per frame
+    void publishMetrics();
+    MetricsServer metrics;
+    int metricsPort;
+    string metricsBindAddress;
+    int publishedMidiEvents;        // totalMidiEvents at the last publish
 };
\ No newline at end of file